@@ -63,6 +63,11 @@ art::ProcessingOptionsHandler::ProcessingOptionsHandler(
        bpo::value<int>(),
        "Number of threads to use for event processing (default = 1, 0 = all "
        "cores)")
+    ("fork",
+       bpo::value<int>(),
+       "Number of worker processes to fork once the job has been "
+       "initialized (default = 1, i.e. no fork).  Each worker writes its "
+       "own output files; use %w in output file names.")
     ("default-exceptions",
        "Some exceptions may be handled differently by default (e.g. "
        "ProductNotFound).")
@@ -110,6 +115,10 @@ art::ProcessingOptionsHandler::doCheckOptions(bpo::variables_map const& vm)
     throw Exception(errors::Configuration)
       << "Option --nschedules must be at least 1.\n";
   }
+  if (vm.count("fork") and vm["fork"].as<int>() < 1) {
+    throw Exception(errors::Configuration)
+      << "Option --fork must be at least 1.\n";
+  }
   return 0;
 }
 
@@ -141,6 +150,11 @@ art::ProcessingOptionsHandler::doProcessOptions(
             raw_config,
             true);
 
+  if (vm.count("fork")) {
+    raw_config.put(fhicl_key(scheduler_key, "num_workers"),
+                   vm["fork"].as<int>());
+  }
+
   auto const num_schedules_key = fhicl_key(scheduler_key, "num_schedules");
   auto const num_threads_key = fhicl_key(scheduler_key, "num_threads");
   if (vm.count("parallelism")) {
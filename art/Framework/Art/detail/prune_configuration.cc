@@ -8,10 +8,12 @@
 #include "fhiclcpp/extended_value.h"
 #include "range/v3/view.hpp"
 
+#include <algorithm>
+#include <cctype>
 #include <initializer_list>
 #include <iostream>
-#include <regex>
 #include <set>
+#include <string_view>
 
 using namespace fhicl;
 using namespace std::string_literals;
@@ -26,11 +28,22 @@ namespace {
   std::string const at_nil{"@nil"};
   std::string const trigger_paths_str{"trigger_paths"};
   std::string const end_paths_str{"end_paths"};
-  bool
-  matches(std::string const& path_spec_str, std::string const& path_name)
+  // The path name of a path specification of the form 'name' or
+  // '<digits>:name'.
+  std::string_view
+  path_name_of(std::string_view const path_spec_str)
   {
-    std::regex const path_spec_re{R"((\d+:)?)" + path_name};
-    return std::regex_match(path_spec_str, path_spec_re);
+    auto const colon = path_spec_str.find(':');
+    if (colon == 0 || colon == std::string_view::npos) {
+      return path_spec_str;
+    }
+    auto const id = path_spec_str.substr(0, colon);
+    if (!std::all_of(cbegin(id), cend(id), [](unsigned char const c) {
+          return std::isdigit(c);
+        })) {
+      return path_spec_str;
+    }
+    return path_spec_str.substr(colon + 1);
   }
 
   auto module_tables = {"physics.producers",
@@ -344,22 +357,20 @@ namespace {
     if (not exists_outside_prolog(config, path_selection_override)) {
       return;
     }
-    sequence_t result = config.find(path_selection_override);
-    for (auto const& name : empty_paths) {
-      std::replace_if(
-        begin(result),
-        end(result),
-        [&name](auto const& ex_val) {
-          if (not ex_val.is_a(STRING)) {
-            return false;
-          }
-          std::string path_spec_str;
-          fhicl::detail::decode(ex_val.value, path_spec_str);
-          return matches(path_spec_str, name);
-        },
-        fhicl::extended_value{false, NIL, at_nil});
-    }
-    config.get<sequence_t&>(path_selection_override) = result;
+    if (empty_paths.empty()) {
+      return;
+    }
+    auto& result = config.get<sequence_t&>(path_selection_override);
+    for (auto& ex_val : result) {
+      if (not ex_val.is_a(STRING)) {
+        continue;
+      }
+      std::string path_spec_str;
+      fhicl::detail::decode(ex_val.value, path_spec_str);
+      if (empty_paths.count(std::string{path_name_of(path_spec_str)})) {
+        ex_val = fhicl::extended_value{false, NIL, at_nil};
+      }
+    }
   }
 
   module_entries_for_path_t
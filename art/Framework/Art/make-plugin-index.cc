@@ -0,0 +1,57 @@
+#include "art/Framework/Art/detail/PluginSymbolResolvers.h"
+#include "art/Utilities/PluginIndex.h"
+#include "art/Utilities/PluginSuffixes.h"
+#include "cetlib/LibraryManager.h"
+#include "cetlib_except/exception.h"
+
+#include <fstream>
+#include <iostream>
+#include <map>
+#include <string>
+#include <vector>
+
+// Write the plugin index for the libraries on the current plugin
+// path.  Usage:
+//
+//   make-plugin-index <index-file> [<suffix>...]
+//
+// By default, modules, sources, services, tools and plugins are
+// indexed.  The type of each module, tool and plugin is recorded, which
+// requires loading its library.
+
+int
+main(int argc, char** argv)
+{
+  if (argc < 2) {
+    std::cerr << "Usage: " << argv[0] << " <index-file> [<suffix>...]\n";
+    return 1;
+  }
+  std::vector<std::string> suffixes(argv + 2, argv + argc);
+  if (suffixes.empty()) {
+    suffixes = {art::Suffixes::module(),
+                art::Suffixes::source(),
+                art::Suffixes::service(),
+                art::Suffixes::tool(),
+                art::Suffixes::plugin()};
+  }
+  std::ofstream os{argv[1]};
+  if (!os) {
+    std::cerr << "Cannot open " << argv[1] << " for writing.\n";
+    return 1;
+  }
+  std::map<std::string, cet::LibraryManager> managers;
+  auto type_of = [&managers](std::string const& suffix,
+                             std::string const& spec) {
+    auto const& lm = managers.try_emplace(suffix, suffix).first->second;
+    auto type = art::detail::getType(lm, spec);
+    return type == "[ error ]" ? std::string{} : type;
+  };
+  try {
+    art::PluginIndex::make(suffixes, type_of).write(os);
+  }
+  catch (cet::exception const& e) {
+    std::cerr << e.what() << '\n';
+    return 1;
+  }
+  return os ? 0 : 1;
+}
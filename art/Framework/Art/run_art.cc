@@ -10,6 +10,7 @@
 #include "art/Framework/Art/detail/prune_configuration.h"
 #include "art/Framework/Core/detail/EnabledModules.h"
 #include "art/Framework/EventProcessor/EventProcessor.h"
+#include "art/Utilities/AllocatorStrategy.h"
 #include "art/Utilities/ExceptionMessages.h"
 #include "art/Utilities/UnixSignalHandlers.h"
 #include "boost/program_options.hpp"
@@ -30,10 +31,6 @@
 #include <iostream>
 #include <string>
 
-#ifdef __linux__
-#include <malloc.h>
-#endif // __linux__
-
 using namespace std;
 using namespace string_literals;
 
@@ -249,20 +246,24 @@ namespace art {
       throw;
     }
 
-#ifdef __linux__
-    // Tell the system memory allocator to only use one arena: they
-    // are 64 MiB in size, and the default is 8 * num_of_cores.  Using
-    // the default means that when using 40 threads we get 40 arenas,
-    // which means we have 40 * 64 MiB = 2560 MiB of virtual address
-    // space devoted to per-thread heaps!!!
-    mallopt(M_ARENA_MAX, 1);
-#endif // __linux__
-
     auto const services_pset =
       main_pset.get<fhicl::ParameterSet>("services", {});
     auto const scheduler_pset =
       services_pset.get<fhicl::ParameterSet>("scheduler", {});
 
+    // The allocator must be configured before any threads are
+    // started.  By default, the system memory allocator uses only one
+    // arena (see AllocatorStrategy.h).
+    try {
+      configure_allocator(
+        scheduler_pset.get<std::string>("allocator", "glibc1"),
+        scheduler_pset.get<unsigned>("arena_max", 0));
+    }
+    catch (cet::exception const& e) {
+      printArtException(e, "art");
+      return 92;
+    }
+
     // Handle early configuration-debugging
     auto const debug_mode = debug_processing_mode(scheduler_pset);
     if (debug_mode != debug_processing::none) {
@@ -329,6 +330,10 @@ namespace art {
       if (scheduler_pset.has_key("dataDependencyGraph")) {
         return detail::info_success();
       }
+      // With worker processes, this process only waits for them.
+      if (auto const workers_rc = ep.forkWorkers()) {
+        return *workers_rc;
+      }
       auto ep_rc = ep.runToCompletion();
       if (ep_rc == EventProcessor::epSignal) {
         cerr << "Art has handled signal " << art::shutdown_flag << ".\n";
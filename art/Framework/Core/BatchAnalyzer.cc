@@ -0,0 +1,71 @@
+#include "art/Framework/Core/BatchAnalyzer.h"
+// vim: set sw=2 expandtab :
+
+#include "art/Framework/Principal/Event.h"
+#include "art/Framework/Principal/EventPrincipal.h"
+#include "art/Persistency/Provenance/ModuleContext.h"
+
+#include <deque>
+#include <memory>
+#include <utility>
+
+using namespace std;
+
+namespace {
+  // Events can be neither copied nor moved; this lets them be created
+  // in place in a container.
+  struct EventHolder {
+    EventHolder(art::EventPrincipal const& ep, art::ModuleContext const& mc)
+      : event{ep.makeEvent(mc)}
+    {}
+    art::Event const event;
+  };
+}
+
+namespace art {
+
+  BatchAnalyzer::BatchAnalyzer(fhicl::ParameterSet const& pset)
+    : SharedAnalyzer{pset}
+  {}
+
+  unique_ptr<Worker>
+  BatchAnalyzer::doMakeWorker(WorkerParams const& wp)
+  {
+    return make_unique<WorkerT<BatchAnalyzer>>(this, wp);
+  }
+
+  vector<bool>
+  BatchAnalyzer::doEventBatch(vector<detail::EventInBatch> const& batch)
+  {
+    deque<EventHolder> holders;
+    vector<Event const*> events;
+    vector<detail::EventInBatch const*> selected;
+    events.reserve(batch.size());
+    for (auto const& item : batch) {
+      auto const& holder =
+        holders.emplace_back(as_const(item.principal), item.context);
+      if (wantEvent(item.context.scheduleID(), holder.event)) {
+        events.push_back(&holder.event);
+        selected.push_back(&item);
+        ++item.counts_run;
+      }
+    }
+    if (!events.empty()) {
+      ProcessingFrame const frame{ScheduleID{}};
+      analyzeEvents(events, frame);
+    }
+    for (auto const item : selected) {
+      ++item->counts_passed;
+    }
+    // Analyzers never reject events.
+    return vector<bool>(batch.size(), true);
+  }
+
+  void
+  BatchAnalyzer::analyze(Event const& e, ProcessingFrame const& frame)
+  {
+    Event const* const events[]{&e};
+    analyzeEvents(events, frame);
+  }
+
+} // namespace art
@@ -0,0 +1,56 @@
+#ifndef art_Framework_Core_BatchAnalyzer_h
+#define art_Framework_Core_BatchAnalyzer_h
+// vim: set sw=2 expandtab :
+
+// ======================================================================
+// BatchAnalyzer: the base class for shared analyzers that process, in
+// a single call, the events of all schedules that have reached the
+// module on their paths.  Only the events selected by the analyzer's
+// 'SelectEvents' and 'RejectEvents' parameters are passed on.
+//
+// The events of a batch belong to different schedules, so the
+// processing frame passed to 'analyzeEvents' has no valid schedule.
+// Batches of a module are never processed concurrently; as for any
+// shared module, the constructor must call either
+// 'async<art::InEvent>()' or 'serialize(...)'.
+// ======================================================================
+
+#include "art/Framework/Core/SharedAnalyzer.h"
+#include "art/Framework/Core/detail/BatchModule.h"
+
+#include <span>
+#include <vector>
+
+namespace art {
+
+  class BatchAnalyzer : public SharedAnalyzer, public detail::BatchModule {
+  public:
+    // For all other purposes, a batch analyzer is a shared analyzer.
+    using ModuleType = SharedAnalyzer;
+
+    std::vector<bool> doEventBatch(
+      std::vector<detail::EventInBatch> const& events);
+
+  protected:
+    explicit BatchAnalyzer(fhicl::ParameterSet const& pset);
+
+    template <typename Config>
+    explicit BatchAnalyzer(Table<Config> const& config)
+      : BatchAnalyzer{config.get_PSet()}
+    {}
+
+  private:
+    std::unique_ptr<Worker> doMakeWorker(WorkerParams const& wp) final;
+    void analyze(Event const&, ProcessingFrame const&) final;
+
+    virtual void analyzeEvents(std::span<Event const* const> events,
+                               ProcessingFrame const&) = 0;
+  };
+
+} // namespace art
+
+#endif /* art_Framework_Core_BatchAnalyzer_h */
+
+// Local Variables:
+// mode: c++
+// End:
@@ -0,0 +1,71 @@
+#include "art/Framework/Core/BatchFilter.h"
+// vim: set sw=2 expandtab :
+
+#include "art/Framework/Principal/Event.h"
+#include "art/Framework/Principal/EventPrincipal.h"
+
+#include <algorithm>
+#include <deque>
+#include <memory>
+
+using namespace std;
+
+namespace {
+  // Events can be neither copied nor moved; this lets them be created
+  // in place in a container.
+  struct EventHolder {
+    EventHolder(art::EventPrincipal& ep, art::ModuleContext const& mc)
+      : event{ep.makeEvent(mc)}
+    {}
+    art::Event event;
+  };
+}
+
+namespace art {
+
+  BatchFilter::BatchFilter(fhicl::ParameterSet const& pset)
+    : SharedFilter{pset}
+  {}
+
+  unique_ptr<Worker>
+  BatchFilter::doMakeWorker(WorkerParams const& wp)
+  {
+    return make_unique<WorkerT<BatchFilter>>(this, wp);
+  }
+
+  vector<bool>
+  BatchFilter::doEventBatch(vector<detail::EventInBatch> const& batch)
+  {
+    auto const n = batch.size();
+    deque<EventHolder> holders;
+    vector<Event*> events;
+    events.reserve(n);
+    for (auto const& item : batch) {
+      auto& holder = holders.emplace_back(item.principal, item.context);
+      events.push_back(&holder.event);
+      ++item.counts_run;
+    }
+    auto results = make_unique<bool[]>(n);
+    fill_n(results.get(), n, Pass);
+    ProcessingFrame const frame{ScheduleID{}};
+    filterEvents(events, {results.get(), n}, frame);
+
+    vector<bool> result(n);
+    for (size_t i = 0; i != n; ++i) {
+      commitEventProducts(*events[i]);
+      result[i] = results[i];
+      ++(result[i] ? batch[i].counts_passed : batch[i].counts_failed);
+    }
+    return result;
+  }
+
+  bool
+  BatchFilter::filter(Event& e, ProcessingFrame const& frame)
+  {
+    Event* const events[]{&e};
+    bool result{Pass};
+    filterEvents(events, {&result, 1}, frame);
+    return result;
+  }
+
+} // namespace art
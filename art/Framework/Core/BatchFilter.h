@@ -0,0 +1,60 @@
+#ifndef art_Framework_Core_BatchFilter_h
+#define art_Framework_Core_BatchFilter_h
+// vim: set sw=2 expandtab :
+
+// ======================================================================
+// BatchFilter: the base class for shared filters that process, in a
+// single call, the events of all schedules that have reached the
+// module on their paths.  This amortizes the per-event cost of the
+// call and lets the filter work across events (e.g. with SIMD).
+//
+// The events of a batch belong to different schedules, so the
+// processing frame passed to 'filterEvents' has no valid schedule.
+// Batches of a module are never processed concurrently; as for any
+// shared module, the constructor must call either
+// 'async<art::InEvent>()' or 'serialize(...)', the latter to also
+// serialize the batches with respect to other modules.
+// ======================================================================
+
+#include "art/Framework/Core/SharedFilter.h"
+#include "art/Framework/Core/detail/BatchModule.h"
+
+#include <span>
+#include <vector>
+
+namespace art {
+
+  class BatchFilter : public SharedFilter, public detail::BatchModule {
+  public:
+    // For all other purposes, a batch filter is a shared filter.
+    using ModuleType = SharedFilter;
+
+    std::vector<bool> doEventBatch(
+      std::vector<detail::EventInBatch> const& events);
+
+  protected:
+    explicit BatchFilter(fhicl::ParameterSet const& pset);
+
+    template <typename Config>
+    explicit BatchFilter(Table<Config> const& config)
+      : BatchFilter{config.get_PSet()}
+    {}
+
+  private:
+    std::unique_ptr<Worker> doMakeWorker(WorkerParams const& wp) final;
+    bool filter(Event&, ProcessingFrame const&) final;
+
+    // Set 'results[i]' to whether 'events[i]' passes; each result is
+    // initially 'Pass'.
+    virtual void filterEvents(std::span<Event* const> events,
+                              std::span<bool> results,
+                              ProcessingFrame const&) = 0;
+  };
+
+} // namespace art
+
+#endif /* art_Framework_Core_BatchFilter_h */
+
+// Local Variables:
+// mode: c++
+// End:
@@ -21,7 +21,7 @@ namespace art {
   public:
     using ModuleType = EDAnalyzer;
 
-    using detail::LegacyModule::serialTaskQueueChain;
+    using detail::LegacyModule::resourceQueue;
     using detail::LegacyModule::sharedResources;
 
   protected:
@@ -17,7 +17,7 @@ namespace art {
   public:
     using ModuleType = EDFilter;
 
-    using detail::LegacyModule::serialTaskQueueChain;
+    using detail::LegacyModule::resourceQueue;
     using detail::LegacyModule::sharedResources;
 
   protected:
@@ -16,7 +16,7 @@ namespace art {
   public:
     using ModuleType = EDProducer;
 
-    using detail::LegacyModule::serialTaskQueueChain;
+    using detail::LegacyModule::resourceQueue;
     using detail::LegacyModule::sharedResources;
 
   protected:
@@ -30,6 +30,11 @@ namespace art {
     using detail::LegacyModule::createEngine;
     using detail::LegacyModule::scheduleID;
 
+    // External work is supported only for shared and replicated
+    // producers.
+    template <BranchType BT = InEvent>
+    void externalWork() = delete;
+
   private:
     std::unique_ptr<Worker> doMakeWorker(WorkerParams const& wp) final;
     void setupQueues(detail::SharedResources const& resources) final;
@@ -20,6 +20,8 @@
 #include "hep_concurrency/WaitingTask.h"
 #include "messagefacility/MessageLogger/MessageLogger.h"
 #include "range/v3/view.hpp"
+#include "tbb/task_arena.h"
+#include "tbb/task_group.h"
 
 #include <memory>
 #include <type_traits>
@@ -168,12 +170,46 @@ namespace art {
     }
   }
 
+  template <typename F>
+  void
+  EndPathExecutor::writeAll_(F write)
+  {
+    // The writes are done under the lock serializing the output of
+    // events, so the calling thread must not pick up unrelated tasks
+    // (which could need that lock) while it waits for the others.
+    // The sPreWriteEvent/sPostWriteEvent signals of concurrent writers
+    // are emitted from their own tasks.  Like sPreModule/sPostModule
+    // for the modules of a path, their watchers must tolerate calls
+    // for different modules at the same time, distinguished by the
+    // module context.
+    tbb::this_task_arena::isolate([this, &write] {
+      tbb::task_group group;
+      for (auto ow : outputWorkers_) {
+        if (ow->writesConcurrently()) {
+          group.run([ow, &write] { write(ow); });
+        }
+      }
+      try {
+        for (auto ow : outputWorkers_) {
+          if (!ow->writesConcurrently()) {
+            write(ow);
+          }
+        }
+      }
+      catch (...) {
+        // The concurrent writes refer to the principal, so they must
+        // finish before the exception propagates.
+        group.wait();
+        throw;
+      }
+      group.wait();
+    });
+  }
+
   void
   EndPathExecutor::writeRun(RunPrincipal& rp)
   {
-    for (auto ow : outputWorkers_) {
-      ow->writeRun(rp);
-    }
+    writeAll_([&rp](OutputWorker* ow) { ow->writeRun(rp); });
     if (fileStatus_.load() == OutputFileStatus::Switching) {
       runRangeSetHandler_->rebase();
     }
@@ -198,9 +234,7 @@ namespace art {
   void
   EndPathExecutor::writeSubRun(SubRunPrincipal& srp)
   {
-    for (auto ow : outputWorkers_) {
-      ow->writeSubRun(srp);
-    }
+    writeAll_([&srp](OutputWorker* ow) { ow->writeSubRun(srp); });
     if (fileStatus_.load() == OutputFileStatus::Switching) {
       subRunRangeSetHandler_->rebase();
     }
@@ -316,9 +350,7 @@ namespace art {
     // for the end_path right now.  If users decide it is necessary to
     // know what they are, then we can provide them.
     PathContext const pc{sc_, PathContext::end_path_spec(), {}};
-    for (auto ow : outputWorkers_) {
-      ow->writeEvent(ep, pc);
-    }
+    writeAll_([&ep, &pc](OutputWorker* ow) { ow->writeEvent(ep, pc); });
     auto const& eid = ep.eventID();
     bool const lastInSubRun{ep.isLastInSubRun()};
     TDEBUG_FUNC_SI(5, sc_.id())
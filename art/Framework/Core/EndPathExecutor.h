@@ -119,6 +119,13 @@ namespace art {
   private:
     class PathsDoneTask;
 
+    // Call 'write' for each output worker.  The workers of modules
+    // configured with 'writeConcurrently: true' are called in parallel
+    // with each other and with the remaining workers, which are called
+    // in order on the calling thread.
+    template <typename F>
+    void writeAll_(F write);
+
     // Filled by ctor, const after that.
     ScheduleContext const sc_;
     ActionTable const& actionTable_;
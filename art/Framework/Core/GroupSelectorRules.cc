@@ -3,12 +3,14 @@
 #include "art/Persistency/Provenance/detail/branchNameComponentChecking.h"
 #include "boost/algorithm/string.hpp"
 #include "canvas/Persistency/Provenance/BranchDescription.h"
+#include "canvas/Persistency/Provenance/BranchKey.h"
 #include "canvas/Utilities/Exception.h"
 
 #include <algorithm>
 #include <cassert>
 #include <regex>
 #include <string>
+#include <utility>
 
 using namespace art;
 using namespace cet;
@@ -19,18 +21,8 @@ using VCBDMP = vector<BranchDescription const*>;
 
 namespace {
 
-  // The partial_match() functions are helpers for Rule().  They
-  // ascertain matches between criterion and candidate value for
-  // components of the branch description, with appropriate wildcard
-  // rules.
-  inline bool
-  partial_match(string const& regularExpression, string const& branchstring)
-  {
-    return regularExpression.empty() ?
-             branchstring == "" :
-             std::regex_match(branchstring, std::regex(regularExpression));
-  }
-
+  // Helper for Rule, ascertaining a match between the criterion and
+  // the candidate branch type.
   inline bool
   partial_match(art::BranchType wanted, art::BranchType candidate)
   {
@@ -75,10 +67,10 @@ namespace {
     }
     selectflag = (ruleMatch[1].str() == "keep");
     if (ruleMatch[2].str() == "*") { // special case for wildcard
-      components.friendlyClassName_ = ".*";
-      components.moduleLabel_ = ".*";
-      components.productInstanceName_ = ".*";
-      components.processName_ = ".*";
+      components.friendlyClassName_ = "*";
+      components.moduleLabel_ = "*";
+      components.productInstanceName_ = "*";
+      components.processName_ = "*";
     } else {
       std::string errMsg;
 
@@ -99,14 +91,6 @@ namespace {
           << ".\n"
           << rulesMsg;
       }
-      boost::replace_all(components.friendlyClassName_, "*", ".*");
-      boost::replace_all(components.friendlyClassName_, "?", ".");
-      boost::replace_all(components.moduleLabel_, "*", ".*");
-      boost::replace_all(components.moduleLabel_, "?", ".");
-      boost::replace_all(components.productInstanceName_, "*", ".*");
-      boost::replace_all(components.productInstanceName_, "?", ".");
-      boost::replace_all(components.processName_, "*", ".*");
-      boost::replace_all(components.processName_, "?", ".");
     }
     if ((ruleMatch[3].length() > 0) && // Have a BranchType specification.
         (ruleMatch[3] != "*")) {       // Wildcard is NOP, here.
@@ -139,46 +123,95 @@ namespace {
 
 } // namespace
 
-GroupSelectorRules::Rule::Rule(string const& s,
-                               string const& parameterName,
-                               string const& owner)
-  : components_{parseComponents(s, parameterName, owner, selectflag_)}
+GroupSelectorRules::Pattern::Pattern(string pattern)
+  : pattern_{move(pattern)}
+  , matchesAll_{pattern_ == "*"}
+  , literal_{pattern_.find_first_of("*?") == string::npos}
 {}
 
-void
-GroupSelectorRules::Rule::applyToAll(
-  vector<BranchSelectState>& branchstates) const
+bool
+GroupSelectorRules::Pattern::matches(string const& candidate) const
 {
-  for (auto& state : branchstates)
-    applyToOne(state.desc, state.selectMe);
+  if (matchesAll_) {
+    return true;
+  }
+  if (literal_) {
+    return candidate == pattern_;
+  }
+  // Greedy matching, backtracking to the most recent '*' on mismatch.
+  size_t p{}, c{};
+  auto star = string::npos;
+  size_t resume{};
+  while (c < candidate.size()) {
+    if (p < pattern_.size() &&
+        (pattern_[p] == '?' || pattern_[p] == candidate[c])) {
+      ++p;
+      ++c;
+    } else if (p < pattern_.size() && pattern_[p] == '*') {
+      star = p++;
+      resume = c;
+    } else if (star != string::npos) {
+      p = star + 1;
+      c = ++resume;
+    } else {
+      return false;
+    }
+  }
+  while (p < pattern_.size() && pattern_[p] == '*') {
+    ++p;
+  }
+  return p == pattern_.size();
 }
 
-void
-GroupSelectorRules::applyToAll(vector<BranchSelectState>& branchstates) const
+GroupSelectorRules::Rule::Rule(string const& s,
+                               string const& parameterName,
+                               string const& owner)
 {
-  for (auto const& rule : rules_)
-    rule.applyToAll(branchstates);
+  auto const components = parseComponents(s, parameterName, owner, selectflag_);
+  friendlyClassName_ = Pattern{components.friendlyClassName_};
+  moduleLabel_ = Pattern{components.moduleLabel_};
+  productInstanceName_ = Pattern{components.productInstanceName_};
+  processName_ = Pattern{components.processName_};
+  branchType_ = static_cast<BranchType>(components.branchType_);
 }
 
 void
-GroupSelectorRules::Rule::applyToOne(BranchDescription const* branch,
-                                     bool& result) const
+GroupSelectorRules::applyToAll(vector<BranchSelectState>& branchstates) const
 {
-  if (this->appliesTo(branch))
-    result = selectflag_;
+  if (keepAll_) {
+    for (auto& state : branchstates)
+      state.selectMe = true;
+    return;
+  }
+
+  std::lock_guard lock{cacheMutex_};
+  for (auto& state : branchstates) {
+    auto const& pd = *state.desc;
+    auto& cache = cache_[pd.branchType()];
+    auto it = cache.find(pd.productID());
+    if (it == cache.end()) {
+      // Each rule can override any previous rule, so only the last
+      // rule that applies matters.
+      std::optional<bool> flag;
+      for (auto const& rule : rules_) {
+        if (rule.appliesTo(state.desc)) {
+          flag = rule.selectFlag();
+        }
+      }
+      it = cache.emplace(pd.productID(), flag).first;
+    }
+    state.selectMe = it->second.value_or(state.selectMe);
+  }
 }
 
 bool
 GroupSelectorRules::Rule::appliesTo(BranchDescription const* branch) const
 {
-  return partial_match(components_.friendlyClassName_,
-                       branch->friendlyClassName()) &&
-         partial_match(components_.moduleLabel_, branch->moduleLabel()) &&
-         partial_match(components_.productInstanceName_,
-                       branch->productInstanceName()) &&
-         partial_match(components_.processName_, branch->processName()) &&
-         partial_match(static_cast<BranchType>(components_.branchType_),
-                       branch->branchType());
+  return partial_match(branchType_, branch->branchType()) &&
+         moduleLabel_.matches(branch->moduleLabel()) &&
+         processName_.matches(branch->processName()) &&
+         productInstanceName_.matches(branch->productInstanceName()) &&
+         friendlyClassName_.matches(branch->friendlyClassName());
 }
 
 GroupSelectorRules::GroupSelectorRules(vector<string> const& commands,
@@ -5,11 +5,21 @@
 //
 // GroupSelectorRules: rules to select specific groups in an event.
 //
+// The rules are compiled into wildcard matchers when constructed.  As
+// the outcome for a product depends only on its branch type and
+// product ID, it is remembered, so that the rules are evaluated only
+// once per product, however many input files present it.
+//
 // ======================================================================
 
-#include "canvas/Persistency/Provenance/BranchKey.h"
+#include "canvas/Persistency/Provenance/BranchType.h"
+#include "canvas/Persistency/Provenance/ProductID.h"
 #include "canvas/Persistency/Provenance/fwd.h"
 
+#include <array>
+#include <map>
+#include <mutex>
+#include <optional>
 #include <string>
 #include <vector>
 
@@ -46,20 +56,34 @@ public:
   }
 
 private:
+  // A component of a selection rule, in which '*' matches any number
+  // of characters and '?' exactly one.
+  class Pattern {
+  public:
+    Pattern() = default;
+    explicit Pattern(std::string pattern);
+
+    bool matches(std::string const& candidate) const;
+
+  private:
+    std::string pattern_{};
+    bool matchesAll_{false};
+    bool literal_{true};
+  }; // Pattern
+
   class Rule {
   public:
     Rule(std::string const& s,
          std::string const& parameterName,
          std::string const& owner);
 
-    // Apply the rule to all the given branch states. This may modify
-    // the given branch states.
-    void applyToAll(std::vector<BranchSelectState>& branchstates) const;
-
-    // If this rule applies to the given BranchDescription, then
-    // modify 'result' to match the rule's select flag. If the rule does
-    // not apply, do not modify 'result'.
-    void applyToOne(BranchDescription const* branch, bool& result) const;
+    // The value to which the 'select bit' is set if this rule
+    // applies.
+    bool
+    selectFlag() const
+    {
+      return selectflag_;
+    }
 
     // Return the answer to the question: "Does the rule apply to this
     // BranchDescription?"
@@ -69,12 +93,21 @@ private:
     // selectflag_ carries the value to which we should set the 'select
     // bit' if this rule matches.
     bool selectflag_{false};
-    BranchKey components_;
+    Pattern friendlyClassName_{};
+    Pattern moduleLabel_{};
+    Pattern productInstanceName_{};
+    Pattern processName_{};
+    BranchType branchType_{NumBranchTypes};
   }; // Rule
 
 private:
   std::vector<Rule> rules_{};
   bool keepAll_;
+  // For each product seen so far, the flag of the last rule that
+  // applies to it, if any.
+  mutable std::mutex cacheMutex_{};
+  mutable std::array<std::map<ProductID, std::optional<bool>>, NumBranchTypes>
+    cache_{};
 }; // GroupSelectorRules
 
 // ======================================================================
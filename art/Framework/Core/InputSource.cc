@@ -1,6 +1,8 @@
 #include "art/Framework/Core/InputSource.h"
 // vim: set sw=2 expandtab :
 
+#include "art/Framework/Principal/EventPrincipal.h"
+
 namespace art {
 
   InputSource::~InputSource() = default;
@@ -39,6 +41,12 @@ namespace art {
     return moduleDescription_.processConfiguration();
   }
 
+  void
+  InputSource::discardEvent(cet::exempt_ptr<SubRunPrincipal const> srp)
+  {
+    readEvent(srp);
+  }
+
   void
   InputSource::skipEvents(int)
   {
@@ -50,6 +58,21 @@ namespace art {
          "RootInput)\n";
   }
 
+  std::size_t
+  InputSource::claimEvent()
+  {
+    return 0;
+  }
+
+  std::unique_ptr<EventPrincipal>
+  InputSource::readClaimedEvent(std::size_t,
+                                cet::exempt_ptr<SubRunPrincipal const>)
+  {
+    throw Exception(errors::LogicError)
+      << "The input source has not granted any event claims, and so it\n"
+      << "cannot read a claimed event.\n";
+  }
+
   void
   InputSource::doBeginJob()
   {}
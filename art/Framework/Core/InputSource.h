@@ -12,6 +12,7 @@
 #include "art/Persistency/Provenance/ModuleDescription.h"
 #include "cetlib/exempt_ptr.h"
 
+#include <cstddef>
 #include <memory>
 #include <ostream>
 
@@ -88,6 +89,27 @@ namespace art {
     virtual std::unique_ptr<RangeSetHandler> runRangeSetHandler() = 0;
     virtual std::unique_ptr<RangeSetHandler> subRunRangeSetHandler() = 0;
 
+    // Advance past the next event without processing it, as a worker
+    // of a job run with --fork does for the events of other workers.
+    // The default implementation reads the event and drops it; sources
+    // that can skip an event without creating its principal should
+    // override this.
+    virtual void discardEvent(cet::exempt_ptr<SubRunPrincipal const> srp);
+
+    // Concurrent Access Interface
+
+    // Sources that create events without I/O may hand out the events
+    // of the current subrun to several schedules at once, without the
+    // input-source lock being held.  claimEvent() reserves the next
+    // such event, returning a non-zero claim, or zero if there is none
+    // (the schedule then falls back to the serial interface).
+    // readClaimedEvent() creates the principal for a claimed event.
+    // The default implementation never grants a claim.
+    virtual std::size_t claimEvent();
+    virtual std::unique_ptr<EventPrincipal> readClaimedEvent(
+      std::size_t claim,
+      cet::exempt_ptr<SubRunPrincipal const> srp);
+
     // Job Interface
     virtual void doBeginJob();
     virtual void doEndJob();
@@ -31,6 +31,10 @@
 namespace art::detail {
   using ModuleMaker_t = ModuleBase*(fhicl::ParameterSet const&,
                                     ProcessingFrame const&);
+  using ModuleConfigMaker_t =
+    std::shared_ptr<void const>(fhicl::ParameterSet const&);
+  using ModuleFromConfigMaker_t = ModuleBase*(void const*,
+                                              ProcessingFrame const&);
   using ModuleTypeFunc_t = ModuleType();
   using ModuleThreadingTypeFunc_t = ModuleThreadingType();
 
@@ -47,12 +51,20 @@ namespace art::detail {
   template <typename T>
   using ConfigFor = typename config_for_impl<T>::type;
 
+  // The validated configuration of a module, from which any number of
+  // copies of the module (e.g. one per schedule) may be made.
+  template <typename T>
+  std::shared_ptr<void const>
+  make_module_config(fhicl::ParameterSet const& pset)
+  {
+    return std::make_shared<ConfigFor<T> const>(pset);
+  }
+
   template <typename T>
   T*
-  make_module(fhicl::ParameterSet const& pset, ProcessingFrame const& frame)
+  make_module_from_config(void const* config_ptr, ProcessingFrame const& frame)
   {
-    // Reference to avoid copy if ConfigFor<T> is a ParameterSet.
-    ConfigFor<T> const& config{pset};
+    auto const& config = *static_cast<ConfigFor<T> const*>(config_ptr);
     if constexpr (ModuleThreadingTypeDeducer<typename T::ModuleType>::value ==
                   ModuleThreadingType::legacy) {
       return new T{config};
@@ -60,6 +72,15 @@ namespace art::detail {
       return new T{config, frame};
     }
   }
+
+  template <typename T>
+  T*
+  make_module(fhicl::ParameterSet const& pset, ProcessingFrame const& frame)
+  {
+    // Reference to avoid copy if ConfigFor<T> is a ParameterSet.
+    ConfigFor<T> const& config{pset};
+    return make_module_from_config<T>(&config, frame);
+  }
 }
 
 #define DEFINE_ART_MODULE(klass)                                               \
@@ -72,6 +93,17 @@ namespace art::detail {
   {                                                                            \
     return art::detail::make_module<klass>(pset, frame);                       \
   }                                                                            \
+  std::shared_ptr<void const>                                                  \
+  make_module_config(fhicl::ParameterSet const& pset)                          \
+  {                                                                            \
+    return art::detail::make_module_config<klass>(pset);                       \
+  }                                                                            \
+  art::ModuleBase*                                                             \
+  make_module_from_config(void const* config,                                  \
+                          art::ProcessingFrame const& frame)                   \
+  {                                                                            \
+    return art::detail::make_module_from_config<klass>(config, frame);         \
+  }                                                                            \
   art::ModuleType                                                              \
   moduleType()                                                                 \
   {                                                                            \
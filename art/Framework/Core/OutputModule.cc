@@ -30,7 +30,7 @@
 #include "canvas/Persistency/Provenance/fwd.h"
 #include "canvas/Utilities/DebugMacros.h"
 #include "canvas/Utilities/Exception.h"
-#include "cetlib/BasicPluginFactory.h"
+#include "cetlib/PluginTypeDeducer.h"
 #include "cetlib/canonical_string.h"
 #include "fhiclcpp/ParameterSet.h"
 #include "range/v3/view.hpp"
@@ -63,6 +63,7 @@ namespace art {
     , configuredFileName_{config().fileName()}
     , dataTier_{config().dataTier()}
     , streamName_{config().streamName()}
+    , writeConcurrently_{config().writeConcurrently()}
   {
     std::vector<ParameterSet> fcmdPluginPSets;
     if (config().fcmdPlugins.get_if_present(fcmdPluginPSets)) {
@@ -80,8 +81,18 @@ namespace art {
     , configuredFileName_{pset.get<string>("fileName", "")}
     , dataTier_{pset.get<string>("dataTier", "")}
     , streamName_{pset.get<string>("streamName", "")}
+    , writeConcurrently_{false}
     , plugins_{makePlugins_(pset.get<vector<ParameterSet>>("FCMDPlugins", {}))}
   {
+    // Modules configured without validation predate concurrent writes,
+    // and cannot be assumed to tolerate them.
+    if (pset.get<bool>("writeConcurrently", false)) {
+      throw Exception{errors::Configuration}
+        << "The output module '" << pset.get<string>("module_label", "")
+        << "' is constructed from a ParameterSet rather than from a\n"
+           "validated configuration, and so cannot set "
+           "'writeConcurrently: true'.\n";
+    }
     serialize(detail::LegacyResource);
   }
 
@@ -97,6 +108,12 @@ namespace art {
     return isFileOpen();
   }
 
+  bool
+  OutputModule::writesConcurrently() const noexcept
+  {
+    return writeConcurrently_;
+  }
+
   void
   OutputModule::incrementInputFileNumber()
   {}
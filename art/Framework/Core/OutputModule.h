@@ -22,12 +22,12 @@
 #include "art/Framework/Services/System/FileCatalogMetadata.h"
 #include "art/Persistency/Provenance/Selections.h"
 #include "art/Persistency/Provenance/fwd.h"
+#include "art/Utilities/PluginFactory.h"
 #include "canvas/Persistency/Provenance/BranchChildren.h"
 #include "canvas/Persistency/Provenance/BranchType.h"
 #include "canvas/Persistency/Provenance/ParentageID.h"
 #include "canvas/Persistency/Provenance/ProductID.h"
 #include "canvas/Persistency/Provenance/fwd.h"
-#include "cetlib/BasicPluginFactory.h"
 #include "fhiclcpp/ParameterSet.h"
 #include "fhiclcpp/types/Atom.h"
 #include "fhiclcpp/types/OptionalDelegatedParameter.h"
@@ -84,6 +84,15 @@ The ROOT output module supports the placeholders described at:
         ""};
       fhicl::Atom<std::string> dataTier{fhicl::Name("dataTier"), ""};
       fhicl::Atom<std::string> streamName{fhicl::Name("streamName"), ""};
+      fhicl::Atom<bool> writeConcurrently{
+        fhicl::Name("writeConcurrently"),
+        fhicl::Comment(
+          "If 'true', the writes of this module may overlap those of other\n"
+          "output modules.  Enable only for modules that do not share\n"
+          "thread-unsafe state (e.g. a common file) with any other output\n"
+          "module.  The writes of one module are never concurrent with\n"
+          "each other, so events stay in order within each file."),
+        false};
       fhicl::OptionalDelegatedParameter fcmdPlugins{
         fhicl::Name("FCMDPlugins"),
         fhicl::Comment(
@@ -106,6 +115,7 @@ The ROOT output module supports the placeholders described at:
     OutputModule& operator=(OutputModule&&) = delete;
 
     bool fileIsOpen() const;
+    bool writesConcurrently() const noexcept;
     OutputFileStatus fileStatus() const;
     // Name of output file (may be overridden if default implementation is
     // not appropriate).
@@ -234,8 +244,9 @@ The ROOT output module supports the placeholders described at:
     std::string configuredFileName_;
     std::string dataTier_;
     std::string streamName_;
+    bool writeConcurrently_;
     ServiceHandle<CatalogInterface> ci_{};
-    cet::BasicPluginFactory pluginFactory_{};
+    PluginFactory pluginFactory_{};
 
     // For diagnostics.
     std::vector<std::string> pluginNames_{};
@@ -31,10 +31,10 @@ namespace art {
       fhicl::ParameterSetRegistry::get(description().parameterSetID()));
   }
 
-  hep::concurrency::SerialTaskQueueChain*
-  OutputWorker::doSerialTaskQueueChain() const
+  detail::ResourceQueue*
+  OutputWorker::doResourceQueue() const
   {
-    return module_->serialTaskQueueChain();
+    return module_->resourceQueue();
   }
 
   void
@@ -103,7 +103,7 @@ namespace art {
     // Note, only filters ever return false, and when they do it means
     // they have rejected.
     return module_->doEvent(
-      ep, mc, counts_run_, counts_passed_, counts_failed_);
+      ep, mc, counts_.run, counts_.passed, counts_.failed);
   }
 
   std::string const&
@@ -183,6 +183,12 @@ namespace art {
     return module_->fileIsOpen();
   }
 
+  bool
+  OutputWorker::writesConcurrently() const
+  {
+    return module_->writesConcurrently();
+  }
+
   void
   OutputWorker::setFileStatus(OutputFileStatus const ofs)
   {
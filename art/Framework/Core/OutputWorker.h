@@ -30,6 +30,7 @@ namespace art {
     std::string const& lastClosedFileName() const;
     void closeFile();
     bool fileIsOpen() const;
+    bool writesConcurrently() const;
     void incrementInputFileNumber();
     bool requestsToCloseFile() const;
     void openFile(FileBlock const& fb);
@@ -43,8 +44,7 @@ namespace art {
     void selectProducts(ProductTables const&);
 
   private:
-    hep::concurrency::SerialTaskQueueChain* doSerialTaskQueueChain()
-      const override;
+    detail::ResourceQueue* doResourceQueue() const override;
     void doBeginJob(detail::SharedResources const&) override;
     void doEndJob() override;
     void doRespondToOpenInputFile(FileBlock const&) override;
@@ -28,6 +28,22 @@
 using namespace hep::concurrency;
 using namespace std;
 
+namespace {
+  // Only one thread at a time increments a given path counter.
+  void
+  increment(std::atomic<std::size_t>& counter)
+  {
+    counter.store(counter.load(std::memory_order_relaxed) + 1,
+                  std::memory_order_relaxed);
+  }
+
+  std::size_t
+  value_of(std::atomic<std::size_t> const& counter)
+  {
+    return counter.load(std::memory_order_relaxed);
+  }
+}
+
 namespace art {
 
   Path::Path(ActionTable const& actions,
@@ -72,28 +88,37 @@ namespace art {
     return pc_.pathName();
   }
 
+  Path::CountsSnapshot
+  Path::countsSnapshot() const
+  {
+    return {value_of(counts_->run),
+            value_of(counts_->passed),
+            value_of(counts_->failed),
+            value_of(counts_->except)};
+  }
+
   size_t
   Path::timesRun() const
   {
-    return timesRun_;
+    return value_of(counts_->run);
   }
 
   size_t
   Path::timesPassed() const
   {
-    return timesPassed_;
+    return value_of(counts_->passed);
   }
 
   size_t
   Path::timesFailed() const
   {
-    return timesFailed_;
+    return value_of(counts_->failed);
   }
 
   size_t
   Path::timesExcept() const
   {
-    return timesExcept_;
+    return value_of(counts_->except);
   }
 
   hlt::HLTState
@@ -196,7 +221,7 @@ namespace art {
 
     // Make sure the list is not auto-spawning tasks.
     actReg_.sPreProcessPath.invoke(pc_);
-    ++timesRun_;
+    increment(counts_->run);
     state_ = hlt::Ready;
     size_t idx = 0;
     auto max_idx = workers_.size();
@@ -276,7 +301,7 @@ namespace art {
           assert(action != actions::FailModule);
           if (action != actions::FailPath) {
             // Possible actions: IgnoreCompletely, Rethrow, SkipEvent
-            ++path_->timesExcept_;
+            increment(path_->counts_->except);
             path_->state_ = hlt::Exception;
             if (path_->trptr_) {
               // Not the end path.
@@ -301,7 +326,7 @@ namespace art {
         catch (...) {
           mf::LogError("PassingThrough")
             << "Exception passing through path " << path_->name();
-          ++path_->timesExcept_;
+          increment(path_->counts_->except);
           path_->state_ = hlt::Exception;
           if (path_->trptr_) {
             // Not the end path.
@@ -381,10 +406,10 @@ namespace art {
     TDEBUG_FUNC_SI(4, sid) << "idx: " << idx
                            << " should_continue: " << should_continue;
     if (should_continue) {
-      ++timesPassed_;
+      increment(counts_->passed);
       state_ = hlt::Pass;
     } else {
-      ++timesFailed_;
+      increment(counts_->failed);
       state_ = hlt::Fail;
     }
 
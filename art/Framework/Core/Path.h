@@ -13,6 +13,7 @@
 #include "art/Framework/Core/WorkerInPath.h"
 #include "art/Framework/Principal/fwd.h"
 #include "art/Persistency/Provenance/PathContext.h"
+#include "art/Utilities/CacheLine.h"
 #include "art/Utilities/ScheduleID.h"
 #include "art/Utilities/Transition.h"
 #include "art/Utilities/fwd.h"
@@ -21,7 +22,9 @@
 #include "cetlib/exempt_ptr.h"
 #include "hep_concurrency/WaitingTask.h"
 
+#include <atomic>
 #include <cstddef>
+#include <memory>
 #include <string>
 #include <vector>
 
@@ -30,6 +33,15 @@ namespace art {
   class EventPrincipal;
   class Path {
   public:
+    // A copy of the execution statistics.  Each count is individually
+    // up to date, but the counts are not read as a single transaction.
+    struct CountsSnapshot {
+      std::size_t run{};
+      std::size_t passed{};
+      std::size_t failed{};
+      std::size_t except{};
+    };
+
     Path(ActionTable const&,
          ActivityRegistry const&,
          PathContext const&,
@@ -43,6 +55,8 @@ namespace art {
     std::string const& name() const;
     std::vector<WorkerInPath> const& workersInPath() const;
     hlt::HLTState state() const;
+    // May be called from any thread while events are being processed.
+    CountsSnapshot countsSnapshot() const;
     std::size_t timesRun() const;
     std::size_t timesPassed() const;
     std::size_t timesFailed() const;
@@ -93,10 +107,21 @@ namespace art {
 
     // These are adjusted in a serialized context.
     hlt::HLTState state_{hlt::Ready};
-    std::size_t timesRun_{};
-    std::size_t timesPassed_{};
-    std::size_t timesFailed_{};
-    std::size_t timesExcept_{};
+
+    // Note: threading: The counters are only ever incremented by the
+    // task that is currently running this path, so a relaxed
+    // load-and-store suffices and no locked instruction is needed.
+    // They are atomic only so that they may be read from other threads
+    // while the job is running, and they are kept on their own cache
+    // line since the paths of a schedule run concurrently.  They are
+    // held through a pointer so that the path remains movable.
+    struct alignas(cache_line_size) Counts {
+      std::atomic<std::size_t> run{};
+      std::atomic<std::size_t> passed{};
+      std::atomic<std::size_t> failed{};
+      std::atomic<std::size_t> except{};
+    };
+    std::unique_ptr<Counts> counts_{std::make_unique<Counts>()};
   };
 } // namespace art
 
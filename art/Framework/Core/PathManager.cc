@@ -2,10 +2,12 @@
 // vim: set sw=2 expandtab :
 
 #include "art/Framework/Core/ModuleBase.h"
+#include "art/Framework/Core/ModuleMacros.h"
 #include "art/Framework/Core/PathsInfo.h"
 #include "art/Framework/Core/TriggerResultInserter.h"
 #include "art/Framework/Core/WorkerInPath.h"
 #include "art/Framework/Core/detail/ModuleGraphInfoMap.h"
+#include "art/Framework/Core/detail/SharedModule.h"
 #include "art/Framework/Core/detail/consumed_products.h"
 #include "art/Framework/Core/detail/graph_algorithms.h"
 #include "art/Framework/Core/fwd.h"
@@ -25,7 +27,6 @@
 #include "art/Version/GetReleaseVersion.h"
 #include "canvas/Utilities/Exception.h"
 #include "cetlib/HorizontalRule.h"
-#include "cetlib/LibraryManager.h"
 #include "cetlib/bold_fontify.h"
 #include "cetlib/container_algorithms.h"
 #include "cetlib/detail/wrapLibraryManagerException.h"
@@ -52,6 +53,19 @@ using namespace std;
 
 using fhicl::ParameterSet;
 
+namespace {
+  string
+  misconfiguration_message(art::ModuleDescription const& md,
+                           fhicl::detail::validationException const& e)
+  {
+    ostringstream es;
+    es << "\n\nModule label: " << cet::bold_fontify(md.moduleLabel())
+       << "\nmodule_type : " << cet::bold_fontify(md.moduleName()) << "\n\n"
+       << e.what();
+    return es.str();
+  }
+}
+
 namespace art {
 
   namespace {
@@ -130,6 +144,9 @@ namespace art {
         auto const& mci = allModules_.at(label);
         auto const mci_p = cet::make_exempt_ptr(&mci);
         protoEndPathLabels_.emplace_back(mci_p, action);
+        if (mci.moduleType == ModuleType::output_module) {
+          hasOutputModules_ = true;
+        }
       }
     }
 
@@ -343,16 +360,25 @@ namespace art {
     ModulesByThreadingType modules{};
     vector<string> configErrMsgs;
     for (auto const& [module_label, mci] : allModules_) {
-      auto const& modPS = mci.modPS;
       auto const& md = mci.modDescription;
-      auto const module_type = md.moduleName();
       auto const module_threading_type = md.moduleThreadingType();
 
       // FIXME: provide context information?
       actReg_.sPreModuleConstruction.invoke(md);
 
+      // Validation is part of the module's construction, as seen by
+      // construction watchers.
+      auto const config = makeModuleConfig_(mci);
+      if (auto err_msg = get_if<std::string>(&config)) {
+        configErrMsgs.push_back(*err_msg);
+        continue;
+      }
+      // All copies of a replicated module are made from the same
+      // validated configuration.
+      auto const& config_ptr = std::get<std::shared_ptr<void const>>(config);
+
       auto sid = ScheduleID::first();
-      auto mod = makeModule_(modPS, md, sid);
+      auto mod = makeModule_(config_ptr.get(), md, sid);
       if (auto err_msg = get_if<std::string>(&mod)) {
         configErrMsgs.push_back(*err_msg);
         continue;
@@ -373,7 +399,7 @@ namespace art {
                                              ScheduleID(nschedules)};
 
         auto fill_replicated_module = [&, this](ScheduleID const sid) {
-          auto repl_mod = makeModule_(modPS, md, sid);
+          auto repl_mod = makeModule_(config_ptr.get(), md, sid);
           if (auto mod_ptr = get_if<ModuleBase*>(&repl_mod)) {
             replicated_modules[sid].reset(*mod_ptr);
           }
@@ -383,6 +409,9 @@ namespace art {
       }
 
       actReg_.sPostModuleConstruction.invoke(md);
+      if (auto const sm = dynamic_cast<detail::SharedModule const*>(module)) {
+        actReg_.sPostModuleSharedResources.invoke(md, sm->sharedResources());
+      }
 
       // Since we store consumes information per module label, we only
       // sort and collect it for one of the replicated-module copies.
@@ -409,36 +438,36 @@ namespace art {
     return modules;
   }
 
+  PathManager::maybe_config_t
+  PathManager::makeModuleConfig_(detail::ModuleConfigInfo const& mci) const
+  try {
+    // Each configuration is validated once, and shared by all copies
+    // of a replicated module.  Validation is done serially: making the
+    // typed configuration uses fhiclcpp's global table registries,
+    // which are not thread-safe, and no TBB threads may be started
+    // before the workers are forked (see ForkCoordinator).
+    auto const make_config = loadModuleSymbol_<detail::ModuleConfigMaker_t>(
+      mci.modDescription.moduleName(), "make_module_config");
+    return make_config(mci.modPS);
+  }
+  catch (fhicl::detail::validationException const& e) {
+    return misconfiguration_message(mci.modDescription, e);
+  }
+
   PathManager::maybe_module_t
-  PathManager::makeModule_(ParameterSet const& modPS,
+  PathManager::makeModule_(void const* const config,
                            ModuleDescription const& md,
                            ScheduleID const sid) const
   try {
-    auto const& module_type = md.moduleName();
-    detail::ModuleMaker_t* module_factory_func{nullptr};
-    try {
-      lm_.getSymbolByLibspec(module_type, "make_module", module_factory_func);
-    }
-    catch (Exception& e) {
-      cet::detail::wrapLibraryManagerException(
-        e, "Module", module_type, getReleaseVersion());
-    }
-    if (module_factory_func == nullptr) {
-      throw Exception(errors::Configuration, "BadPluginLibrary: ")
-        << "Module " << module_type << " with version " << getReleaseVersion()
-        << " has internal symbol definition problems: consult an "
-           "expert.";
-    }
-    auto mod = module_factory_func(modPS, ProcessingFrame{sid});
+    auto const module_factory_func =
+      loadModuleSymbol_<detail::ModuleFromConfigMaker_t>(
+        md.moduleName(), "make_module_from_config");
+    auto mod = module_factory_func(config, ProcessingFrame{sid});
     mod->setModuleDescription(md);
     return mod;
   }
   catch (fhicl::detail::validationException const& e) {
-    ostringstream es;
-    es << "\n\nModule label: " << cet::bold_fontify(md.moduleLabel())
-       << "\nmodule_type : " << cet::bold_fontify(md.moduleName()) << "\n\n"
-       << e.what();
-    return es.str();
+    return misconfiguration_message(md, e);
   }
 
   std::unique_ptr<ReplicatedProducer>
@@ -555,6 +584,28 @@ namespace art {
     return mod_type_func();
   }
 
+  template <typename F>
+  F*
+  PathManager::loadModuleSymbol_(string const& lib_spec,
+                                 string const& sym_name) const
+  {
+    F* symbol{nullptr};
+    try {
+      lm_.getSymbolByLibspec(lib_spec, sym_name, symbol);
+    }
+    catch (Exception& e) {
+      cet::detail::wrapLibraryManagerException(
+        e, "Module", lib_spec, getReleaseVersion());
+    }
+    if (symbol == nullptr) {
+      throw Exception(errors::Configuration, "BadPluginLibrary: ")
+        << "Module " << lib_spec << " with version " << getReleaseVersion()
+        << " has internal symbol definition problems: consult an "
+           "expert.";
+    }
+    return symbol;
+  }
+
   ModuleThreadingType
   PathManager::loadModuleThreadingType_(string const& lib_spec) const
   {
@@ -23,10 +23,10 @@
 #include "art/Framework/Core/detail/graph_type_aliases.h"
 #include "art/Persistency/Provenance/ModuleType.h"
 #include "art/Utilities/PerScheduleContainer.h"
+#include "art/Utilities/PluginLibraryLoader.h"
 #include "art/Utilities/PluginSuffixes.h"
 #include "art/Utilities/ScheduleID.h"
 #include "canvas/Persistency/Provenance/BranchDescription.h"
-#include "cetlib/LibraryManager.h"
 #include "fhiclcpp/ParameterSet.h"
 
 #include <map>
@@ -72,6 +72,11 @@ namespace art {
     PerScheduleContainer<PathsInfo> const& triggerPathsInfo();
     PathsInfo& endPathInfo(ScheduleID);
     PerScheduleContainer<PathsInfo> const& endPathInfo();
+    bool
+    hasOutputModules() const noexcept
+    {
+      return hasOutputModules_;
+    }
 
   private:
     struct ModulesByThreadingType {
@@ -88,8 +93,11 @@ namespace art {
     std::unique_ptr<ReplicatedProducer> makeTriggerResultsInserter_(
       ScheduleID scheduleID);
 
+    using maybe_config_t =
+      std::variant<std::shared_ptr<void const>, std::string>;
+    maybe_config_t makeModuleConfig_(detail::ModuleConfigInfo const&) const;
     using maybe_module_t = std::variant<ModuleBase*, std::string>;
-    maybe_module_t makeModule_(fhicl::ParameterSet const& module_pset,
+    maybe_module_t makeModule_(void const* config,
                                ModuleDescription const& md,
                                ScheduleID) const;
     std::vector<WorkerInPath> fillWorkers_(
@@ -103,6 +111,9 @@ namespace art {
     ModuleType loadModuleType_(std::string const& lib_spec) const;
     ModuleThreadingType loadModuleThreadingType_(
       std::string const& lib_spec) const;
+    template <typename F>
+    F* loadModuleSymbol_(std::string const& lib_spec,
+                         std::string const& sym_name) const;
 
     // Module-graph implementation
     detail::collection_map_t getModuleGraphInfoCollection_(
@@ -129,7 +140,7 @@ namespace art {
     PerScheduleContainer<PathsInfo> endPathInfo_;
     ProductDescriptions& productsToProduce_;
 
-    cet::LibraryManager lm_{Suffixes::module()};
+    PluginLibraryLoader lm_{Suffixes::module()};
     //  The following data members are only needed to delay the
     //  creation of modules until after the service system has
     //  started.  We can move them back to the ctor once that is
@@ -140,6 +151,7 @@ namespace art {
     art::detail::configs_t protoEndPathLabels_{};
     ModulesByThreadingType modules_{};
     PerScheduleContainer<std::unique_ptr<Worker>> triggerResultsWorkers_;
+    bool hasOutputModules_{false};
   };
 } // namespace art
 
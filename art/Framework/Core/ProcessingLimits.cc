@@ -64,12 +64,13 @@ namespace art {
   void
   ProcessingLimits::update(EventID const& id)
   {
-    if (remainingEvents_ > 0) {
-      --remainingEvents_;
+    auto remaining = remainingEvents_.load();
+    while (remaining > 0 &&
+           !remainingEvents_.compare_exchange_weak(remaining, remaining - 1)) {
     }
-    ++numberOfEventsRead_;
-    if ((reportFrequency_ > 0) && !(numberOfEventsRead_ % reportFrequency_)) {
-      detail::issue_reports(numberOfEventsRead_, id);
+    auto const eventsRead = ++numberOfEventsRead_;
+    if ((reportFrequency_ > 0) && !(eventsRead % reportFrequency_)) {
+      detail::issue_reports(eventsRead, id);
     }
   }
 
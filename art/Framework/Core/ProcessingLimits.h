@@ -5,6 +5,7 @@
 #include "canvas/Persistency/Provenance/fwd.h"
 #include "fhiclcpp/types/Atom.h"
 
+#include <atomic>
 #include <functional>
 
 namespace art {
@@ -37,6 +38,8 @@ namespace art {
     // -1 is used for unlimited.
     int remainingSubRuns() const noexcept;
 
+    // Only update(EventID) may be called concurrently, with itself
+    // and with remainingEvents().
     void update(EventID const& id);
     void update(SubRunID const& id);
 
@@ -45,10 +48,10 @@ namespace art {
 
     InputSource::ProcessingMode processingMode_{
       InputSource::RunsSubRunsAndEvents};
-    int remainingEvents_;
+    std::atomic<int> remainingEvents_;
     int remainingSubRuns_;
     int reportFrequency_;
-    int numberOfEventsRead_{};
+    std::atomic<int> numberOfEventsRead_{};
     std::function<input::ItemType()> nextItemType_;
   };
 }
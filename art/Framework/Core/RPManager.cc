@@ -2,8 +2,9 @@
 // vim: set sw=2 expandtab :
 
 #include "art/Framework/Core/ResultsProducer.h"
+#include "art/Utilities/PluginFactory.h"
 #include "art/Utilities/PluginSuffixes.h"
-#include "cetlib/BasicPluginFactory.h"
+#include "cetlib/PluginTypeDeducer.h"
 #include "fhiclcpp/ParameterSet.h"
 
 #include <functional>
@@ -78,7 +79,7 @@ namespace art {
         << "Errors encountered while configuring ResultsProducers:\n"
         << errMsg;
     }
-    cet::BasicPluginFactory pf{Suffixes::plugin(), "makeRP"};
+    PluginFactory pf{Suffixes::plugin(), "makeRP"};
     for (auto const& [path_name, module_names] : paths) {
       auto ins_res = rpmap_.emplace(path_name, vector<unique_ptr<RPWorker>>{});
       transform(module_names.cbegin(),
@@ -103,6 +103,14 @@ namespace art {
     produce(e, frame);
   }
 
+  void
+  ReplicatedProducer::acquireWithFrame(Event const& e,
+                                       ProcessingFrame const& frame,
+                                       WaitingTaskHolder holder)
+  {
+    acquire(e, frame, std::move(holder));
+  }
+
   // Default implementations
   void
   ReplicatedProducer::beginJob(ProcessingFrame const&)
@@ -148,4 +156,10 @@ namespace art {
   ReplicatedProducer::endSubRun(SubRun const&, ProcessingFrame const&)
   {}
 
+  void
+  ReplicatedProducer::acquire(Event const&,
+                              ProcessingFrame const&,
+                              WaitingTaskHolder)
+  {}
+
 } // namespace art
@@ -51,6 +51,14 @@ namespace art {
     void beginSubRunWithFrame(SubRun&, ProcessingFrame const&) final;
     void endSubRunWithFrame(SubRun&, ProcessingFrame const&) final;
     void produceWithFrame(Event&, ProcessingFrame const&) final;
+    void acquireWithFrame(Event const&,
+                          ProcessingFrame const&,
+                          WaitingTaskHolder) final;
+    bool
+    externalWorkSupported() const noexcept final
+    {
+      return true;
+    }
 
     virtual void beginJob(ProcessingFrame const&);
     virtual void endJob(ProcessingFrame const&);
@@ -67,6 +75,9 @@ namespace art {
     virtual void beginSubRun(SubRun const&, ProcessingFrame const&);
     virtual void endSubRun(SubRun const&, ProcessingFrame const&);
     virtual void produce(Event&, ProcessingFrame const&) = 0;
+    virtual void acquire(Event const&,
+                         ProcessingFrame const&,
+                         WaitingTaskHolder);
   };
 
 } // namespace art
@@ -31,7 +31,7 @@ namespace art {
     {}
 
   private:
-    std::unique_ptr<Worker> doMakeWorker(WorkerParams const& wp) final;
+    std::unique_ptr<Worker> doMakeWorker(WorkerParams const& wp) override;
     void setupQueues(detail::SharedResources const& resources) final;
     void beginJobWithFrame(ProcessingFrame const&) final;
     void endJobWithFrame(ProcessingFrame const&) final;
@@ -93,6 +93,14 @@ namespace art {
     produce(e, frame);
   }
 
+  void
+  SharedProducer::acquireWithFrame(Event const& e,
+                                   ProcessingFrame const& frame,
+                                   WaitingTaskHolder holder)
+  {
+    acquire(e, frame, std::move(holder));
+  }
+
   // Default implementations
   void
   SharedProducer::beginJob(ProcessingFrame const&)
@@ -138,4 +146,10 @@ namespace art {
   SharedProducer::endSubRun(SubRun&, ProcessingFrame const&)
   {}
 
+  void
+  SharedProducer::acquire(Event const&,
+                          ProcessingFrame const&,
+                          WaitingTaskHolder)
+  {}
+
 } // namespace art
@@ -45,6 +45,14 @@ namespace art {
     void beginSubRunWithFrame(SubRun&, ProcessingFrame const&) final;
     void endSubRunWithFrame(SubRun&, ProcessingFrame const&) final;
     void produceWithFrame(Event&, ProcessingFrame const&) final;
+    void acquireWithFrame(Event const&,
+                          ProcessingFrame const&,
+                          WaitingTaskHolder) final;
+    bool
+    externalWorkSupported() const noexcept final
+    {
+      return true;
+    }
 
     virtual void beginJob(ProcessingFrame const&);
     virtual void endJob(ProcessingFrame const&);
@@ -61,6 +69,9 @@ namespace art {
     virtual void beginSubRun(SubRun&, ProcessingFrame const&);
     virtual void endSubRun(SubRun&, ProcessingFrame const&);
     virtual void produce(Event&, ProcessingFrame const&) = 0;
+    virtual void acquire(Event const&,
+                         ProcessingFrame const&,
+                         WaitingTaskHolder);
   };
 
 } // namespace art
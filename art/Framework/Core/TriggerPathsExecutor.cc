@@ -215,8 +215,10 @@ namespace art {
   {
     // We get here as part of the readAndProcessEventTask (schedule
     // head task).
-    actReg_.sPreProcessEvent.invoke(
-      event_principal.makeEvent(ModuleContext::invalid()), sc_);
+    if (!actReg_.sPreProcessEvent.empty()) {
+      actReg_.sPreProcessEvent.invoke(
+        event_principal.makeEvent(ModuleContext::invalid()), sc_);
+    }
     auto const scheduleID = sc_.id();
     TDEBUG_BEGIN_FUNC_SI(4, scheduleID);
     if (results_inserter_) {
@@ -3,15 +3,18 @@
 // vim: set sw=2 expandtab :
 
 #include "art/Framework/Core/ModuleBase.h"
+#include "art/Framework/Core/detail/BatchModule.h"
 #include "art/Framework/Core/fwd.h"
 #include "art/Framework/Principal/Worker.h"
 #include "art/Framework/Principal/WorkerParams.h"
 #include "art/Framework/Principal/fwd.h"
 #include "art/Utilities/SharedResource.h"
+#include "art/Utilities/WaitingTaskHolder.h"
 #include "cetlib/exempt_ptr.h"
 
 #include <memory>
 #include <type_traits>
+#include <vector>
 
 namespace art {
   class Modifier;
@@ -21,8 +24,7 @@ namespace art {
     WorkerT(T*, WorkerParams const&);
 
   private:
-    hep::concurrency::SerialTaskQueueChain* doSerialTaskQueueChain()
-      const override;
+    detail::ResourceQueue* doResourceQueue() const override;
     void doBeginJob(detail::SharedResources const&) override;
     void doEndJob() override;
     void doRespondToOpenInputFile(FileBlock const&) override;
@@ -34,6 +36,13 @@ namespace art {
     void doBegin(SubRunPrincipal&, ModuleContext const&) override;
     void doEnd(SubRunPrincipal&, ModuleContext const&) override;
     bool doProcess(EventPrincipal&, ModuleContext const&) override;
+    bool doHasAcquire() const override;
+    void doAcquire(EventPrincipal&,
+                   ModuleContext const&,
+                   WaitingTaskHolder) override;
+    detail::EventBatcher* doEventBatcher() const override;
+    std::vector<bool> doProcessBatch(
+      std::vector<detail::BatchEntry> const&) override;
 
     // A module is co-owned by one worker per schedule.  Only
     // replicated modules have a one-to-one correspondence with their
@@ -42,6 +51,7 @@ namespace art {
   };
 
   namespace detail {
+    class Producer;
     class SharedModule;
   }
 
@@ -72,11 +82,11 @@ namespace art {
   }
 
   template <typename T>
-  hep::concurrency::SerialTaskQueueChain*
-  WorkerT<T>::doSerialTaskQueueChain() const
+  detail::ResourceQueue*
+  WorkerT<T>::doResourceQueue() const
   {
     if constexpr (std::is_base_of_v<detail::SharedModule, T>) {
-      return module_->serialTaskQueueChain();
+      return module_->resourceQueue();
     } else {
       return nullptr;
     }
@@ -159,7 +169,63 @@ namespace art {
     // Note, only filters ever return false, and when they do it means
     // they have rejected.
     return module_->doEvent(
-      ep, mc, counts_run_, counts_passed_, counts_failed_);
+      ep, mc, counts_.run, counts_.passed, counts_.failed);
+  }
+
+  template <typename T>
+  bool
+  WorkerT<T>::doHasAcquire() const
+  {
+    if constexpr (std::is_base_of_v<detail::Producer, T>) {
+      return module_->hasAcquire();
+    } else {
+      return false;
+    }
+  }
+
+  template <typename T>
+  void
+  WorkerT<T>::doAcquire(EventPrincipal& ep,
+                        ModuleContext const& mc,
+                        WaitingTaskHolder holder)
+  {
+    if constexpr (std::is_base_of_v<detail::Producer, T>) {
+      module_->doAcquire(ep, mc, std::move(holder));
+    }
+  }
+
+  template <typename T>
+  detail::EventBatcher*
+  WorkerT<T>::doEventBatcher() const
+  {
+    if constexpr (std::is_base_of_v<detail::BatchModule, T>) {
+      return module_->eventBatcher();
+    } else {
+      return nullptr;
+    }
+  }
+
+  template <typename T>
+  std::vector<bool>
+  WorkerT<T>::doProcessBatch(std::vector<detail::BatchEntry> const& batch)
+  {
+    // All entries refer to workers of this module, one per schedule.
+    std::vector<bool> result;
+    if constexpr (std::is_base_of_v<detail::BatchModule, T>) {
+      std::vector<detail::EventInBatch> events;
+      events.reserve(batch.size());
+      for (auto const& [worker, p, mc] : batch) {
+        auto& counts = static_cast<WorkerT&>(*worker).counts_;
+        events.push_back(
+          {*p, *mc, counts.run, counts.passed, counts.failed});
+      }
+      result = module_->doEventBatch(events);
+    } else {
+      for (auto const& [worker, p, mc] : batch) {
+        result.push_back(static_cast<WorkerT&>(*worker).doProcess(*p, *mc));
+      }
+    }
+    return result;
   }
 
 } // namespace art
@@ -0,0 +1,58 @@
+#ifndef art_Framework_Core_detail_BatchModule_h
+#define art_Framework_Core_detail_BatchModule_h
+// vim: set sw=2 expandtab :
+
+// ======================================================================
+// BatchModule: the base class of modules that process the events of
+// several schedules in a single call (see BatchFilter and
+// BatchAnalyzer).
+// ======================================================================
+
+#include "art/Framework/Principal/detail/EventBatcher.h"
+#include "art/Framework/Principal/fwd.h"
+#include "art/Persistency/Provenance/fwd.h"
+
+#include <atomic>
+#include <cstddef>
+
+namespace art::detail {
+
+  // An event of a batch, with the execution counters of the worker of
+  // its schedule.
+  struct EventInBatch {
+    EventPrincipal& principal;
+    ModuleContext const& context;
+    std::atomic<std::size_t>& counts_run;
+    std::atomic<std::size_t>& counts_passed;
+    std::atomic<std::size_t>& counts_failed;
+  };
+
+  class BatchModule {
+  public:
+    EventBatcher*
+    eventBatcher() noexcept
+    {
+      return &batcher_;
+    }
+
+  protected:
+    // Limit the number of events processed in one call.  By default,
+    // a batch includes every event waiting for the module, which is
+    // at most one per schedule.
+    void
+    maxBatchSize(std::size_t const n) noexcept
+    {
+      batcher_.setMaxSize(n);
+    }
+
+  private:
+    EventBatcher batcher_{};
+  };
+
+} // namespace art::detail
+
+#endif /* art_Framework_Core_detail_BatchModule_h */
+
+// Local Variables:
+// mode: c++
+// End:
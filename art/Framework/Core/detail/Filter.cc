@@ -119,7 +119,7 @@ namespace art::detail {
     ++counts_run;
     ProcessingFrame const frame{mc.scheduleID()};
     bool const rc = filterWithFrame(e, frame);
-    e.commitProducts(checkPutProducts_, &expectedProducts<InEvent>());
+    commitEventProducts(e);
     if (rc) {
       ++counts_passed;
     } else {
@@ -128,4 +128,10 @@ namespace art::detail {
     return rc;
   }
 
+  void
+  Filter::commitEventProducts(Event& e)
+  {
+    e.commitProducts(checkPutProducts_, &expectedProducts<InEvent>());
+  }
+
 } // namespace art::detail
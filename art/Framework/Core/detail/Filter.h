@@ -54,6 +54,10 @@ namespace art::detail {
                  std::atomic<std::size_t>& counts_passed,
                  std::atomic<std::size_t>& counts_failed);
 
+  protected:
+    // For filters that create their events themselves.
+    void commitEventProducts(Event& e);
+
   private:
     virtual void setupQueues(SharedResources const&) = 0;
     virtual void beginJobWithFrame(ProcessingFrame const&) = 0;
@@ -9,6 +9,9 @@
 #include "art/Framework/Principal/SubRunPrincipal.h"
 #include "art/Persistency/Provenance/ModuleContext.h"
 #include "art/Utilities/ScheduleID.h"
+#include "canvas/Utilities/Exception.h"
+
+#include <utility>
 
 namespace art::detail {
 
@@ -21,6 +24,12 @@ namespace art::detail {
   void
   Producer::doBeginJob(SharedResources const& resources)
   {
+    if (externalWorkDeclared_ && !externalWorkSupported()) {
+      throw Exception{errors::Configuration}
+        << "The module " << moduleDescription().moduleLabel()
+        << " has called externalWork<art::InEvent>(), which is supported only "
+           "for shared and replicated producers.\n";
+    }
     setupQueues(resources);
     ProcessingFrame const frame{ScheduleID{}};
     beginJobWithFrame(frame);
@@ -117,4 +126,37 @@ namespace art::detail {
     return true;
   }
 
+  bool
+  Producer::hasAcquire() const noexcept
+  {
+    return externalWorkDeclared_;
+  }
+
+  void
+  Producer::doAcquire(EventPrincipal& ep,
+                      ModuleContext const& mc,
+                      WaitingTaskHolder holder)
+  {
+    auto const e = std::as_const(ep).makeEvent(mc);
+    ProcessingFrame const frame{mc.scheduleID()};
+    acquireWithFrame(e, frame, std::move(holder));
+  }
+
+  bool
+  Producer::externalWorkSupported() const noexcept
+  {
+    return false;
+  }
+
+  void
+  Producer::acquireWithFrame(Event const&,
+                             ProcessingFrame const&,
+                             WaitingTaskHolder)
+  {
+    // Rejected by doBeginJob.
+    throw Exception{errors::LogicError}
+      << "The module " << moduleDescription().moduleLabel()
+      << " does not support external work.\n";
+  }
+
 } // namespace art::detail
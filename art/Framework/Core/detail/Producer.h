@@ -14,6 +14,8 @@
 #include "art/Framework/Principal/fwd.h"
 #include "art/Persistency/Provenance/fwd.h"
 #include "art/Utilities/ScheduleID.h"
+#include "art/Utilities/WaitingTaskHolder.h"
+#include "canvas/Persistency/Provenance/BranchType.h"
 
 #include <cstddef>
 
@@ -48,6 +50,25 @@ namespace art::detail {
                  std::atomic<std::size_t>& counts_run,
                  std::atomic<std::size_t>& counts_passed,
                  std::atomic<std::size_t>& counts_failed);
+    bool hasAcquire() const noexcept;
+    void doAcquire(EventPrincipal& ep,
+                   ModuleContext const& mc,
+                   WaitingTaskHolder holder);
+
+  protected:
+    // Declares that the module's acquire function is to be called for
+    // each event before its produce function.  The produce function
+    // is not called until the WaitingTaskHolder handed to acquire has
+    // signaled that the external work is done.
+    template <BranchType BT = InEvent>
+    void
+    externalWork()
+    {
+      static_assert(
+        BT == InEvent,
+        "externalWork is currently supported only for the 'InEvent' level.");
+      externalWorkDeclared_ = true;
+    }
 
   private:
     virtual void setupQueues(SharedResources const&) = 0;
@@ -66,8 +87,14 @@ namespace art::detail {
     virtual void beginSubRunWithFrame(SubRun&, ProcessingFrame const&) = 0;
     virtual void endSubRunWithFrame(SubRun&, ProcessingFrame const&) = 0;
     virtual void produceWithFrame(Event&, ProcessingFrame const&) = 0;
+    virtual void acquireWithFrame(Event const&,
+                                  ProcessingFrame const&,
+                                  WaitingTaskHolder);
+    // Only shared and replicated producers may declare external work.
+    virtual bool externalWorkSupported() const noexcept;
 
     bool const checkPutProducts_;
+    bool externalWorkDeclared_{false};
   };
 
 } // namespace art::detail
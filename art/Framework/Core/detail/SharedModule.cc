@@ -7,8 +7,6 @@
 #include <string>
 #include <vector>
 
-using namespace hep::concurrency;
-
 namespace art::detail {
 
   SharedModule::SharedModule() = default;
@@ -18,10 +16,10 @@ namespace art::detail {
     : moduleLabel_{moduleLabel}
   {}
 
-  SerialTaskQueueChain*
-  SharedModule::serialTaskQueueChain() const
+  ResourceQueue*
+  SharedModule::resourceQueue() const
   {
-    return chain_.get();
+    return queue_.get();
   }
 
   std::set<std::string> const&
@@ -52,8 +50,7 @@ namespace art::detail {
     }
     std::vector<std::string> const names(cbegin(resourceNames_),
                                          cend(resourceNames_));
-    auto queues = resources.createQueues(names);
-    chain_ = std::make_unique<SerialTaskQueueChain>(queues);
+    queue_ = resources.createQueue(names);
   }
 
   void
@@ -2,9 +2,9 @@
 #define art_Framework_Core_detail_SharedModule_h
 // vim: set sw=2 expandtab :
 
+#include "art/Utilities/ResourceQueue.h"
 #include "art/Utilities/SharedResource.h"
 #include "canvas/Persistency/Provenance/BranchType.h"
-#include "hep_concurrency/SerialTaskQueueChain.h"
 
 #include <memory>
 #include <set>
@@ -21,7 +21,7 @@ namespace art::detail {
 
     explicit SharedModule(std::string const& moduleLabel);
 
-    hep::concurrency::SerialTaskQueueChain* serialTaskQueueChain() const;
+    ResourceQueue* resourceQueue() const;
     std::set<std::string> const& sharedResources() const;
 
     void createQueues(SharedResources const& resources);
@@ -75,7 +75,7 @@ namespace art::detail {
     std::string moduleLabel_{};
     std::set<std::string> resourceNames_{};
     bool asyncDeclared_{false};
-    std::unique_ptr<hep::concurrency::SerialTaskQueueChain> chain_{nullptr};
+    std::unique_ptr<ResourceQueue> queue_{nullptr};
   };
 
   template <BranchType, typename... T>
@@ -6,6 +6,8 @@
 #include "fhiclcpp/ParameterSet.h"
 
 namespace art {
+  class BatchAnalyzer;
+  class BatchFilter;
   class EDAnalyzer;
   class EDFilter;
   class EDProducer;
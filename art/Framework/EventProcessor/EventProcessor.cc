@@ -13,6 +13,7 @@
 #include "art/Framework/Principal/ConsumesInfo.h"
 #include "art/Framework/Principal/Event.h"
 #include "art/Framework/Principal/EventPrincipal.h"
+#include "art/Framework/Principal/OpenRangeSetHandler.h"
 #include "art/Framework/Principal/RangeSetHandler.h"
 #include "art/Framework/Principal/Run.h"
 #include "art/Framework/Principal/RunPrincipal.h"
@@ -22,6 +23,7 @@
 #include "art/Framework/Services/Registry/ServiceHandle.h"
 #include "art/Framework/Services/Registry/ServiceRegistry.h"
 #include "art/Framework/Services/Registry/ServicesManager.h"
+#include "art/Framework/Services/System/DatabaseConnection.h"
 #include "art/Framework/Services/System/FileCatalogMetadata.h"
 #include "art/Framework/Services/System/FloatingPointControl.h"
 #include "art/Framework/Services/System/TriggerNamesService.h"
@@ -125,6 +127,15 @@ namespace art {
     // in their constructors, instead they must use the beginJob
     // callout.
     taskGroup_ = scheduler_->global_task_group();
+    if (scheduler_->num_workers() > 1) {
+      forkCoordinator_ = std::make_unique<ForkCoordinator>(
+        scheduler_->num_workers(), scheduler_->events_per_worker_claim());
+    }
+    if (scheduler_->ordered_output() && scheduler_->num_schedules() > 1) {
+      reorderBuffer_ =
+        std::make_unique<EventReorderBuffer>(scheduler_->reorder_window());
+      outputTickets_.resize(scheduler_->num_schedules());
+    }
     // Whenever we are ready to enable ROOT's implicit MT, which is
     // equivalent to its use of TBB, the call should be made after our
     // own TBB task manager has been initialized.
@@ -135,6 +146,19 @@ namespace art {
     auto const errorOnMissingConsumes = scheduler_->errorOnMissingConsumes();
     ConsumesInfo::instance()->setRequireConsumes(errorOnMissingConsumes);
 
+    // Provenance is recorded for the output modules, unless the job
+    // explicitly asks for it.
+    auto const hasOutputModules = pathManager_->hasOutputModules();
+    auto const recordProvenance =
+      scheduler_->record_provenance().value_or(hasOutputModules);
+    if (hasOutputModules && !recordProvenance) {
+      throw Exception{errors::Configuration}
+        << "The parameter services.scheduler.record_provenance cannot be "
+           "false\n"
+        << "for a job with output modules.\n";
+    }
+    Globals::instance()->setRecordProvenance(recordProvenance);
+
     auto const& processName = Globals::instance()->processName();
 
     // Trigger-names
@@ -178,7 +202,8 @@ namespace art {
                                                 outputCallbacks_,
                                                 *taskGroup_));
     }
-    sharedResources_.freeze(taskGroup_->native_group());
+    sharedResources_.freeze(taskGroup_->native_group(),
+                            scheduler_->serialized_batch_size());
 
     FDEBUG(2) << pset.to_string() << endl;
     // The input source must be created after the end path executor
@@ -633,14 +658,26 @@ namespace art {
   //=============================================
   // Run level
 
+  unique_ptr<RangeSetHandler>
+  EventProcessor::rangeSetHandler_(unique_ptr<RangeSetHandler> rsh) const
+  {
+    assert(rsh);
+    if (forkCoordinator_ &&
+        rsh->type() == RangeSetHandler::HandlerType::Closed) {
+      // The ranges of a worker must cover only the events it
+      // processed, not those of the input that it skipped.
+      return make_unique<OpenRangeSetHandler>(rsh->seenRanges().run());
+    }
+    return rsh;
+  }
+
   void
   EventProcessor::readRun()
   {
     actReg_.sPreSourceRun.invoke();
     runPrincipal_.reset(input_->readRun().release());
     assert(runPrincipal_);
-    auto rsh = input_->runRangeSetHandler();
-    assert(rsh);
+    auto rsh = rangeSetHandler_(input_->runRangeSetHandler());
     auto seed_range_set = [this, &rsh](ScheduleID const sid) {
       schedule(sid).seedRunRangeSet(*rsh);
     };
@@ -811,8 +848,7 @@ namespace art {
     actReg_.sPreSourceSubRun.invoke();
     subRunPrincipal_.reset(input_->readSubRun(runPrincipal_.get()).release());
     assert(subRunPrincipal_);
-    auto rsh = input_->subRunRangeSetHandler();
-    assert(rsh);
+    auto rsh = rangeSetHandler_(input_->subRunRangeSetHandler());
     auto seed_range_set = [this, &rsh](ScheduleID const sid) {
       schedule(sid).seedSubRunRangeSet(*rsh);
     };
@@ -1048,6 +1084,9 @@ namespace art {
     while (!done) {
       beginRunIfNotDoneAlready();
       beginSubRunIfNotDoneAlready();
+      if (reorderBuffer_) {
+        reorderBuffer_->reset();
+      }
 
       auto const last_schedule_index = scheduler_->num_schedules() - 1;
       for (ScheduleID::size_type i = 0; i != last_schedule_index; ++i) {
@@ -1101,6 +1140,37 @@ namespace art {
     TDEBUG_END_FUNC_SI(4, sid);
   }
 
+  // With ordered output: gives back the slot reserved in the reorder
+  // window, unless an event was read into it, and resumes the
+  // schedules that were waiting for a slot.
+  class EventProcessor::ReorderSlotSentry {
+  public:
+    explicit ReorderSlotSentry(EventProcessor* evp) : evp_{evp} {}
+    ReorderSlotSentry(ReorderSlotSentry const&) = delete;
+    ReorderSlotSentry& operator=(ReorderSlotSentry const&) = delete;
+
+    ~ReorderSlotSentry()
+    {
+      if (used_ || !evp_->reorderBuffer_) {
+        return;
+      }
+      for (auto const reader : evp_->reorderBuffer_->cancelRead()) {
+        evp_->taskGroup_->run(
+          [evp = evp_, reader] { evp->processAllEventsAsync(reader); });
+      }
+    }
+
+    void
+    use() noexcept
+    {
+      used_ = true;
+    }
+
+  private:
+    EventProcessor* evp_;
+    bool used_{false};
+  };
+
   // This function is executed as part of the readAndProcessEvent
   // task, our parent task is the EventLoopTask. Here we advance to
   // the next item in the file index, end event processing if it is
@@ -1120,10 +1190,53 @@ namespace art {
       TDEBUG_END_FUNC_SI(4, sid) << "CLEAN SHUTDOWN";
       return;
     }
+    if (reorderBuffer_ && !reorderBuffer_->mayRead(sid)) {
+      // Too many events are waiting to be written; we are resumed
+      // once the oldest of them has been.
+      TDEBUG_END_FUNC_SI(4, sid) << "REORDER WINDOW FULL";
+      return;
+    }
+    ReorderSlotSentry reorderSlot{this};
+
+    // Sources that create events without I/O may grant claims on the
+    // events of the current subrun, which are then read without the
+    // input source lock.  Once no claim is granted, we fall back to
+    // the serial protocol below, which notices the end of the subrun.
+    // Claims are not offered to worker processes, which must all see
+    // the events in the same order, nor with ordered output, which
+    // relies on the order of the reads.
+    if (!forkCoordinator_ && !reorderBuffer_ &&
+        !fileSwitchInProgress_.load() && !schedule(sid).outputsToClose()) {
+      if (auto const claim = input_->claimEvent()) {
+        ScheduleContext const sc{sid};
+        actReg_.sPreSourceEvent.invoke(sc);
+        TDEBUG_FUNC_SI(5, sid) << "Calling input_->readClaimedEvent()";
+        auto ep = input_->readClaimedEvent(claim, subRunPrincipal_.get());
+        assert(ep);
+        ep->createGroupsForProducedProducts(producedProductLookupTables_);
+        {
+          // Producing services are not required to be thread-safe.
+          InputSourceMutexSentry lock_input;
+          psSignals_->sPostReadEvent.invoke(*ep);
+        }
+        ep->enableLookupOfProducedProducts();
+        if (!actReg_.sPostSourceEvent.empty()) {
+          actReg_.sPostSourceEvent.invoke(
+            std::as_const(*ep).makeEvent(invalid_module_context), sc);
+        }
+        FDEBUG(1) << string(8, ' ') << "readClaimedEvent............("
+                  << ep->eventID() << ")\n";
+        schedule(sid).accept_principal(std::move(ep));
+        processEventAsync(sid);
+        TDEBUG_END_FUNC_SI(4, sid);
+        return;
+      }
+    }
 
     // The item type advance and the event read must be done with the
     // input source lock held; however event-processing must not
     // serialized.
+    bool skipEvent{false};
     {
       InputSourceMutexSentry lock_input;
       if (fileSwitchInProgress_.load()) {
@@ -1154,7 +1267,10 @@ namespace art {
         if (nextLevel_.load() == Level::ReadyToAdvance) {
           // See what the next item is.
           TDEBUG_FUNC_SI(5, sid) << "Calling advanceItemType()";
+          ScheduleContext const sc{sid};
+          actReg_.sPreSourceAdvance.invoke(sc);
           nextLevel_ = advanceItemType();
+          actReg_.sPostSourceAdvance.invoke(sc);
         }
         if ((nextLevel_.load() < most_deeply_nested_level()) ||
             (nextLevel_.load() == highest_level())) {
@@ -1179,30 +1295,51 @@ namespace art {
         }
       }
 
-      // Now we can read the event from the source.
-      ScheduleContext const sc{sid};
-      assert(subRunPrincipal_);
-      assert(subRunPrincipal_->subRunID().isValid());
-      actReg_.sPreSourceEvent.invoke(sc);
-      TDEBUG_FUNC_SI(5, sid) << "Calling input_->readEvent(subRunPrincipal_)";
-      auto ep = input_->readEvent(subRunPrincipal_.get());
-      assert(ep);
-      // The intended behavior here is that the producing services
-      // which are called during the sPostReadEvent cannot see each
-      // others put products.  We enforce this by creating the groups
-      // for the produced products, but do not allow the lookups to
-      // find them until after the callbacks have run.
-      ep->createGroupsForProducedProducts(producedProductLookupTables_);
-      psSignals_->sPostReadEvent.invoke(*ep);
-      ep->enableLookupOfProducedProducts();
-      actReg_.sPostSourceEvent.invoke(
-        std::as_const(*ep).makeEvent(invalid_module_context), sc);
-      FDEBUG(1) << string(8, ' ') << "readEvent...................("
-                << ep->eventID() << ")\n";
-      schedule(sid).accept_principal(std::move(ep));
+      // With worker processes, the input source only advances past
+      // the events processed by another worker.
+      if (forkCoordinator_ && !forkCoordinator_->claim(eventsRead_++)) {
+        TDEBUG_FUNC_SI(5, sid) << "Skipping event claimed by another worker";
+        input_->discardEvent(subRunPrincipal_.get());
+        skipEvent = true;
+      } else {
+        // Now we can read the event from the source.
+        ScheduleContext const sc{sid};
+        assert(subRunPrincipal_);
+        assert(subRunPrincipal_->subRunID().isValid());
+        actReg_.sPreSourceEvent.invoke(sc);
+        TDEBUG_FUNC_SI(5, sid) << "Calling input_->readEvent(subRunPrincipal_)";
+        auto ep = input_->readEvent(subRunPrincipal_.get());
+        assert(ep);
+        // The intended behavior here is that the producing services
+        // which are called during the sPostReadEvent cannot see each
+        // others put products.  We enforce this by creating the groups
+        // for the produced products, but do not allow the lookups to
+        // find them until after the callbacks have run.
+        ep->createGroupsForProducedProducts(producedProductLookupTables_);
+        psSignals_->sPostReadEvent.invoke(*ep);
+        ep->enableLookupOfProducedProducts();
+        if (!actReg_.sPostSourceEvent.empty()) {
+          actReg_.sPostSourceEvent.invoke(
+            std::as_const(*ep).makeEvent(invalid_module_context), sc);
+        }
+        FDEBUG(1) << string(8, ' ') << "readEvent...................("
+                  << ep->eventID() << ")\n";
+        if (reorderBuffer_ && !ep->eventID().isFlush()) {
+          outputTickets_[sid.id()] = reorderBuffer_->issue();
+          reorderSlot.use();
+        }
+        schedule(sid).accept_principal(std::move(ep));
+      }
       // Now we drop the input source lock by exiting the guarded
       // scope.
     }
+    if (skipEvent) {
+      // Long stretches of skipped events must not nest, so the next
+      // event is handled by a new task.
+      taskGroup_->run([this, sid] { processAllEventsAsync(sid); });
+      TDEBUG_END_FUNC_SI(4, sid) << "EVENT OF ANOTHER WORKER";
+      return;
+    }
     if (schedule(sid).event_principal().eventID().isFlush()) {
       // No processing to do, start next event handling task.
       processAllEventsAsync(sid);
@@ -1289,6 +1426,7 @@ namespace art {
               mf::LogWarning(e.category())
                 << "Skipping event due to the following exception:\n"
                 << cet::trim_right_copy(e.what(), " \n");
+              evp_->dropEventFromOutput_(sid_);
               TDEBUG_END_TASK_SI(4, sid_)
                 << "skipping event because of EXCEPTION";
               return;
@@ -1399,6 +1537,7 @@ namespace art {
     mf::LogWarning(e.category())
       << "exception being ignored for current event:\n"
       << cet::trim_right_copy(e.what(), " \n");
+    dropEventFromOutput_(sid);
     TDEBUG_END_FUNC_SI(4, sid) << "Ignoring exception.";
   }
   catch (...) {
@@ -1412,14 +1551,42 @@ namespace art {
   EventProcessor::finishEventAsync(ScheduleID const sid)
   {
     auto& ep = schedule(sid).event_principal();
-    actReg_.sPostProcessEvent.invoke(
-      std::as_const(ep).makeEvent(invalid_module_context),
-      ScheduleContext{sid});
+    if (!actReg_.sPostProcessEvent.empty()) {
+      actReg_.sPostProcessEvent.invoke(
+        std::as_const(ep).makeEvent(invalid_module_context),
+        ScheduleContext{sid});
+    }
 
     // Note: We are part of the endPathTask.
     TDEBUG_BEGIN_FUNC_SI(4, sid);
     FDEBUG(1) << string(8, ' ') << "processEvent................("
               << ep.eventID() << ")\n";
+    if (reorderBuffer_) {
+      if (reorderBuffer_->mayFinish(outputTickets_[sid.id()], sid, true)) {
+        finishEventsInOrder_(sid, true);
+      }
+      // Otherwise the event is written, and the next one read, once
+      // the events read before it have been written.
+      TDEBUG_END_FUNC_SI(4, sid);
+      return;
+    }
+    if (!writeEvent_(sid)) {
+      // And then end this task, terminating event processing.
+      TDEBUG_END_FUNC_SI(4, sid) << "EXCEPTION";
+      return;
+    }
+
+    // The next event processing task is a continuation of this task.
+    processAllEventsAsync(sid);
+    TDEBUG_END_FUNC_SI(4, sid);
+  }
+
+  // Write the event of the given schedule.  Returns false if event
+  // processing is to be terminated.
+  bool
+  EventProcessor::writeEvent_(ScheduleID const sid)
+  {
+    auto& ep = schedule(sid).event_principal();
     try {
       // Ask the output workers if they have reached their limits, and
       // if so setup to end the job the next time around the event
@@ -1454,9 +1621,7 @@ namespace art {
           "EventProcessor: an exception occurred "
           "during current event processing",
           e);
-        // And then end this task, terminating event processing.
-        TDEBUG_END_FUNC_SI(4, sid) << "EXCEPTION";
-        return;
+        return false;
       }
       mf::LogWarning(e.category())
         << "exception being ignored for current event:\n"
@@ -1467,14 +1632,54 @@ namespace art {
       mf::LogError("PassingThrough")
         << "an exception occurred during current event processing";
       sharedException_.store_current();
-      // And then end this task, terminating event processing.
-      TDEBUG_END_FUNC_SI(4, sid) << "EXCEPTION";
-      return;
+      return false;
     }
+    return true;
+  }
 
-    // The next event processing task is a continuation of this task.
-    processAllEventsAsync(sid);
-    TDEBUG_END_FUNC_SI(4, sid);
+  // With ordered output: finish the event of the given schedule,
+  // which is next in order, and then the held events that follow it.
+  // Each schedule whose event has been written moves on to its next
+  // event; that of the given schedule does so as a continuation of
+  // this task.
+  void
+  EventProcessor::finishEventsInOrder_(ScheduleID const sid, bool const write)
+  {
+    bool continueSelf{false};
+    EventReorderBuffer::Held current{sid, outputTickets_[sid.id()], write};
+    while (true) {
+      bool const proceed = current.write && writeEvent_(current.sid);
+      auto released = reorderBuffer_->release(current.ticket);
+      for (auto const reader : released.readers) {
+        taskGroup_->run([this, reader] { processAllEventsAsync(reader); });
+      }
+      if (proceed) {
+        if (current.sid == sid) {
+          continueSelf = true;
+        } else {
+          taskGroup_->run(
+            [this, next = current.sid] { processAllEventsAsync(next); });
+        }
+      }
+      if (!released.next) {
+        break;
+      }
+      current = *released.next;
+    }
+    if (continueSelf) {
+      processAllEventsAsync(sid);
+    }
+  }
+
+  // With ordered output: the event of the given schedule is skipped,
+  // but the events after it must not wait for it.
+  void
+  EventProcessor::dropEventFromOutput_(ScheduleID const sid)
+  {
+    if (reorderBuffer_ &&
+        reorderBuffer_->mayFinish(outputTickets_[sid.id()], sid, false)) {
+      finishEventsInOrder_(sid, false);
+    }
   }
 
   template <Level L>
@@ -1512,6 +1717,32 @@ namespace art {
     return returnCode;
   }
 
+  std::optional<int>
+  EventProcessor::forkWorkers()
+  {
+    if (!forkCoordinator_) {
+      return std::nullopt;
+    }
+    // The workers would share the connections, and write to the same
+    // database files concurrently.
+    if (auto const files = ServiceHandle<DatabaseConnection const>{}->files();
+        !files.empty()) {
+      Exception e{errors::Configuration};
+      e << "The job cannot be run with --fork: the following database "
+           "file(s) were opened
+"
+           "during initialization, and would be shared by the worker "
+           "processes:
+";
+      for (auto const& file : files) {
+        e << "  " << file << '\n';
+      }
+      e << "Use in-memory databases (an empty file name) instead.\n";
+      throw e;
+    }
+    return forkCoordinator_->forkWorkers();
+  }
+
   Level
   EventProcessor::advanceItemType()
   {
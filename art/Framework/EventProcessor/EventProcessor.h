@@ -16,6 +16,8 @@
 #include "art/Framework/Core/UpdateOutputCallbacks.h"
 #include "art/Framework/Core/detail/EnabledModules.h"
 #include "art/Framework/Core/fwd.h"
+#include "art/Framework/EventProcessor/EventReorderBuffer.h"
+#include "art/Framework/EventProcessor/ForkCoordinator.h"
 #include "art/Framework/EventProcessor/Scheduler.h"
 #include "art/Framework/EventProcessor/detail/ExceptionCollector.h"
 #include "art/Framework/Principal/Actions.h"
@@ -36,7 +38,9 @@
 #include "hep_concurrency/thread_sanitize.h"
 
 #include <atomic>
+#include <cstdint>
 #include <memory>
+#include <optional>
 
 namespace art {
 
@@ -73,15 +77,26 @@ namespace art {
     //
     StatusCode runToCompletion();
 
+    //  If configured with more than one worker process (see
+    //  ForkCoordinator), fork the workers.  Returns std::nullopt in
+    //  the workers, which are then to call runToCompletion.  In the
+    //  parent, returns the combined exit status of the workers.
+    //  Without worker processes, returns std::nullopt.
+    std::optional<int> forkWorkers();
+
   private:
     class EndPathTask;
     class EndPathRunnerTask;
+    class ReorderSlotSentry;
 
     // Event-loop infrastructure
     void processAllEventsAsync(ScheduleID sid);
     void readAndProcessAsync(ScheduleID sid);
     void processEventAsync(ScheduleID sid);
     void finishEventAsync(ScheduleID sid);
+    bool writeEvent_(ScheduleID sid);
+    void finishEventsInOrder_(ScheduleID sid, bool write);
+    void dropEventFromOutput_(ScheduleID sid);
 
     template <Level L>
     bool levelsToProcess();
@@ -116,6 +131,8 @@ namespace art {
     void respondToCloseInputFile();
     void respondToOpenOutputFiles();
     void respondToCloseOutputFiles();
+    std::unique_ptr<RangeSetHandler> rangeSetHandler_(
+      std::unique_ptr<RangeSetHandler> rsh) const;
     void readRun();
     void beginRun();
     void beginRunIfNotDoneAlready();
@@ -264,6 +281,19 @@ namespace art {
 
     // Are we current switching output files?
     std::atomic<bool> fileSwitchInProgress_{false};
+
+    // Present when the event loop is shared among worker processes.
+    std::unique_ptr<ForkCoordinator> forkCoordinator_{nullptr};
+
+    // The number of events read so far, which is the index of the
+    // next event in the input sequence.  Only used with worker
+    // processes, and protected by the input source lock.
+    std::uint64_t eventsRead_{};
+
+    // Present when events are to be written in input order, together
+    // with the ticket of the event held by each schedule.
+    std::unique_ptr<EventReorderBuffer> reorderBuffer_{nullptr};
+    std::vector<std::uint64_t> outputTickets_{};
   };
 
 } // namespace art
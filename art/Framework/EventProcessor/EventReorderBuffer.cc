@@ -0,0 +1,106 @@
+#include "art/Framework/EventProcessor/EventReorderBuffer.h"
+// vim: set sw=2 expandtab :
+
+#include <cassert>
+
+using namespace std;
+
+namespace art {
+
+  EventReorderBuffer::EventReorderBuffer(unsigned const window)
+    : window_{window}
+  {}
+
+  void
+  EventReorderBuffer::reset()
+  {
+    lock_guard sentry{mutex_};
+    assert(issued_ == finished_);
+    assert(held_.empty());
+    assert(reserved_ == 0);
+    waitingReaders_.clear();
+  }
+
+  bool
+  EventReorderBuffer::mayRead(ScheduleID const sid)
+  {
+    if (window_ == 0) {
+      return true;
+    }
+    lock_guard sentry{mutex_};
+    if (reserved_ < window_) {
+      ++reserved_;
+      return true;
+    }
+    waitingReaders_.push_back(sid);
+    return false;
+  }
+
+  vector<ScheduleID>
+  EventReorderBuffer::cancelRead()
+  {
+    vector<ScheduleID> result;
+    if (window_ == 0) {
+      return result;
+    }
+    lock_guard sentry{mutex_};
+    assert(reserved_ != 0);
+    --reserved_;
+    wakeReaders_(result);
+    return result;
+  }
+
+  uint64_t
+  EventReorderBuffer::issue()
+  {
+    lock_guard sentry{mutex_};
+    return issued_++;
+  }
+
+  bool
+  EventReorderBuffer::mayFinish(uint64_t const ticket,
+                                ScheduleID const sid,
+                                bool const write)
+  {
+    lock_guard sentry{mutex_};
+    if (ticket == finished_) {
+      return true;
+    }
+    assert(ticket > finished_);
+    held_.emplace(ticket, Held{sid, ticket, write});
+    return false;
+  }
+
+  EventReorderBuffer::Released
+  EventReorderBuffer::release(uint64_t const ticket)
+  {
+    Released result;
+    lock_guard sentry{mutex_};
+    assert(ticket == finished_);
+    finished_ = ticket + 1;
+    if (auto it = held_.find(finished_); it != held_.end()) {
+      result.next = it->second;
+      held_.erase(it);
+    }
+    if (window_ != 0) {
+      assert(reserved_ != 0);
+      --reserved_;
+      wakeReaders_(result.readers);
+    }
+    return result;
+  }
+
+  void
+  EventReorderBuffer::wakeReaders_(vector<ScheduleID>& readers)
+  {
+    // A woken reader reserves its slot when it asks again, and is
+    // held once more if others took the free slots first.
+    auto slots = window_ - reserved_;
+    while (slots != 0 && !waitingReaders_.empty()) {
+      readers.push_back(waitingReaders_.back());
+      waitingReaders_.pop_back();
+      --slots;
+    }
+  }
+
+} // namespace art
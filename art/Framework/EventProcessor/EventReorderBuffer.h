@@ -0,0 +1,103 @@
+#ifndef art_Framework_EventProcessor_EventReorderBuffer_h
+#define art_Framework_EventProcessor_EventReorderBuffer_h
+// vim: set sw=2 expandtab :
+
+// ======================================================================
+// EventReorderBuffer: hands the events of a multi-schedule job to the
+// output modules in the order in which they were read, so that the
+// output files do not depend on the number of threads or schedules.
+//
+// Each event read receives a ticket; an event whose processing is
+// finished before that of its predecessors is held back, together
+// with its schedule, until the events with lower tickets have been
+// written.  Held-back events therefore occupy no memory beyond the
+// event principals of their schedules.
+//
+// Optionally, the number of events in flight (read but not yet
+// written) is bounded by a window: a schedule that would exceed it
+// waits before reading its next event.  A schedule reserves its slot
+// in the window before it reads, so schedules reading at the same
+// time cannot exceed the window together.  A smaller window makes
+// the schedules spend less time holding finished events, at the cost
+// of less concurrency.
+// ======================================================================
+
+#include "art/Utilities/ScheduleID.h"
+
+#include <cstdint>
+#include <map>
+#include <mutex>
+#include <optional>
+#include <vector>
+
+namespace art {
+
+  class EventReorderBuffer {
+  public:
+    // A window of zero does not limit the number of events in flight
+    // beyond the number of schedules.
+    explicit EventReorderBuffer(unsigned window);
+
+    struct Held {
+      ScheduleID sid;
+      std::uint64_t ticket;
+      bool write;
+    };
+
+    struct Released {
+      // The held event which is next in order, if any.
+      std::optional<Held> next{};
+      // Schedules which may now read their next event.
+      std::vector<ScheduleID> readers{};
+    };
+
+    // Forget waiting schedules at the start of an event loop, when no
+    // events may be in flight.
+    void reset();
+
+    // Whether the schedule may read its next event.  If so, a slot in
+    // the window is reserved for that event, which must then be
+    // issued a ticket, or the slot given back with cancelRead.  If
+    // not, the schedule is held until a later release or cancelRead
+    // returns it.
+    bool mayRead(ScheduleID sid);
+
+    // Give back the slot reserved by mayRead, when no event was read
+    // into it.  Returns the schedules which may now read.
+    std::vector<ScheduleID> cancelRead();
+
+    // The ticket for the event just read, which takes the slot
+    // reserved by mayRead.  Must be called in input order, with the
+    // input source lock held.
+    std::uint64_t issue();
+
+    // Whether the event with the given ticket is next in order.  If
+    // not, it is held (to be written or, if 'write' is false, only
+    // dropped) until the release of its predecessor returns it.
+    bool mayFinish(std::uint64_t ticket, ScheduleID sid, bool write);
+
+    // Record that the event with the given ticket, which was next in
+    // order, has been finished.
+    Released release(std::uint64_t ticket);
+
+  private:
+    void wakeReaders_(std::vector<ScheduleID>& readers);
+
+    unsigned const window_;
+    std::mutex mutex_{};
+    std::uint64_t issued_{};
+    std::uint64_t finished_{};
+    // Slots of the window reserved by readers, or taken by events not
+    // yet finished.  Only counted when the window is bounded.
+    unsigned reserved_{};
+    std::map<std::uint64_t, Held> held_{};
+    std::vector<ScheduleID> waitingReaders_{};
+  };
+
+} // namespace art
+
+#endif /* art_Framework_EventProcessor_EventReorderBuffer_h */
+
+// Local Variables:
+// mode: c++
+// End:
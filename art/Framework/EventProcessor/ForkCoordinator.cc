@@ -0,0 +1,178 @@
+#include "art/Framework/EventProcessor/ForkCoordinator.h"
+// vim: set sw=2 expandtab :
+
+#include "art/Utilities/Globals.h"
+#include "canvas/Utilities/Exception.h"
+#include "messagefacility/MessageLogger/MessageLogger.h"
+
+#include <signal.h>
+#include <sys/mman.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+#include <cerrno>
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+#include <iostream>
+#include <new>
+
+using namespace std;
+
+namespace {
+  using counter_t = std::atomic<std::uint64_t>;
+  static_assert(counter_t::is_always_lock_free,
+                "Claims across processes require a lock-free counter.");
+
+  // The number of threads of this process, or zero if unknown.
+  std::size_t
+  thread_count()
+  {
+#ifdef __linux__
+    std::error_code ec;
+    std::filesystem::directory_iterator const tasks{"/proc/self/task", ec};
+    if (!ec) {
+      return std::distance(begin(tasks), end(tasks));
+    }
+#endif
+    return 0;
+  }
+}
+
+namespace art {
+
+  ForkCoordinator::ForkCoordinator(unsigned const nWorkers,
+                                   unsigned const eventsPerClaim)
+    : nWorkers_{nWorkers}
+    , eventsPerClaim_{eventsPerClaim}
+    , sharedLength_{sizeof(counter_t) * (1 + nWorkers)}
+  {
+    if (nWorkers_ == 0 || eventsPerClaim_ == 0) {
+      throw Exception(errors::Configuration)
+        << "ForkCoordinator: the number of workers and the number of events "
+           "per claim must be non-zero.\n";
+    }
+    void* const address = mmap(nullptr,
+                               sharedLength_,
+                               PROT_READ | PROT_WRITE,
+                               MAP_SHARED | MAP_ANONYMOUS,
+                               -1,
+                               0);
+    if (address == MAP_FAILED) {
+      throw Exception(errors::OtherArt)
+        << "ForkCoordinator: cannot allocate shared memory: "
+        << strerror(errno) << '\n';
+    }
+    counters_ = static_cast<counter_t*>(address);
+    for (unsigned i = 0; i <= nWorkers_; ++i) {
+      new (counters_ + i) counter_t{0};
+    }
+  }
+
+  ForkCoordinator::~ForkCoordinator() { munmap(counters_, sharedLength_); }
+
+  optional<int>
+  ForkCoordinator::forkWorkers()
+  {
+    if (auto const n = thread_count(); n > 1) {
+      // Only the forking thread exists in the workers: anything
+      // waiting on the other threads, or on locks they hold, would
+      // hang there.
+      throw Exception(errors::Configuration)
+        << "ForkCoordinator: " << n - 1
+        << " additional thread(s) were started during initialization.\n"
+           "They would not exist in the worker processes, so the job "
+           "cannot be run with --fork.\n"
+           "Threads (including TBB tasks) must not be started before the "
+           "beginJob transition.\n";
+    }
+    // Buffered output would otherwise be written by every process.
+    cout.flush();
+    cerr.flush();
+    fflush(nullptr);
+
+    for (unsigned i = 0; i != nWorkers_; ++i) {
+      pid_t const pid = fork();
+      if (pid == 0) {
+        index_ = i;
+        Globals::instance()->setProcessIndex(i);
+        workers_.clear();
+        return nullopt;
+      }
+      if (pid == -1) {
+        auto const error = errno;
+        for (auto const worker : workers_) {
+          kill(worker, SIGTERM);
+        }
+        wait_();
+        throw Exception(errors::OtherArt)
+          << "ForkCoordinator: cannot fork worker " << i << ": "
+          << strerror(error) << '\n';
+      }
+      workers_.push_back(pid);
+    }
+    mf::LogInfo("ForkCoordinator")
+      << "Started " << nWorkers_ << " worker processes.";
+    return wait_();
+  }
+
+  int
+  ForkCoordinator::wait_()
+  {
+    int result{0};
+    for (unsigned i = 0; i != workers_.size(); ++i) {
+      int status{};
+      pid_t rc{};
+      do {
+        rc = waitpid(workers_[i], &status, 0);
+      } while (rc == -1 && errno == EINTR);
+      int code{0};
+      if (rc == -1) {
+        code = 1;
+      } else if (WIFEXITED(status)) {
+        code = WEXITSTATUS(status);
+      } else if (WIFSIGNALED(status)) {
+        code = 128 + WTERMSIG(status);
+      }
+      if (code != 0) {
+        mf::LogError("ForkCoordinator")
+          << "Worker " << i << " (pid " << workers_[i]
+          << ") failed with status " << code << '.';
+        if (result == 0) {
+          result = code;
+        }
+      }
+    }
+    mf::LogInfo log{"ForkCoordinator"};
+    log << "Events processed by each worker:";
+    std::uint64_t total{};
+    for (unsigned i = 0; i != workers_.size(); ++i) {
+      auto const n = counters_[1 + i].load();
+      log << "\n  worker " << i << ": " << n;
+      total += n;
+    }
+    log << "\n  total: " << total;
+    workers_.clear();
+    return result;
+  }
+
+  bool
+  ForkCoordinator::claim(std::uint64_t const index)
+  {
+    auto const chunk = index / eventsPerClaim_;
+    if (chunk != currentChunk_) {
+      // Every worker offers to claim every chunk in order, so the
+      // counter never lags behind the chunk being offered: the claim
+      // succeeds exactly when no other worker got there first.
+      currentChunk_ = chunk;
+      auto expected = chunk;
+      ownsCurrentChunk_ =
+        counters_[0].compare_exchange_strong(expected, chunk + 1);
+    }
+    if (ownsCurrentChunk_) {
+      counters_[1 + index_].fetch_add(1, memory_order_relaxed);
+    }
+    return ownsCurrentChunk_;
+  }
+
+} // namespace art
@@ -0,0 +1,90 @@
+#ifndef art_Framework_EventProcessor_ForkCoordinator_h
+#define art_Framework_EventProcessor_ForkCoordinator_h
+// vim: set sw=2 expandtab :
+
+// ======================================================================
+// ForkCoordinator: runs the event loop of a fully initialized job in
+// several forked worker processes, which share the memory of the
+// initialized job copy-on-write.
+//
+// Every worker reads the same sequence of events from its copy of the
+// input source.  The sequence is divided into chunks of consecutive
+// events, each of which is processed by the first worker to reach it;
+// the other workers skip the events of that chunk, through
+// InputSource::discardEvent, without creating their principals.
+// Faster workers thus take on more of the work.  The claims are
+// arbitrated through a counter in memory shared by all processes.
+//
+// The Run and SubRun range sets of a worker cover only the events it
+// processed.  Each worker writes its own output files, with their own
+// file-catalog metadata; no metadata are merged across workers.
+//
+// The parent process does not process events: it waits for the
+// workers and combines their exit statuses.  No thread other than
+// the forking one may exist when the workers are forked.
+//
+// Nor may files be written through handles opened during
+// initialization: the workers inherit the handles, and would write to
+// the same files.  The job is therefore rejected if any database file
+// was opened through the DatabaseConnection service (e.g. by the
+// TimeTracker or MemoryTracker services, or by the
+// ProductSizeProfiler module, unless they use in-memory databases).
+// Other files opened by services or modules in their constructors
+// cannot be detected; such files should be opened no earlier than
+// beginJob, which each worker runs after the fork, with the worker
+// index (Globals::processIndex) in their names.
+// ======================================================================
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <optional>
+#include <sys/types.h>
+#include <vector>
+
+namespace art {
+
+  class ForkCoordinator {
+  public:
+    ForkCoordinator(unsigned nWorkers, unsigned eventsPerClaim);
+    ~ForkCoordinator();
+
+    ForkCoordinator(ForkCoordinator const&) = delete;
+    ForkCoordinator(ForkCoordinator&&) = delete;
+    ForkCoordinator& operator=(ForkCoordinator const&) = delete;
+    ForkCoordinator& operator=(ForkCoordinator&&) = delete;
+
+    // Fork the workers.  Returns std::nullopt in each worker, and, in
+    // the parent, the combined exit status once all workers have
+    // finished: zero if all of them succeeded, otherwise that of the
+    // first failed worker.
+    std::optional<int> forkWorkers();
+
+    // In a worker: whether the event with the given index in the
+    // input sequence is to be processed by this worker.  Must be
+    // called for each event read, in order.
+    bool claim(std::uint64_t index);
+
+  private:
+    int wait_();
+
+    unsigned const nWorkers_;
+    std::uint64_t const eventsPerClaim_;
+    std::size_t const sharedLength_;
+    // In shared memory: the next chunk to be claimed, followed by
+    // the number of events claimed by each worker.
+    std::atomic<std::uint64_t>* counters_;
+    std::vector<pid_t> workers_{};
+    unsigned index_{};
+    std::uint64_t currentChunk_{std::numeric_limits<std::uint64_t>::max()};
+    bool ownsCurrentChunk_{false};
+  };
+
+} // namespace art
+
+#endif /* art_Framework_EventProcessor_ForkCoordinator_h */
+
+// Local Variables:
+// mode: c++
+// End:
@@ -8,6 +8,7 @@
 #include "tbb/global_control.h"
 
 #include <cstdlib>
+#include <optional>
 #include <string>
 
 using fhicl::ParameterSet;
@@ -40,6 +41,15 @@ namespace {
     return max_threads;
   }
 
+  std::optional<bool>
+  optional_value(fhicl::OptionalAtom<bool> const& atom)
+  {
+    if (bool value{}; atom(value)) {
+      return value;
+    }
+    return std::nullopt;
+  }
+
   constexpr auto max_parallelism = tbb::global_control::max_allowed_parallelism;
   constexpr auto thread_stack_size = tbb::global_control::thread_stack_size;
 }
@@ -51,6 +61,12 @@ namespace art {
     , nThreads_{adjust_num_threads(ps().num_threads())}
     , nSchedules_{ps().num_schedules()}
     , stackSize_{ps().stack_size()}
+    , nWorkers_{ps().num_workers()}
+    , eventsPerWorkerClaim_{ps().events_per_worker_claim()}
+    , orderedOutput_{ps().ordered_output()}
+    , reorderWindow_{ps().reorder_window()}
+    , serializedBatchSize_{ps().serialized_batch_size()}
+    , recordProvenance_{optional_value(ps().record_provenance)}
     , handleEmptyRuns_{ps().handleEmptyRuns()}
     , handleEmptySubRuns_{ps().handleEmptySubRuns()}
     , errorOnMissingConsumes_{ps().errorOnMissingConsumes()}
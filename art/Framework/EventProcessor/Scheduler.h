@@ -5,10 +5,12 @@
 #include "art/Utilities/GlobalTaskGroup.h"
 #include "art/Utilities/ScheduleID.h"
 #include "fhiclcpp/types/Atom.h"
+#include "fhiclcpp/types/OptionalAtom.h"
 #include "fhiclcpp/types/OptionalTable.h"
 #include "fhiclcpp/types/Table.h"
 #include "fhiclcpp/types/TableFragment.h"
 
+#include <optional>
 #include <string>
 
 namespace art {
@@ -43,6 +45,66 @@ namespace art {
                 "10 MB, which\n"
                 "more closely approximates the stack size of the main thread."},
         10 * mb()};
+      fhicl::Atom<std::string> allocator{
+        Name{"allocator"},
+        Comment{"The memory-allocation strategy: 'glibc1' (the system "
+                "allocator with a single\n"
+                "arena), 'glibcN' (the system allocator with up to "
+                "'arena_max' arenas), or\n"
+                "'tbbmalloc' (TBB's scalable allocator, which must be "
+                "preloaded through\n"
+                "LD_PRELOAD=libtbbmalloc_proxy.so.2).  Each glibc arena "
+                "reserves 64 MiB of\n"
+                "virtual memory; a single arena serializes the allocations "
+                "of all threads."},
+        "glibc1"};
+      fhicl::Atom<unsigned> arena_max{
+        Name{"arena_max"},
+        Comment{"With the 'glibcN' allocator, the maximum number of arenas "
+                "(zero for the\n"
+                "system default of eight per core)."},
+        0};
+      fhicl::Atom<unsigned> num_workers{
+        Name{"num_workers"},
+        Comment{"The number of worker processes forked after the job has "
+                "been initialized.\n"
+                "With more than one worker, each of them writes its own "
+                "output files, whose\n"
+                "names should therefore contain the worker index (%w)."},
+        1};
+      fhicl::Atom<unsigned> events_per_worker_claim{
+        Name{"events_per_worker_claim"},
+        Comment{"The number of consecutive input events handed to a worker "
+                "process at a time."},
+        10};
+      fhicl::Atom<bool> ordered_output{
+        Name{"ordered_output"},
+        Comment{"If true, events are written in the order in which they were "
+                "read, so that the\n"
+                "output files do not depend on the number of threads or "
+                "schedules."},
+        false};
+      fhicl::Atom<unsigned> reorder_window{
+        Name{"reorder_window"},
+        Comment{"With ordered output, the maximum number of events read but "
+                "not yet written.\n"
+                "Zero means no limit beyond the number of schedules."},
+        0};
+      fhicl::Atom<unsigned> serialized_batch_size{
+        Name{"serialized_batch_size"},
+        Comment{"The maximum number of queued events a serialized (shared or "
+                "legacy) module\n"
+                "may process back-to-back while it holds its shared "
+                "resources."},
+        1};
+      fhicl::OptionalAtom<bool> record_provenance{
+        Name{"record_provenance"},
+        Comment{"Whether the parentage of produced products and the process "
+                "histories of events\n"
+                "are recorded.  If omitted, they are recorded only if the job "
+                "has output modules.\n"
+                "Modules that inspect the parents of products need it set to "
+                "true."}};
       fhicl::Atom<bool> handleEmptyRuns{Name{"handleEmptyRuns"}, true};
       fhicl::Atom<bool> handleEmptySubRuns{Name{"handleEmptySubRuns"}, true};
       fhicl::Atom<bool> errorOnMissingConsumes{Name{"errorOnMissingConsumes"},
@@ -85,6 +147,36 @@ namespace art {
     {
       return nSchedules_;
     }
+    unsigned
+    num_workers() const noexcept
+    {
+      return nWorkers_;
+    }
+    unsigned
+    events_per_worker_claim() const noexcept
+    {
+      return eventsPerWorkerClaim_;
+    }
+    bool
+    ordered_output() const noexcept
+    {
+      return orderedOutput_;
+    }
+    unsigned
+    reorder_window() const noexcept
+    {
+      return reorderWindow_;
+    }
+    unsigned
+    serialized_batch_size() const noexcept
+    {
+      return serializedBatchSize_;
+    }
+    std::optional<bool>
+    record_provenance() const noexcept
+    {
+      return recordProvenance_;
+    }
     bool
     handleEmptyRuns() const noexcept
     {
@@ -120,6 +212,12 @@ namespace art {
     unsigned const nThreads_;
     unsigned const nSchedules_;
     unsigned const stackSize_;
+    unsigned const nWorkers_;
+    unsigned const eventsPerWorkerClaim_;
+    bool const orderedOutput_;
+    unsigned const reorderWindow_;
+    unsigned const serializedBatchSize_;
+    std::optional<bool> const recordProvenance_;
     bool const handleEmptyRuns_;
     bool const handleEmptySubRuns_;
     bool const errorOnMissingConsumes_;
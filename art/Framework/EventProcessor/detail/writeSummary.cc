@@ -47,14 +47,6 @@ namespace {
     std::size_t except{};
   };
 
-  struct ModuleCounts {
-    std::size_t visited{};
-    std::size_t run{};
-    std::size_t passed{};
-    std::size_t failed{};
-    std::size_t except{};
-  };
-
   using WorkersInPath = std::vector<art::WorkerInPath>;
   using WorkersInPathCounts = std::vector<WorkerInPathCounts>;
 
@@ -141,10 +133,11 @@ art::detail::triggerReport(PerScheduleContainer<PathsInfo> const& epis,
       for (auto const& path : tpi.paths()) {
         auto& counts = counts_per_path[path.pathID()];
         counts.path_name = path.name(); // No increment!
-        counts.run += path.timesRun();
-        counts.passed += path.timesPassed();
-        counts.failed += path.timesFailed();
-        counts.except += path.timesExcept();
+        auto const snapshot = path.countsSnapshot();
+        counts.run += snapshot.run;
+        counts.passed += snapshot.passed;
+        counts.failed += snapshot.failed;
+        counts.except += snapshot.except;
       }
     }
     for (auto const& [pathID, counts] : counts_per_path) {
@@ -168,9 +161,10 @@ art::detail::triggerReport(PerScheduleContainer<PathsInfo> const& epis,
       EndPathCounts epCounts{};
       for (auto const& epi : epis) {
         for (auto const& path : epi.paths()) {
-          epCounts.run += path.timesRun();
-          epCounts.success += path.timesPassed();
-          epCounts.except += path.timesExcept();
+          auto const snapshot = path.countsSnapshot();
+          epCounts.run += snapshot.run;
+          epCounts.success += snapshot.passed;
+          epCounts.except += snapshot.except;
         }
       }
       LogPrint("ArtSummary")
@@ -233,9 +227,10 @@ art::detail::triggerReport(PerScheduleContainer<PathsInfo> const& epis,
         if (counts.moduleLabel.empty()) {
           counts.moduleLabel = worker->description().moduleLabel();
         }
-        counts.visited += worker->timesRun(); // proxy for 'visited'
-        counts.passed += worker->timesPassed();
-        counts.except += worker->timesExcept();
+        auto const snapshot = worker->countsSnapshot();
+        counts.visited += snapshot.run; // proxy for 'visited'
+        counts.passed += snapshot.passed;
+        counts.except += snapshot.except;
         ++i;
       }
     }
@@ -268,21 +263,7 @@ art::detail::triggerReport(PerScheduleContainer<PathsInfo> const& epis,
                            << " " << std::right << setw(10) << "Error"
                            << " "
                            << "Name";
-    std::map<std::string, ModuleCounts> counts_per_module;
-    auto update_counts = [&counts_per_module](auto const& pathInfos) {
-      for (auto const& pi : pathInfos) {
-        for (auto const& [module_label, module_counts] : pi.workers()) {
-          auto& counts = counts_per_module[module_label];
-          counts.visited += module_counts->timesVisited();
-          counts.run += module_counts->timesRun();
-          counts.passed += module_counts->timesPassed();
-          counts.failed += module_counts->timesFailed();
-          counts.except += module_counts->timesExcept();
-        }
-      }
-    };
-    update_counts(tpis);
-    update_counts(epis);
+    auto const counts_per_module = moduleCounts(epis, tpis);
     for (auto const& [module_label, module_counts] : counts_per_module) {
       LogPrint("ArtSummary")
         << "TrigReport " << std::right << setw(10) << module_counts.visited
@@ -294,6 +275,29 @@ art::detail::triggerReport(PerScheduleContainer<PathsInfo> const& epis,
   }
 }
 
+std::map<std::string, art::Worker::CountsSnapshot>
+art::detail::moduleCounts(PerScheduleContainer<PathsInfo> const& epis,
+                          PerScheduleContainer<PathsInfo> const& tpis)
+{
+  std::map<std::string, Worker::CountsSnapshot> counts_per_module;
+  auto update_counts = [&counts_per_module](auto const& pathInfos) {
+    for (auto const& pi : pathInfos) {
+      for (auto const& [module_label, worker] : pi.workers()) {
+        auto& counts = counts_per_module[module_label];
+        auto const snapshot = worker->countsSnapshot();
+        counts.visited += snapshot.visited;
+        counts.run += snapshot.run;
+        counts.passed += snapshot.passed;
+        counts.failed += snapshot.failed;
+        counts.except += snapshot.except;
+      }
+    }
+  };
+  update_counts(tpis);
+  update_counts(epis);
+  return counts_per_module;
+}
+
 void
 art::detail::timeReport(cet::cpu_timer const& timer)
 {
@@ -2,8 +2,12 @@
 #define art_Framework_EventProcessor_detail_writeSummary_h
 // vim: set sw=2 expandtab :
 
+#include "art/Framework/Principal/Worker.h"
 #include "art/Utilities/PerScheduleContainer.h"
 
+#include <map>
+#include <string>
+
 namespace cet {
   class cpu_timer;
 } // namespace cet
@@ -23,6 +27,13 @@ namespace art {
                        bool wantSummary);
     void timeReport(cet::cpu_timer const& timer);
 
+    // Sums the execution statistics of each module over all schedules.
+    // The counters may be read while events are being processed, so
+    // this may also be used to monitor a running job.
+    std::map<std::string, Worker::CountsSnapshot> moduleCounts(
+      PerScheduleContainer<PathsInfo> const& endPathInfo,
+      PerScheduleContainer<PathsInfo> const& triggerPathsInfo);
+
   } // namespace detail
 
 } // namespace art
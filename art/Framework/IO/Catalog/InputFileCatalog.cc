@@ -12,14 +12,29 @@
 #include "boost/algorithm/string.hpp"
 #include "canvas/Utilities/Exception.h"
 #include "cetlib_except/exception.h"
+#include "messagefacility/MessageLogger/MessageLogger.h"
 
 #include <cassert>
+#include <filesystem>
+#include <system_error>
 
 namespace art {
 
+  namespace {
+    std::uintmax_t
+    size_of(std::string const& filename)
+    {
+      std::error_code ec;
+      auto const size = std::filesystem::file_size(filename, ec);
+      return ec ? 0 : size;
+    }
+  }
+
   InputFileCatalog::InputFileCatalog(
     fhicl::TableFragment<InputFileCatalog::Config> const& config)
     : fileSources_{config().namesParameter()}
+    , prestageDepth_{config().prestageDepth()}
+    , prestageBudget_{std::uintmax_t{config().prestageScratchMB()} << 20}
   {
 
     if (fileSources_.empty()) {
@@ -37,6 +52,19 @@ namespace art {
       fileCatalogItems_.resize(fileSources_.size());
   }
 
+  InputFileCatalog::~InputFileCatalog()
+  {
+    if (!stager_.joinable()) {
+      return;
+    }
+    {
+      std::lock_guard lock{stagingMutex_};
+      stopStaging_ = true;
+    }
+    stagingCondition_.notify_all();
+    stager_.join();
+  }
+
   FileCatalogItem const&
   InputFileCatalog::currentFile() const
   {
@@ -106,13 +134,33 @@ namespace art {
     // Tell the service the current opened file (if there is one) is consumed
     finish();
 
+    // Files that have not been seen before come from the staging
+    // thread; previously seen files are taken from the cache.
+    if (prestageDepth_ != 0 && !transferOnly && !(fileIdx_ < maxIdx_)) {
+      prestageAttempts_ = attempts;
+      if (!stager_.joinable()) {
+        stager_ = std::thread{&InputFileCatalog::stageFiles, this};
+      }
+      return takeStagedFile(item);
+    }
+
+    std::lock_guard lock{serviceMutex_};
+    return deliverAndTransfer(item, attempts, transferOnly, true);
+  }
+
+  bool
+  InputFileCatalog::deliverAndTransfer(FileCatalogItem& item,
+                                       int const attempts,
+                                       bool const transferOnly,
+                                       bool const useCache)
+  {
     // retrieve (deliver and transfer) next file from service
     // or, do the transfer only
     FileCatalogStatus status;
     if (transferOnly) {
       status = transferNextFile(item);
     } else {
-      status = retrieveNextFileFromCacheOrService(item);
+      status = retrieveNextFileFromCacheOrService(item, useCache);
     }
 
     switch (status) {
@@ -131,7 +179,10 @@ namespace art {
           << "Delivery error encountered after reaching maximum number of "
              "attemtps!";
       }
-      return retrieveNextFile(item, attempts - 1, false);
+      mf::LogWarning("InputFileCatalog")
+        << "Delivery of the next input file failed; " << attempts - 1
+        << " attempt(s) left.";
+      return deliverAndTransfer(item, attempts - 1, false, useCache);
     }
     case FileCatalogStatus::TRANSFER_ERROR: {
       if (attempts <= 1) {
@@ -142,18 +193,85 @@ namespace art {
         ci_->updateStatus(item.uri(), FileDisposition::SKIPPED);
         return true;
       }
-      return retrieveNextFile(item, attempts - 1, true);
+      mf::LogWarning("InputFileCatalog")
+        << "Transfer of input file '" << item.uri() << "' failed; "
+        << attempts - 1 << " attempt(s) left.";
+      return deliverAndTransfer(item, attempts - 1, true, useCache);
     }
     }
     assert(false);
     return false; // Unreachable, but keeps the compiler happy
   }
 
+  bool
+  InputFileCatalog::takeStagedFile(FileCatalogItem& item)
+  {
+    std::unique_lock lock{stagingMutex_};
+    stagingCondition_.wait(lock, [this] { return !staged_.empty(); });
+    auto& staged = staged_.front();
+    // The last entry (no more files, or an error) is kept, so that it
+    // is seen by any subsequent call.
+    if (staged.error) {
+      std::rethrow_exception(staged.error);
+    }
+    if (!staged.available) {
+      return false;
+    }
+    item = std::move(staged.item);
+    stagedBytes_ -= staged.size;
+    staged_.pop_front();
+    stagedFileOpen_ = true;
+    return true;
+  }
+
+  void
+  InputFileCatalog::stageFiles()
+  {
+    auto const room_for_more = [this] {
+      auto const unconsumed = staged_.size() + stagedFileOpen_;
+      return unconsumed < prestageDepth_ &&
+             (prestageBudget_ == 0 || staged_.empty() ||
+              stagedBytes_ < prestageBudget_);
+    };
+    std::unique_lock lock{stagingMutex_};
+    while (true) {
+      stagingCondition_.wait(
+        lock, [this, &room_for_more] {
+          return stopStaging_ || room_for_more();
+        });
+      if (stopStaging_) {
+        return;
+      }
+      lock.unlock();
+      StagedFile staged;
+      try {
+        std::lock_guard service_lock{serviceMutex_};
+        // The staging thread only asks the services for new files;
+        // the cache of previously seen files belongs to the reader.
+        staged.available = deliverAndTransfer(
+          staged.item, prestageAttempts_.load(), false, false);
+      }
+      catch (...) {
+        staged.error = std::current_exception();
+      }
+      staged.size = size_of(staged.item.fileName());
+      bool const last = staged.error || !staged.available;
+      lock.lock();
+      stagedBytes_ += staged.size;
+      staged_.push_back(std::move(staged));
+      stagingCondition_.notify_all();
+      if (last) {
+        return;
+      }
+    }
+  }
+
   FileCatalogStatus
-  InputFileCatalog::retrieveNextFileFromCacheOrService(FileCatalogItem& item)
+  InputFileCatalog::retrieveNextFileFromCacheOrService(FileCatalogItem& item,
+                                                       bool const useCache)
   {
     // Try to get it from cached files
-    if (fileIdx_ < maxIdx_) {
+    if (useCache && fileIdx_ < maxIdx_) {
       item = fileCatalogItems_[fileIdx_ + 1];
       return FileCatalogStatus::SUCCESS;
     }
@@ -241,13 +359,31 @@ namespace art {
   void
   InputFileCatalog::finish()
   {
-    if (fileIdx_ != indexEnd          // there is a current file
-        && !currentFile().skipped()   // not skipped
-        && !currentFile().consumed()) // not consumed
     {
-      ci_->updateStatus(currentFile().uri(), FileDisposition::CONSUMED);
-      fileCatalogItems_[fileIdx_].consume();
+      std::lock_guard lock{serviceMutex_};
+      if (fileIdx_ != indexEnd          // there is a current file
+          && !currentFile().skipped()   // not skipped
+          && !currentFile().consumed()) // not consumed
+      {
+        ci_->updateStatus(currentFile().uri(), FileDisposition::CONSUMED);
+        fileCatalogItems_[fileIdx_].consume();
+        // A searchable catalog may be rewound to the file, which must
+        // then still be available.
+        if (!searchable_) {
+          ft_->releaseLocalFilename(currentFile().fileName());
+        }
+      }
+    }
+    if (!stager_.joinable()) {
+      return;
+    }
+    // The current file has been disposed of; the staging thread may now
+    // request another one.
+    {
+      std::lock_guard lock{stagingMutex_};
+      stagedFileOpen_ = false;
     }
+    stagingCondition_.notify_all();
   }
 
 } // namespace art
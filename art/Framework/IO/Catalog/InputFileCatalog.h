@@ -5,16 +5,40 @@
 //
 // Class InputFileCatalog. Services to manage InputFile catalog
 //
+// If 'prestageDepth' is non-zero, a background thread delivers and
+// transfers the files ahead of the file that is being read, so that
+// the schedules do not stall at each file boundary while the next file
+// is retrieved.  At most 'prestageDepth' files, including the one
+// being read, are delivered but not yet consumed: a new file is only
+// requested once the current one has been marked consumed (or
+// skipped), so that the staging thread never runs further ahead of the
+// delivery service's bookkeeping than configured.  The staging thread
+// makes as many attempts per file as the reader requested in its most
+// recent call.  Calls to the FileDelivery and FileTransfer services
+// are serialized, so the services need not be thread-safe.
+//
+// Unless the catalog is searchable, the FileTransfer service is told
+// to release each consumed file, so that local copies do not
+// accumulate in the scratch area over a long job.
+//
 // ======================================================================
 
 #include "art/Framework/IO/Catalog/FileCatalog.h"
 #include "art/Framework/Services/FileServiceInterfaces/CatalogInterface.h"
 #include "art/Framework/Services/FileServiceInterfaces/FileTransfer.h"
 #include "art/Framework/Services/Registry/ServiceHandle.h"
+#include "fhiclcpp/types/Atom.h"
 #include "fhiclcpp/types/Sequence.h"
 #include "fhiclcpp/types/TableFragment.h"
 
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <exception>
+#include <mutex>
 #include <string>
+#include <thread>
 #include <vector>
 
 // ----------------------------------------------------------------------
@@ -31,10 +55,27 @@ namespace art {
   public:
     struct Config {
       fhicl::Sequence<std::string> namesParameter{fhicl::Name("fileNames")};
+      fhicl::Atom<unsigned> prestageDepth{
+        fhicl::Name("prestageDepth"),
+        fhicl::Comment(
+          "Maximum number of files, including the file being read, that\n"
+          "are delivered but not yet consumed.  The files after the one\n"
+          "being read are delivered and transferred in the background;\n"
+          "a value of at least 2 is needed for any file to be staged\n"
+          "ahead.  With the default of 0, a file is retrieved only once\n"
+          "the previous one has been exhausted."),
+        0u};
+      fhicl::Atom<unsigned> prestageScratchMB{
+        fhicl::Name("prestageScratchMB"),
+        fhicl::Comment(
+          "Upper limit (in MiB) on the total size of the files that have\n"
+          "been staged but not yet opened; 0 means no limit.  At least\n"
+          "one file is always staged."),
+        0u};
     };
 
     explicit InputFileCatalog(fhicl::TableFragment<Config> const& config);
-    virtual ~InputFileCatalog() = default;
+    virtual ~InputFileCatalog();
     std::size_t
     size() const noexcept
     {
@@ -66,10 +107,24 @@ namespace art {
     static constexpr size_t indexEnd{std::numeric_limits<size_t>::max()};
 
   private:
+    struct StagedFile {
+      FileCatalogItem item{};
+      bool available{false};
+      std::exception_ptr error{};
+      std::uintmax_t size{};
+    };
+
     bool retrieveNextFile(FileCatalogItem& item,
                           int attempts,
                           bool transferOnly = false);
-    FileCatalogStatus retrieveNextFileFromCacheOrService(FileCatalogItem& item);
+    bool deliverAndTransfer(FileCatalogItem& item,
+                            int attempts,
+                            bool transferOnly,
+                            bool useCache);
+    bool takeStagedFile(FileCatalogItem& item);
+    void stageFiles();
+    FileCatalogStatus retrieveNextFileFromCacheOrService(FileCatalogItem& item,
+                                                         bool useCache);
     FileCatalogStatus transferNextFile(FileCatalogItem& item);
 
     std::vector<std::string> fileSources_;
@@ -81,6 +136,22 @@ namespace art {
     bool nextFileProbed_{false};
     bool hasNextFile_{false};
 
+    unsigned const prestageDepth_;
+    std::uintmax_t const prestageBudget_;
+    std::atomic<int> prestageAttempts_{5};
+    // Serializes the calls to the services.
+    std::mutex serviceMutex_{};
+    // Protects the staging state below.
+    std::mutex stagingMutex_{};
+    std::condition_variable stagingCondition_{};
+    std::deque<StagedFile> staged_{};
+    std::uintmax_t stagedBytes_{};
+    // True while a file handed out by the staging thread is being
+    // read, i.e. until it has been marked consumed or skipped.
+    bool stagedFileOpen_{false};
+    bool stopStaging_{false};
+    std::thread stager_{};
+
     ServiceHandle<CatalogInterface> ci_;
     ServiceHandle<FileTransfer> ft_;
   }; // InputFileCatalog
@@ -1,6 +1,7 @@
 #include "art/Framework/IO/PostCloseFileRenamer.h"
 
 #include "art/Framework/IO/FileStatsCollector.h"
+#include "art/Utilities/Globals.h"
 #include "boost/date_time/posix_time/posix_time.hpp"
 #include "boost/filesystem.hpp"
 #include "canvas/Utilities/Exception.h"
@@ -20,7 +21,7 @@ using boost::smatch;
 
 namespace {
   boost::regex const rename_re{
-    "%[lp]|%(\\d+)?([#rRsS])|%t([ocrRsS])|%if([bnedp])|%"
+    "%[lpw]|%(\\d+)?([#rRsS])|%t([ocrRsS])|%if([bnedp])|%"
     "ifs%([^%]*)%([^%]*)%([ig]*)%|%.",
     ECMAScript};
 
@@ -76,6 +77,9 @@ art::PostCloseFileRenamer::applySubstitutionsNoIndex_(
     case 'p':
       result += stats_.processName();
       break;
+    case 'w':
+      result += std::to_string(Globals::instance()->processIndex());
+      break;
     case 'i':
       result += subInputFileName_(match);
       break;
@@ -0,0 +1,169 @@
+#ifndef art_Framework_IO_SharedMemory_MessageBuffer_h
+#define art_Framework_IO_SharedMemory_MessageBuffer_h
+// vim: set sw=2 expandtab :
+
+// ======================================================================
+// MessageWriter and MessageReader: append fields to, and extract
+// fields from, the byte buffers exchanged through a SharedMemoryRing.
+//
+// Both processes run on the same node with the same build of art, so
+// trivially-copyable values are transferred in their native
+// representation.  Strings and vectors are preceded by their length.
+//
+// Each message starts with its MessageKind.  The stream consists of
+// one Catalog message, listing the transferred products, followed by
+// Run, SubRun and Event messages in the order of the writing job.
+// ======================================================================
+
+#include "canvas/Utilities/Exception.h"
+
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+namespace art {
+
+  enum class MessageKind : std::uint8_t { Catalog, Run, SubRun, Event };
+
+  class MessageWriter {
+  public:
+    explicit MessageWriter(std::vector<char>& buffer) : buffer_{buffer} {}
+
+    template <typename T>
+    std::enable_if_t<std::is_trivially_copyable_v<T>>
+    put(T const& value)
+    {
+      append_(&value, sizeof(T));
+    }
+
+    void
+    put(std::string const& value)
+    {
+      put(static_cast<std::uint64_t>(value.size()));
+      append_(value.data(), value.size());
+    }
+
+    template <typename T>
+    std::enable_if_t<std::is_trivially_copyable_v<T>>
+    put(std::vector<T> const& values)
+    {
+      put(static_cast<std::uint64_t>(values.size()));
+      append_(values.data(), values.size() * sizeof(T));
+    }
+
+    void
+    put(std::vector<std::string> const& values)
+    {
+      put(static_cast<std::uint64_t>(values.size()));
+      for (auto const& value : values) {
+        put(value);
+      }
+    }
+
+  private:
+    void
+    append_(void const* data, std::size_t const size)
+    {
+      auto const bytes = static_cast<char const*>(data);
+      buffer_.insert(buffer_.end(), bytes, bytes + size);
+    }
+
+    std::vector<char>& buffer_;
+  };
+
+  class MessageReader {
+  public:
+    explicit MessageReader(std::vector<char> const& buffer)
+      : cursor_{buffer.data()}, end_{buffer.data() + buffer.size()}
+    {}
+
+    bool
+    empty() const noexcept
+    {
+      return cursor_ == end_;
+    }
+
+    template <typename T>
+    std::enable_if_t<std::is_trivially_copyable_v<T>>
+    get(T& value)
+    {
+      extract_(&value, sizeof(T));
+    }
+
+    void
+    get(std::string& value)
+    {
+      value.resize(length_(1));
+      extract_(value.data(), value.size());
+    }
+
+    template <typename T>
+    std::enable_if_t<std::is_trivially_copyable_v<T>>
+    get(std::vector<T>& values)
+    {
+      values.resize(length_(sizeof(T)));
+      extract_(values.data(), values.size() * sizeof(T));
+    }
+
+    void
+    get(std::vector<std::string>& values)
+    {
+      values.resize(length_(sizeof(std::uint64_t)));
+      for (auto& value : values) {
+        get(value);
+      }
+    }
+
+    template <typename T>
+    T
+    get()
+    {
+      T value{};
+      get(value);
+      return value;
+    }
+
+  private:
+    // Read a length, and check that at least 'length * elementSize'
+    // bytes remain, so that a corrupt length cannot cause a huge
+    // allocation.
+    std::size_t
+    length_(std::size_t const elementSize)
+    {
+      auto const length = get<std::uint64_t>();
+      if (length > static_cast<std::uint64_t>(end_ - cursor_) / elementSize) {
+        throwTruncated_();
+      }
+      return length;
+    }
+
+    void
+    extract_(void* data, std::size_t const size)
+    {
+      if (size > static_cast<std::size_t>(end_ - cursor_)) {
+        throwTruncated_();
+      }
+      std::memcpy(data, cursor_, size);
+      cursor_ += size;
+    }
+
+    [[noreturn]] static void
+    throwTruncated_()
+    {
+      throw Exception(errors::DataCorruption)
+        << "MessageReader: a shared-memory message is truncated.\n";
+    }
+
+    char const* cursor_;
+    char const* const end_;
+  };
+
+} // namespace art
+
+#endif /* art_Framework_IO_SharedMemory_MessageBuffer_h */
+
+// Local Variables:
+// mode: c++
+// End:
@@ -0,0 +1,107 @@
+#include "art/Framework/IO/SharedMemory/ProductCodec.h"
+// vim: set sw=2 expandtab :
+
+#include "art/Framework/Core/ProductRegistryHelper.h"
+#include "art/Framework/IO/Sources/put_product_in_principal.h"
+#include "art/Framework/Principal/EventPrincipal.h"
+#include "canvas/Persistency/Common/EDProduct.h"
+#include "canvas/Persistency/Common/Wrapper.h"
+#include "canvas/Utilities/Exception.h"
+#include "canvas/Utilities/TypeID.h"
+
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <vector>
+
+namespace art {
+
+  namespace {
+    template <typename T>
+    class Codec : public ProductCodec {
+    public:
+      void
+      encode(EDProduct const& wrapper, MessageWriter& writer) const override
+      {
+        auto const w = dynamic_cast<Wrapper<T> const*>(&wrapper);
+        if (w == nullptr || w->product() == nullptr) {
+          throw Exception(errors::LogicError)
+            << "ProductCodec: the product is not of the expected type "
+            << TypeID{typeid(T)}.className() << ".\n";
+        }
+        writer.put(*w->product());
+      }
+
+      void
+      reconstitutes(ProductRegistryHelper& helper,
+                    std::string const& moduleLabel,
+                    std::string const& instanceName) const override
+      {
+        helper.reconstitutes<T, InEvent>(moduleLabel, instanceName);
+      }
+
+      void
+      put(MessageReader& reader,
+          EventPrincipal& principal,
+          std::string const& moduleLabel,
+          std::string const& instanceName) const override
+      {
+        auto product = std::make_unique<T>();
+        reader.get(*product);
+        put_product_in_principal(
+          std::move(product), principal, moduleLabel, instanceName);
+      }
+    };
+
+    using Codecs = std::map<std::string, std::unique_ptr<ProductCodec const>>;
+
+    template <typename... Ts>
+    void
+    add(Codecs& codecs)
+    {
+      (codecs.emplace(TypeID{typeid(Ts)}.className(),
+                      std::make_unique<Codec<Ts>>()),
+       ...);
+    }
+
+    template <typename... Ts>
+    void
+    addWithVectors(Codecs& codecs)
+    {
+      add<Ts...>(codecs);
+      add<std::vector<Ts>...>(codecs);
+    }
+
+    Codecs
+    makeCodecs()
+    {
+      Codecs result;
+      add<bool>(result);
+      addWithVectors<char,
+                     signed char,
+                     unsigned char,
+                     short,
+                     unsigned short,
+                     int,
+                     unsigned int,
+                     long,
+                     unsigned long,
+                     long long,
+                     unsigned long long,
+                     float,
+                     double,
+                     long double,
+                     std::string>(result);
+      return result;
+    }
+  }
+
+  ProductCodec const*
+  codecFor(std::string const& className)
+  {
+    static Codecs const codecs{makeCodecs()};
+    auto const it = codecs.find(className);
+    return it == codecs.cend() ? nullptr : it->second.get();
+  }
+
+} // namespace art
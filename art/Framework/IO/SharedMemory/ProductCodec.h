@@ -0,0 +1,57 @@
+#ifndef art_Framework_IO_SharedMemory_ProductCodec_h
+#define art_Framework_IO_SharedMemory_ProductCodec_h
+// vim: set sw=2 expandtab :
+
+// ======================================================================
+// ProductCodec: serializes products of a given type into the messages
+// exchanged through a SharedMemoryRing, and reconstitutes them in the
+// receiving process.
+//
+// Only types whose representation can be transferred without a
+// dictionary are supported: arithmetic types, std::string, and
+// std::vectors thereof (except std::vector<bool>).  codecFor returns
+// nullptr for any other type.
+// ======================================================================
+
+#include "art/Framework/IO/SharedMemory/MessageBuffer.h"
+#include "art/Framework/Principal/fwd.h"
+
+#include <string>
+
+namespace art {
+
+  class EDProduct;
+  class ProductRegistryHelper;
+
+  class ProductCodec {
+  public:
+    virtual ~ProductCodec() = default;
+
+    // Append the product held by 'wrapper' to the message.
+    virtual void encode(EDProduct const& wrapper,
+                        MessageWriter& writer) const = 0;
+
+    // Register the product with an input source.
+    virtual void reconstitutes(ProductRegistryHelper& helper,
+                               std::string const& moduleLabel,
+                               std::string const& instanceName) const = 0;
+
+    // Extract the product from the message and put it into the event.
+    virtual void put(MessageReader& reader,
+                     EventPrincipal& principal,
+                     std::string const& moduleLabel,
+                     std::string const& instanceName) const = 0;
+  };
+
+  // The codec for the type with the given class name, as returned by
+  // BranchDescription::producedClassName(), or nullptr if the type is
+  // not supported.
+  ProductCodec const* codecFor(std::string const& className);
+
+} // namespace art
+
+#endif /* art_Framework_IO_SharedMemory_ProductCodec_h */
+
+// Local Variables:
+// mode: c++
+// End:
@@ -0,0 +1,403 @@
+#include "art/Framework/IO/SharedMemory/SharedMemoryRing.h"
+// vim: set sw=2 expandtab :
+
+#include "canvas/Utilities/Exception.h"
+
+#include <fcntl.h>
+#include <pthread.h>
+#include <signal.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <time.h>
+#include <unistd.h>
+
+#include <atomic>
+#include <cerrno>
+#include <cstdint>
+#include <cstring>
+#include <new>
+#include <thread>
+
+using namespace std::chrono_literals;
+
+namespace art {
+
+  namespace {
+    constexpr std::uint32_t ring_magic{0x61727452}; // "artR"
+    constexpr std::uint32_t ring_version{1};
+    constexpr std::size_t alignment{64};
+
+    constexpr std::size_t
+    aligned(std::size_t const n)
+    {
+      return (n + alignment - 1) / alignment * alignment;
+    }
+
+    std::size_t
+    stride(std::size_t const slotSize)
+    {
+      return aligned(sizeof(std::uint64_t) + slotSize);
+    }
+
+    bool
+    alive(pid_t const pid)
+    {
+      return ::kill(pid, 0) == 0 || errno != ESRCH;
+    }
+
+    [[noreturn]] void
+    throw_errno(char const* what, std::string const& name)
+    {
+      throw Exception(errors::FileOpenError)
+        << "SharedMemoryRing: " << what << " for segment '" << name
+        << "' failed: " << std::strerror(errno) << '\n';
+    }
+  }
+
+  struct SharedMemoryRing::Header {
+    std::uint32_t version;
+    std::uint64_t nSlots;
+    std::uint64_t slotSize;
+    pthread_mutex_t mutex;
+    pthread_cond_t notEmpty;
+    pthread_cond_t notFull;
+    // Numbers of messages written and read since creation.
+    std::uint64_t written;
+    std::uint64_t read;
+    pid_t writer;
+    pid_t reader;
+    bool writerDone;
+    bool writerAborted;
+    bool readerDone;
+    // Set last, once the header has been initialized.
+    std::atomic<std::uint32_t> magic;
+  };
+
+  namespace {
+    // Whether nSlots slots of the given size fit into a segment of
+    // the given length after its header.
+    bool
+    slots_fit(std::uint64_t const nSlots,
+              std::uint64_t const slotSize,
+              std::size_t const length,
+              std::size_t const headerLength)
+    {
+      if (nSlots == 0 || headerLength > length || slotSize >= length) {
+        return false;
+      }
+      return nSlots <= (length - headerLength) / stride(slotSize);
+    }
+
+    // Locks a process-shared, robust mutex.  If the previous owner
+    // died while holding it, the state it protects consists of
+    // counters and flags that are only ever updated as a whole, so
+    // the mutex may simply be marked consistent again.
+    class Lock {
+    public:
+      explicit Lock(pthread_mutex_t& mutex) : mutex_{mutex}
+      {
+        lock();
+      }
+      ~Lock()
+      {
+        if (locked_) {
+          pthread_mutex_unlock(&mutex_);
+        }
+      }
+      Lock(Lock const&) = delete;
+      Lock& operator=(Lock const&) = delete;
+
+      void
+      lock()
+      {
+        int const rc = pthread_mutex_lock(&mutex_);
+        if (rc == EOWNERDEAD) {
+          pthread_mutex_consistent(&mutex_);
+        } else if (rc != 0) {
+          throw Exception(errors::LogicError)
+            << "SharedMemoryRing: cannot lock the ring: " << std::strerror(rc)
+            << '\n';
+        }
+        locked_ = true;
+      }
+
+      void
+      unlock()
+      {
+        pthread_mutex_unlock(&mutex_);
+        locked_ = false;
+      }
+
+      // Wait for the condition to be signaled, for at most a second,
+      // so that the caller can check whether its peer is still alive.
+      void
+      wait(pthread_cond_t& condition)
+      {
+        timespec deadline;
+        clock_gettime(CLOCK_MONOTONIC, &deadline);
+        deadline.tv_sec += 1;
+        if (pthread_cond_timedwait(&condition, &mutex_, &deadline) ==
+            EOWNERDEAD) {
+          pthread_mutex_consistent(&mutex_);
+        }
+      }
+
+    private:
+      pthread_mutex_t& mutex_;
+      bool locked_{false};
+    };
+  }
+
+  std::unique_ptr<SharedMemoryRing>
+  SharedMemoryRing::create(std::string const& name,
+                           std::size_t const nSlots,
+                           std::size_t const slotSize)
+  {
+    if (nSlots == 0 || slotSize == 0) {
+      throw Exception(errors::Configuration)
+        << "SharedMemoryRing: the number of slots and the slot size must be "
+           "non-zero.\n";
+    }
+    int const fd = ::shm_open(name.c_str(), O_CREAT | O_EXCL | O_RDWR, 0600);
+    if (fd == -1) {
+      throw_errno("shm_open", name);
+    }
+    auto const length = aligned(sizeof(Header)) + nSlots * stride(slotSize);
+    if (::ftruncate(fd, length) == -1) {
+      ::close(fd);
+      ::shm_unlink(name.c_str());
+      throw_errno("ftruncate", name);
+    }
+    void* const address =
+      ::mmap(nullptr, length, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    ::close(fd);
+    if (address == MAP_FAILED) {
+      ::shm_unlink(name.c_str());
+      throw_errno("mmap", name);
+    }
+
+    auto header = new (address) Header{};
+    header->version = ring_version;
+    header->nSlots = nSlots;
+    header->slotSize = slotSize;
+    header->writer = ::getpid();
+
+    pthread_mutexattr_t mutexAttr;
+    pthread_mutexattr_init(&mutexAttr);
+    pthread_mutexattr_setpshared(&mutexAttr, PTHREAD_PROCESS_SHARED);
+    pthread_mutexattr_setrobust(&mutexAttr, PTHREAD_MUTEX_ROBUST);
+    pthread_mutex_init(&header->mutex, &mutexAttr);
+    pthread_mutexattr_destroy(&mutexAttr);
+
+    pthread_condattr_t condAttr;
+    pthread_condattr_init(&condAttr);
+    pthread_condattr_setpshared(&condAttr, PTHREAD_PROCESS_SHARED);
+    pthread_condattr_setclock(&condAttr, CLOCK_MONOTONIC);
+    pthread_cond_init(&header->notEmpty, &condAttr);
+    pthread_cond_init(&header->notFull, &condAttr);
+    pthread_condattr_destroy(&condAttr);
+
+    header->magic.store(ring_magic, std::memory_order_release);
+    return std::unique_ptr<SharedMemoryRing>{
+      new SharedMemoryRing{name, address, length, true}};
+  }
+
+  std::unique_ptr<SharedMemoryRing>
+  SharedMemoryRing::attach(std::string const& name,
+                           std::chrono::seconds const timeout)
+  {
+    auto const deadline = std::chrono::steady_clock::now() + timeout;
+    while (true) {
+      int const fd = ::shm_open(name.c_str(), O_RDWR, 0600);
+      if (fd == -1 && errno != ENOENT) {
+        throw_errno("shm_open", name);
+      }
+      if (fd != -1) {
+        struct stat st;
+        if (::fstat(fd, &st) == -1) {
+          ::close(fd);
+          throw_errno("fstat", name);
+        }
+        auto const length = static_cast<std::size_t>(st.st_size);
+        void* address = MAP_FAILED;
+        if (length >= sizeof(Header)) {
+          address =
+            ::mmap(nullptr, length, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+        }
+        ::close(fd);
+        if (address != MAP_FAILED) {
+          auto header = static_cast<Header*>(address);
+          if (header->magic.load(std::memory_order_acquire) == ring_magic) {
+            if (header->version != ring_version ||
+                !slots_fit(header->nSlots,
+                           header->slotSize,
+                           length,
+                           aligned(sizeof(Header)))) {
+              ::munmap(address, length);
+              throw Exception(errors::FileReadError)
+                << "SharedMemoryRing: segment '" << name
+                << "' has an incompatible layout.\n";
+            }
+            {
+              Lock lock{header->mutex};
+              if (header->reader != 0) {
+                lock.unlock();
+                ::munmap(address, length);
+                throw Exception(errors::Configuration)
+                  << "SharedMemoryRing: segment '" << name
+                  << "' already has a reader.\n";
+              }
+              header->reader = ::getpid();
+            }
+            return std::unique_ptr<SharedMemoryRing>{
+              new SharedMemoryRing{name, address, length, false}};
+          }
+          // Not yet initialized by the writer.
+          ::munmap(address, length);
+        }
+      }
+      if (std::chrono::steady_clock::now() > deadline) {
+        throw Exception(errors::FileOpenError)
+          << "SharedMemoryRing: segment '" << name
+          << "' was not created within " << timeout.count() << " s.\n";
+      }
+      std::this_thread::sleep_for(50ms);
+    }
+  }
+
+  SharedMemoryRing::SharedMemoryRing(std::string name,
+                                     void* const address,
+                                     std::size_t const length,
+                                     bool const owner)
+    : name_{std::move(name)}
+    , address_{address}
+    , length_{length}
+    , owner_{owner}
+    , header_{static_cast<Header*>(address)}
+    , nSlots_{header_->nSlots}
+    , slotSize_{header_->slotSize}
+  {}
+
+  SharedMemoryRing::~SharedMemoryRing()
+  {
+    try {
+      Lock lock{header_->mutex};
+      if (owner_) {
+        if (!closed_) {
+          // Let the reader know that the stream ended prematurely.
+          header_->writerDone = true;
+          header_->writerAborted = true;
+          pthread_cond_broadcast(&header_->notEmpty);
+        }
+      } else {
+        header_->readerDone = true;
+        pthread_cond_broadcast(&header_->notFull);
+      }
+    }
+    catch (...) {
+    }
+    ::munmap(address_, length_);
+    if (owner_) {
+      ::shm_unlink(name_.c_str());
+    }
+  }
+
+  char*
+  SharedMemoryRing::slot_(unsigned long long const index) const noexcept
+  {
+    return static_cast<char*>(address_) + aligned(sizeof(Header)) +
+           (index % nSlots_) * stride(slotSize_);
+  }
+
+  void
+  SharedMemoryRing::write(std::vector<char> const& message)
+  {
+    if (message.size() > slotSize_) {
+      throw Exception(errors::Configuration)
+        << "SharedMemoryRing: a message of " << message.size()
+        << " bytes does not fit into a slot of segment '" << name_ << "' ("
+        << slotSize_ << " bytes).\n";
+    }
+    Lock lock{header_->mutex};
+    while (header_->written - header_->read == nSlots_) {
+      if (header_->readerDone ||
+          (header_->reader != 0 && !alive(header_->reader))) {
+        throw Exception(errors::FileWriteError)
+          << "SharedMemoryRing: the reader of segment '" << name_
+          << "' has gone away.\n";
+      }
+      lock.wait(header_->notFull);
+    }
+    auto const index = header_->written;
+    lock.unlock();
+
+    // The slot is not visible to the reader until 'written' has been
+    // incremented.
+    auto slot = slot_(index);
+    std::uint64_t const size = message.size();
+    std::memcpy(slot, &size, sizeof(size));
+    std::memcpy(slot + sizeof(size), message.data(), size);
+
+    lock.lock();
+    ++header_->written;
+    pthread_cond_signal(&header_->notEmpty);
+  }
+
+  void
+  SharedMemoryRing::close()
+  {
+    Lock lock{header_->mutex};
+    header_->writerDone = true;
+    closed_ = true;
+    pthread_cond_broadcast(&header_->notEmpty);
+    while (header_->read != header_->written && !header_->readerDone) {
+      if (header_->reader != 0 && !alive(header_->reader)) {
+        break;
+      }
+      lock.wait(header_->notFull);
+    }
+  }
+
+  bool
+  SharedMemoryRing::read(std::vector<char>& message)
+  {
+    Lock lock{header_->mutex};
+    while (header_->written == header_->read) {
+      if (header_->writerAborted) {
+        throw Exception(errors::FileReadError)
+          << "SharedMemoryRing: the writer of segment '" << name_
+          << "' stopped before the end of the stream.\n";
+      }
+      if (header_->writerDone) {
+        return false;
+      }
+      if (!alive(header_->writer)) {
+        throw Exception(errors::FileReadError)
+          << "SharedMemoryRing: the writer of segment '" << name_
+          << "' has gone away.\n";
+      }
+      lock.wait(header_->notEmpty);
+    }
+    auto const index = header_->read;
+    lock.unlock();
+
+    auto const slot = slot_(index);
+    std::uint64_t size{};
+    std::memcpy(&size, slot, sizeof(size));
+    // The size prefix is stored ahead of the slot's payload, which
+    // can hold at most slotSize_ bytes.
+    if (size > slotSize_) {
+      throw Exception(errors::FileReadError)
+        << "SharedMemoryRing: a message in segment '" << name_
+        << "' claims " << size << " bytes, more than its slot can hold ("
+        << slotSize_ << " bytes).\n";
+    }
+    message.assign(slot + sizeof(size), slot + sizeof(size) + size);
+
+    lock.lock();
+    ++header_->read;
+    pthread_cond_signal(&header_->notFull);
+    return true;
+  }
+
+} // namespace art
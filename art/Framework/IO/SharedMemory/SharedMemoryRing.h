@@ -0,0 +1,93 @@
+#ifndef art_Framework_IO_SharedMemory_SharedMemoryRing_h
+#define art_Framework_IO_SharedMemory_SharedMemoryRing_h
+// vim: set sw=2 expandtab :
+
+// ======================================================================
+// SharedMemoryRing: a bounded queue of messages between one writing
+// and one reading process on the same node, kept in a named POSIX
+// shared-memory segment.
+//
+// The writer creates the segment; the reader attaches to it by name,
+// waiting for it to appear if necessary.  Each message occupies one
+// slot of fixed size.  A writer blocks while all slots are full, and
+// a reader while all slots are empty, which provides back-pressure in
+// both directions.  Once the writer has closed the ring, the reader
+// drains the remaining messages and then sees the end of the stream.
+//
+// The death of the peer process is detected while waiting, in which
+// case an exception is thrown rather than waiting forever.
+// ======================================================================
+
+#include <chrono>
+#include <cstddef>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace art {
+
+  class SharedMemoryRing {
+  public:
+    // Create the named segment, with the given number of slots, each
+    // able to hold one message of up to 'slotSize' bytes.
+    static std::unique_ptr<SharedMemoryRing> create(std::string const& name,
+                                                    std::size_t nSlots,
+                                                    std::size_t slotSize);
+
+    // Attach to the named segment, waiting up to 'timeout' for the
+    // writer to create it.
+    static std::unique_ptr<SharedMemoryRing> attach(
+      std::string const& name,
+      std::chrono::seconds timeout);
+
+    ~SharedMemoryRing();
+
+    SharedMemoryRing(SharedMemoryRing const&) = delete;
+    SharedMemoryRing(SharedMemoryRing&&) = delete;
+    SharedMemoryRing& operator=(SharedMemoryRing const&) = delete;
+    SharedMemoryRing& operator=(SharedMemoryRing&&) = delete;
+
+    // Writer interface.  'write' blocks while the ring is full.
+    // 'close' marks the end of the stream and waits until the reader
+    // has consumed all messages.
+    void write(std::vector<char> const& message);
+    void close();
+
+    // Reader interface.  'read' blocks while the ring is empty, and
+    // returns false once the writer has closed the ring and all
+    // messages have been read.
+    bool read(std::vector<char>& message);
+
+    std::size_t
+    slotSize() const noexcept
+    {
+      return slotSize_;
+    }
+
+  private:
+    struct Header;
+
+    SharedMemoryRing(std::string name,
+                     void* address,
+                     std::size_t length,
+                     bool owner);
+
+    char* slot_(unsigned long long index) const noexcept;
+
+    std::string const name_;
+    void* const address_;
+    std::size_t const length_;
+    bool const owner_;
+    Header* const header_;
+    std::size_t const nSlots_;
+    std::size_t const slotSize_;
+    bool closed_{false};
+  };
+
+} // namespace art
+
+#endif /* art_Framework_IO_SharedMemory_SharedMemoryRing_h */
+
+// Local Variables:
+// mode: c++
+// End:
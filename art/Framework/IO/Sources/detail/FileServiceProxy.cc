@@ -31,6 +31,7 @@ art::detail::FileServiceProxy::finish()
   if (currentItem_.ftStatus == FileTransferStatus::SUCCESS) {
     // File is complete.
     ci_->updateStatus(currentItem_.uri, FileDisposition::CONSUMED);
+    ft_->releaseLocalFilename(currentItem_.pfn);
   }
   currentItem_ = FileEntity(attemptsPerPhase_);
 }
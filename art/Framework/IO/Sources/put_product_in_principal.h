@@ -78,7 +78,7 @@ namespace art {
       *desc,
       std::make_unique<ProductProvenance const>(pid, productstatus::present()),
       std::make_unique<Wrapper<T>>(std::move(product)),
-      std::make_unique<RangeSet>(RangeSet::invalid()));
+      nullptr);
   }
 
   template <typename T, typename P>
@@ -13,14 +13,17 @@
 #include "art/Framework/Principal/SubRun.h"
 #include "art/Framework/Principal/SubRunPrincipal.h"
 #include "art/Persistency/Provenance/ModuleContext.h"
+#include "art/Utilities/CacheLine.h"
+#include "art/Utilities/PluginFactory.h"
 #include "canvas/Persistency/Provenance/EventAuxiliary.h"
 #include "canvas/Persistency/Provenance/EventID.h"
+#include "canvas/Persistency/Provenance/IDNumber.h"
 #include "canvas/Persistency/Provenance/RunAuxiliary.h"
 #include "canvas/Persistency/Provenance/RunID.h"
 #include "canvas/Persistency/Provenance/SubRunAuxiliary.h"
 #include "canvas/Persistency/Provenance/SubRunID.h"
 #include "canvas/Persistency/Provenance/Timestamp.h"
-#include "cetlib/BasicPluginFactory.h"
+#include "cetlib/PluginTypeDeducer.h"
 #include "fhiclcpp/ParameterSet.h"
 #include "fhiclcpp/types/Atom.h"
 #include "fhiclcpp/types/ConfigurationTable.h"
@@ -28,11 +31,16 @@
 #include "fhiclcpp/types/OptionalDelegatedParameter.h"
 #include "fhiclcpp/types/TableFragment.h"
 
+#include <algorithm>
+#include <atomic>
 #include <cassert>
 #include <chrono>
 #include <cstdint>
+#include <limits>
 #include <memory>
+#include <mutex>
 #include <thread>
+#include <utility>
 
 using namespace fhicl;
 using namespace std;
@@ -69,6 +77,16 @@ namespace art {
                 "of time before each new event, subrun, or run is created.\n"),
         0u};
       Atom<bool> resetEventOnSubRun{Name("resetEventOnSubRun"), true};
+      Atom<bool> concurrentEvents{
+        Name("concurrentEvents"),
+        Comment(
+          "If true, the events of each subrun are handed out to the\n"
+          "schedules without the input-source lock being held, each\n"
+          "schedule claiming the next event number from a shared counter.\n"
+          "Subrun and run boundaries, and the 'maxEvents' limit, are\n"
+          "respected exactly; the order in which the events are read is\n"
+          "not defined.  Calls to the timestamp plugin are serialized."),
+        false};
       OptionalAtom<RunNumber_t> firstRun{Name("firstRun")};
       OptionalAtom<SubRunNumber_t> firstSubRun{Name("firstSubRun")};
       OptionalAtom<EventNumber_t> firstEvent{Name("firstEvent")};
@@ -116,8 +134,18 @@ namespace art {
       cet::exempt_ptr<RunPrincipal const>) override;
     unique_ptr<EventPrincipal> readEvent(
       cet::exempt_ptr<SubRunPrincipal const>) override;
+    void discardEvent(cet::exempt_ptr<SubRunPrincipal const>) override;
+    size_t claimEvent() override;
+    unique_ptr<EventPrincipal> readClaimedEvent(
+      size_t claim,
+      cet::exempt_ptr<SubRunPrincipal const>) override;
 
     input::ItemType nextItemType_();
+    input::ItemType nextClaimedItemType_();
+    unique_ptr<EventPrincipal> makeEvent_(
+      EventID const& id,
+      bool lastInSubRun,
+      cet::exempt_ptr<SubRunPrincipal const>);
 
     unique_ptr<EmptyEventTimestampPlugin> makePlugin_(
       OptionalDelegatedParameter const& maybeConfig);
@@ -137,8 +165,42 @@ namespace art {
     bool newRun_{true};
     bool newSubRun_{true};
     bool const resetEventOnSubRun_;
-    cet::BasicPluginFactory pluginFactory_{};
+    PluginFactory pluginFactory_{};
     unique_ptr<EmptyEventTimestampPlugin> plugin_;
+
+    // Concurrent mode: the events of the current subrun form a block,
+    // whose events are claimed by incrementing 'claimed'.  The serial
+    // interface claims its events from the same counter.  Apart from
+    // that counter, a block is never modified once published through
+    // 'block_', so claims take no lock; blockMutex_ is held only to
+    // open a new block.  The block it replaces is kept until the next
+    // one is opened, for the schedules that may still be looking at
+    // it.  Those can only be schedules failing to claim one of its
+    // events: a new block is opened only once every claimed event has
+    // been read, as the events of a subrun are all processed before
+    // the next subrun begins.
+    struct Block {
+      EventID first{};
+      uint64_t size{};
+      unsigned firstInSubRun{};
+      bool endsJob{false};
+      alignas(cache_line_size) std::atomic<uint64_t> claimed{};
+    };
+    struct Claim {
+      EventID id;
+      bool lastInSubRun;
+    };
+    uint64_t claim_();
+    Claim claimed_(size_t claim);
+
+    bool const concurrentEvents_;
+    bool blockOpen_{false};
+    std::atomic<Block*> block_{nullptr};
+    unique_ptr<Block> currentBlock_{};
+    unique_ptr<Block> retiredBlock_{};
+    uint64_t serialClaim_{};
+    std::mutex blockMutex_{};
+    std::mutex pluginMutex_{};
   };
 
 } // namespace art
@@ -154,6 +216,9 @@ art::EmptyEvent::EmptyEvent(Parameters const& config,
   , eventCreationDelay_{config().eventCreationDelay()}
   , resetEventOnSubRun_{config().resetEventOnSubRun()}
   , plugin_{makePlugin_(config().timestampPlugin)}
+  , concurrentEvents_{config().concurrentEvents() &&
+                      limits_.processingMode() ==
+                        InputSource::RunsSubRunsAndEvents}
 {
   // Additional configuration checking which is cumbersome to do with
   // the FHiCL validation system.
@@ -266,6 +331,9 @@ art::EmptyEvent::nextItemType_()
     return input::IsSubRun;
   }
   // same run and subrun
+  if (concurrentEvents_) {
+    return nextClaimedItemType_();
+  }
   if (!firstTime_) {
     eventID_ = eventID_.next();
     if (!eventID_.runID().isValid()) {
@@ -281,6 +349,135 @@ art::EmptyEvent::nextItemType_()
   return input::IsEvent;
 }
 
+art::input::ItemType
+art::EmptyEvent::nextClaimedItemType_()
+{
+  // Called by nextItemType_ in concurrent mode.
+  if (blockOpen_) {
+    serialClaim_ = claim_();
+    if (serialClaim_ != std::numeric_limits<uint64_t>::max()) {
+      if (eventCreationDelay_ > 0ms) {
+        std::this_thread::sleep_for(eventCreationDelay_);
+      }
+      return input::IsEvent;
+    }
+    // All events of the block have been claimed; catch up with them.
+    blockOpen_ = false;
+    auto const& block = *currentBlock_;
+    eventID_ = EventID(block.first.run(),
+                       block.first.subRun(),
+                       block.first.event() + block.size - 1);
+    numberEventsInThisRun_ += block.size;
+    numberEventsInThisSubRun_ += block.size;
+    if (block.endsJob) {
+      return input::IsStop;
+    }
+    if (eventID_.event() == IDNumber<Level::Event>::max_valid()) {
+      // The event numbers of the subrun are exhausted.  A new block
+      // may not be opened while other schedules are reading events.
+      return input::IsStop;
+    }
+    return nextItemType_();
+  }
+
+  // Open a block with the remaining events of the subrun, as far as
+  // the limits allow.
+  if (!firstTime_) {
+    eventID_ = eventID_.next();
+    if (!eventID_.runID().isValid()) {
+      return input::IsStop;
+    }
+  }
+  firstTime_ = false;
+  uint64_t size = IDNumber<Level::Event>::max_valid() - eventID_.event() + 1;
+  if (numberEventsInSubRun_ > 0) {
+    size = std::min<uint64_t>(
+      size, numberEventsInSubRun_ - numberEventsInThisSubRun_);
+  }
+  if (numberEventsInRun_ > 0) {
+    size =
+      std::min<uint64_t>(size, numberEventsInRun_ - numberEventsInThisRun_);
+  }
+  auto const remainingEvents = limits_.remainingEvents();
+  bool endsJob{false};
+  if (remainingEvents >= 0 && static_cast<uint64_t>(remainingEvents) <= size) {
+    size = remainingEvents;
+    endsJob = true;
+  }
+  assert(size > 0);
+  {
+    std::lock_guard lock{blockMutex_};
+    auto block = make_unique<Block>();
+    block->first = eventID_;
+    block->size = size;
+    block->firstInSubRun = numberEventsInThisSubRun_;
+    block->endsJob = endsJob;
+    block_.store(block.get(), std::memory_order_release);
+    retiredBlock_ = std::exchange(currentBlock_, std::move(block));
+  }
+  blockOpen_ = true;
+  return nextClaimedItemType_();
+}
+
+size_t
+art::EmptyEvent::claimEvent()
+{
+  if (!concurrentEvents_) {
+    return 0;
+  }
+  // Stop handing out events once the allowed time has run out; the
+  // next call to nextItemType then ends the job.
+  if (steady_clock::now() - beginTime_ > maxTime_) {
+    return 0;
+  }
+  auto const index = claim_();
+  if (index == std::numeric_limits<uint64_t>::max()) {
+    return 0;
+  }
+  if (eventCreationDelay_ > 0ms) {
+    std::this_thread::sleep_for(eventCreationDelay_);
+  }
+  return index + 1;
+}
+
+uint64_t
+art::EmptyEvent::claim_()
+{
+  // Returns the index of the claimed event in the block, or the
+  // maximum value if all of its events have been claimed.
+  auto const none = std::numeric_limits<uint64_t>::max();
+  auto* const block = block_.load(std::memory_order_acquire);
+  if (block == nullptr ||
+      block->claimed.load(std::memory_order_relaxed) >= block->size) {
+    return none;
+  }
+  auto const index = block->claimed.fetch_add(1, std::memory_order_relaxed);
+  return index < block->size ? index : none;
+}
+
+art::EmptyEvent::Claim
+art::EmptyEvent::claimed_(size_t const claim)
+{
+  assert(claim != 0);
+  auto const index = claim - 1;
+  auto const& block = *block_.load(std::memory_order_acquire);
+  assert(index < block.size);
+  return {EventID{block.first.run(),
+                  block.first.subRun(),
+                  static_cast<EventNumber_t>(block.first.event() + index)},
+          block.firstInSubRun + index + 1 == numberEventsInSubRun_};
+}
+
+unique_ptr<art::EventPrincipal>
+art::EmptyEvent::readClaimedEvent(size_t const claim,
+                                  cet::exempt_ptr<SubRunPrincipal const> srp)
+{
+  auto const [id, lastInSubRun] = claimed_(claim);
+  auto result = makeEvent_(id, lastInSubRun, srp);
+  limits_.update(id);
+  return result;
+}
+
 unique_ptr<art::FileBlock>
 art::EmptyEvent::readFile()
 {
@@ -328,17 +525,49 @@ art::EmptyEvent::readSubRun(cet::exempt_ptr<RunPrincipal const> rp)
 unique_ptr<art::EventPrincipal>
 art::EmptyEvent::readEvent(cet::exempt_ptr<SubRunPrincipal const> srp)
 {
-  auto timestamp = plugin_ ? plugin_->doEventTimestamp(eventID_) :
-                             Timestamp::invalidTimestamp();
-  EventAuxiliary const eventAux{eventID_, timestamp, false};
+  if (concurrentEvents_) {
+    return readClaimedEvent(serialClaim_ + 1, srp);
+  }
+  auto result = makeEvent_(
+    eventID_, numberEventsInThisSubRun_ == numberEventsInSubRun_, srp);
+  limits_.update(result->eventID());
+  return result;
+}
+
+void
+art::EmptyEvent::discardEvent(cet::exempt_ptr<SubRunPrincipal const>)
+{
+  auto const id = concurrentEvents_ ? claimed_(serialClaim_ + 1).id : eventID_;
+  if (plugin_) {
+    // The plugin is still told about the event, so that the timestamps
+    // of the events that are processed do not depend on which ones
+    // were discarded.
+    std::lock_guard lock{pluginMutex_};
+    plugin_->doEventTimestamp(id);
+  }
+  limits_.update(id);
+}
+
+unique_ptr<art::EventPrincipal>
+art::EmptyEvent::makeEvent_(EventID const& id,
+                            bool const lastInSubRun,
+                            cet::exempt_ptr<SubRunPrincipal const> srp)
+{
+  auto timestamp = Timestamp::invalidTimestamp();
+  if (plugin_) {
+    std::unique_lock<std::mutex> lock{pluginMutex_, std::defer_lock};
+    if (concurrentEvents_) {
+      lock.lock();
+    }
+    timestamp = plugin_->doEventTimestamp(id);
+  }
+  EventAuxiliary const eventAux{id, timestamp, false};
   auto result = make_unique<EventPrincipal>(eventAux,
                                             processConfiguration(),
                                             nullptr,
                                             make_unique<NoDelayedReader>(),
-                                            numberEventsInThisSubRun_ ==
-                                              numberEventsInSubRun_);
+                                            lastInSubRun);
   result->setSubRunPrincipal(srp);
-  limits_.update(result->eventID());
   return result;
 }
 
@@ -0,0 +1,290 @@
+// ======================================================================
+//
+// ProductSizeProfiler: accumulate, over the whole job, the sizes of the
+//                      event products that an output module with the
+//                      same 'outputCommands' would write, as an aid to
+//                      deciding which products to drop or slim.
+//
+// For each kept event product, the module records the fraction of the
+// sampled events in which the product is present, and the mean, 99th
+// percentile and maximum of its size as reported by
+// EDProduct::productSize() (e.g. the number of elements of a
+// collection).  Products whose size is not a number contribute only to
+// the presence rate.
+//
+// The sizes are accumulated in a histogram with a bounded number of
+// bins, so the memory used does not grow with the number of events.
+// The mean and maximum are exact; the 99th percentile is the upper
+// edge of its bin, which exceeds the exact value by less than 1/32 of
+// it.
+//
+// Only every 'sampleEvery'-th event is inspected.  At the end of the
+// job, one row per product is written to the 'ProductSizes' table of
+// the SQLite database 'dbOutput.filename'.
+//
+// ======================================================================
+
+#include "art/Framework/Core/OutputModule.h"
+#include "art/Framework/Principal/EventPrincipal.h"
+#include "art/Framework/Services/Registry/ServiceHandle.h"
+#include "art/Framework/Services/System/DatabaseConnection.h"
+#include "canvas/Persistency/Provenance/BranchDescription.h"
+#include "canvas/Utilities/Exception.h"
+#include "cetlib/sqlite/Connection.h"
+#include "cetlib/sqlite/Ntuple.h"
+#include "fhiclcpp/types/Atom.h"
+#include "fhiclcpp/types/ConfigurationTable.h"
+#include "fhiclcpp/types/Table.h"
+#include "fhiclcpp/types/TableFragment.h"
+
+#include <algorithm>
+#include <bit>
+#include <charconv>
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace {
+
+  // The size reported by EDProduct::productSize(), if it is a number.
+  bool
+  numeric_size(std::string const& str, std::uint64_t& size)
+  {
+    auto const end = str.data() + str.size();
+    auto const [ptr, ec] = std::from_chars(str.data(), end, size);
+    return ec == std::errc{} && ptr == end;
+  }
+
+  // Sizes below 2^subBinBits each have their own bin.  Above, each
+  // range [2^k, 2^(k+1)) is divided into 2^subBinBits bins of equal
+  // width.
+  class SizeHistogram {
+  public:
+    void
+    fill(std::uint64_t const size)
+    {
+      auto const b = bin(size);
+      if (b >= counts_.size()) {
+        counts_.resize(b + 1);
+      }
+      ++counts_[b];
+      ++count_;
+      sum_ += size;
+      max_ = std::max(max_, size);
+    }
+
+    bool
+    empty() const
+    {
+      return count_ == 0;
+    }
+
+    double
+    mean() const
+    {
+      return static_cast<double>(sum_) / count_;
+    }
+
+    std::uint64_t
+    max() const
+    {
+      return max_;
+    }
+
+    // The nearest-rank 99th percentile, rounded up to the upper edge
+    // of its bin.
+    std::uint64_t
+    p99() const
+    {
+      auto const rank = (count_ * 99 + 99) / 100;
+      std::uint64_t seen{};
+      for (std::size_t b = 0; b != counts_.size(); ++b) {
+        seen += counts_[b];
+        if (seen >= rank) {
+          return std::min(upper_edge(b), max_);
+        }
+      }
+      return max_;
+    }
+
+  private:
+    static constexpr unsigned subBinBits{5};
+    static constexpr std::uint64_t subBins{1ull << subBinBits};
+
+    static std::size_t
+    bin(std::uint64_t const size)
+    {
+      if (size < subBins) {
+        return size;
+      }
+      unsigned const shift = std::bit_width(size) - 1 - subBinBits;
+      return (shift + 1) * subBins + ((size >> shift) - subBins);
+    }
+
+    // The largest size falling in the given bin.
+    static std::uint64_t
+    upper_edge(std::size_t const b)
+    {
+      if (b < subBins) {
+        return b;
+      }
+      auto const shift = b / subBins - 1;
+      auto const lower = (subBins + b % subBins) << shift;
+      return lower + ((1ull << shift) - 1);
+    }
+
+    std::vector<std::uint64_t> counts_{};
+    std::uint64_t count_{};
+    std::uint64_t sum_{};
+    std::uint64_t max_{};
+  };
+
+} // namespace
+
+namespace art {
+
+  class ProductSizeProfiler : public OutputModule {
+  public:
+    struct Config {
+      fhicl::TableFragment<OutputModule::Config> omConfig;
+      fhicl::Atom<unsigned> sampleEvery{
+        fhicl::Name("sampleEvery"),
+        fhicl::Comment("Inspect only every N-th event (N > 0)."),
+        1u};
+      struct DBoutput {
+        fhicl::Atom<std::string> filename{fhicl::Name{"filename"}};
+        fhicl::Atom<bool> overwrite{fhicl::Name{"overwrite"}, false};
+      };
+      fhicl::Table<DBoutput> dbOutput{fhicl::Name{"dbOutput"}};
+    };
+
+    using Parameters =
+      fhicl::WrappedTable<Config, OutputModule::Config::KeysToIgnore>;
+    explicit ProductSizeProfiler(Parameters const&);
+
+  private:
+    struct Statistics {
+      std::string processName;
+      std::string moduleLabel;
+      std::string instanceName;
+      std::string friendlyClassName;
+      std::uint64_t present{};
+      SizeHistogram sizes{};
+    };
+
+    void write(EventPrincipal& e) override;
+    void
+    writeSubRun(SubRunPrincipal&) override
+    {}
+    void
+    writeRun(RunPrincipal&) override
+    {}
+    void endJob() override;
+
+    unsigned const sampleEvery_;
+    std::unique_ptr<cet::sqlite::Connection> const db_;
+    bool const overwriteContents_;
+    std::uint64_t eventsSeen_{};
+    std::uint64_t eventsSampled_{};
+    std::map<std::string, Statistics> statistics_{};
+  }; // ProductSizeProfiler
+
+  ProductSizeProfiler::ProductSizeProfiler(Parameters const& ps)
+    : OutputModule{ps().omConfig}
+    , sampleEvery_{ps().sampleEvery()}
+    , db_{ServiceHandle<DatabaseConnection>{}->get(
+        ps().dbOutput().filename())}
+    , overwriteContents_{ps().dbOutput().overwrite()}
+  {
+    if (sampleEvery_ == 0) {
+      throw Exception{errors::Configuration}
+        << "ProductSizeProfiler: the 'sampleEvery' parameter must be "
+           "greater than zero.\n";
+    }
+  }
+
+  void
+  ProductSizeProfiler::write(EventPrincipal& e)
+  {
+    if (eventsSeen_++ % sampleEvery_ != 0) {
+      return;
+    }
+    ++eventsSampled_;
+    for (auto const& [pid, pd] : keptProducts()[InEvent]) {
+      auto& stats = statistics_[pd.branchName()];
+      if (stats.processName.empty()) {
+        stats.processName = pd.processName();
+        stats.moduleLabel = pd.moduleLabel();
+        stats.instanceName = pd.productInstanceName();
+        stats.friendlyClassName = pd.friendlyClassName();
+      }
+      auto const& oh = e.getForOutput(pid, true);
+      EDProduct const* product = oh.isValid() ? oh.wrapper() : nullptr;
+      if (product == nullptr || !product->isPresent()) {
+        continue;
+      }
+      ++stats.present;
+      if (std::uint64_t size{}; numeric_size(product->productSize(), size)) {
+        stats.sizes.fill(size);
+      }
+    }
+  }
+
+  void
+  ProductSizeProfiler::endJob()
+  {
+    using namespace cet::sqlite;
+    Ntuple<std::string,
+           std::string,
+           std::string,
+           std::string,
+           std::string,
+           std::uint32_t,
+           double,
+           double,
+           double,
+           double>
+      table{*db_,
+            "ProductSizes",
+            {{"BranchName",
+              "ProcessName",
+              "ModuleLabel",
+              "InstanceName",
+              "FriendlyClassName",
+              "SampledEvents",
+              "PresenceRate",
+              "MeanSize",
+              "P99Size",
+              "MaxSize"}},
+            overwriteContents_};
+    for (auto const& [branchName, stats] : statistics_) {
+      auto const& sizes = stats.sizes;
+      double mean{};
+      double p99{};
+      double max{};
+      if (!sizes.empty()) {
+        mean = sizes.mean();
+        p99 = sizes.p99();
+        max = sizes.max();
+      }
+      // Every product is seen in at least one sampled event.
+      double const presenceRate =
+        static_cast<double>(stats.present) / eventsSampled_;
+      table.insert(branchName,
+                   stats.processName,
+                   stats.moduleLabel,
+                   stats.instanceName,
+                   stats.friendlyClassName,
+                   static_cast<std::uint32_t>(eventsSampled_),
+                   presenceRate,
+                   mean,
+                   p99,
+                   max);
+    }
+  }
+
+} // namespace art
+
+DEFINE_ART_MODULE(art::ProductSizeProfiler)
@@ -0,0 +1,257 @@
+// ======================================================================
+//
+// SharedMemoryInput: read the runs, subruns and events written by the
+// SharedMemoryOutput module of another art process on the same node.
+//
+// The source attaches to the named shared-memory segment when it is
+// constructed, waiting up to 'attachTimeout' seconds for the writing
+// job to create it, and registers the products listed by the writer.
+// The reconstituted products carry the module labels and instance
+// names of the writing job, but the process name of this one.
+//
+// ======================================================================
+
+#include "art/Framework/Core/InputSourceMacros.h"
+#include "art/Framework/Core/ProductRegistryHelper.h"
+#include "art/Framework/IO/SharedMemory/MessageBuffer.h"
+#include "art/Framework/IO/SharedMemory/ProductCodec.h"
+#include "art/Framework/IO/SharedMemory/SharedMemoryRing.h"
+#include "art/Framework/IO/Sources/Source.h"
+#include "art/Framework/IO/Sources/SourceHelper.h"
+#include "art/Framework/IO/Sources/SourceTraits.h"
+#include "art/Framework/Principal/EventPrincipal.h"
+#include "art/Framework/Principal/RunPrincipal.h"
+#include "art/Framework/Principal/SubRunPrincipal.h"
+#include "canvas/Persistency/Provenance/EventAuxiliary.h"
+#include "canvas/Persistency/Provenance/Timestamp.h"
+#include "canvas/Utilities/Exception.h"
+#include "fhiclcpp/types/Atom.h"
+
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <set>
+#include <string>
+#include <tuple>
+#include <vector>
+
+namespace art {
+
+  class SharedMemoryInputDetail {
+  public:
+    struct Config {
+      fhicl::Atom<std::string> segmentName{
+        fhicl::Name("segmentName"),
+        fhicl::Comment("Name of the shared-memory segment created by the\n"
+                       "SharedMemoryOutput module of the writing job.")};
+      fhicl::Atom<unsigned> attachTimeout{
+        fhicl::Name("attachTimeout"),
+        fhicl::Comment("Time (in seconds) to wait for the writing job to\n"
+                       "create the segment."),
+        60u};
+    };
+    using Parameters = SourceTable<Config>;
+
+    SharedMemoryInputDetail(Parameters const& config,
+                            ProductRegistryHelper& helper,
+                            SourceHelper const& sourceHelper);
+
+    void readFile(std::string const&, FileBlock*& fb);
+    bool readNext(RunPrincipal const* inR,
+                  SubRunPrincipal const* inSR,
+                  RunPrincipal*& outR,
+                  SubRunPrincipal*& outSR,
+                  EventPrincipal*& outE);
+    void closeCurrentFile();
+
+  private:
+    struct Entry {
+      ProductCodec const* codec;
+      std::string moduleLabel;
+      std::string instanceName;
+    };
+
+    void readCatalog_(ProductRegistryHelper& helper);
+    void readRun_(MessageReader& reader);
+    void readSubRun_(MessageReader& reader);
+    EventPrincipal* readEvent_(MessageReader& reader);
+
+    // Hand out the pending Run and SubRun, if any.
+    bool flush_(RunPrincipal*& outR, SubRunPrincipal*& outSR);
+
+    SourceHelper const& sourceHelper_;
+    std::unique_ptr<SharedMemoryRing> ring_;
+    std::vector<Entry> catalog_{};
+    std::vector<char> buffer_{};
+
+    // A new Run or SubRun is held back until either the first event
+    // belonging to it arrives or the next Run or SubRun begins, since
+    // Source does not accept an Event on its own right after a SubRun.
+    std::unique_ptr<RunPrincipal> pendingRun_{};
+    std::unique_ptr<SubRunPrincipal> pendingSubRun_{};
+  };
+
+  template <>
+  struct Source_generator<SharedMemoryInputDetail> {
+    static constexpr bool value = true;
+  };
+
+  SharedMemoryInputDetail::SharedMemoryInputDetail(
+    Parameters const& config,
+    ProductRegistryHelper& helper,
+    SourceHelper const& sourceHelper)
+    : sourceHelper_{sourceHelper}
+    , ring_{SharedMemoryRing::attach(
+        config().segmentName(),
+        std::chrono::seconds{config().attachTimeout()})}
+  {
+    readCatalog_(helper);
+  }
+
+  void
+  SharedMemoryInputDetail::readCatalog_(ProductRegistryHelper& helper)
+  {
+    if (!ring_->read(buffer_)) {
+      throw Exception(errors::FileReadError)
+        << "SharedMemoryInput: the writing job ended without sending its "
+           "product catalog.\n";
+    }
+    MessageReader reader{buffer_};
+    if (reader.get<MessageKind>() != MessageKind::Catalog) {
+      throw Exception(errors::DataCorruption)
+        << "SharedMemoryInput: the stream does not start with a product "
+           "catalog.\n";
+    }
+    auto const n = reader.get<std::uint64_t>();
+    std::set<std::tuple<std::string, std::string, std::string>> registered;
+    for (std::uint64_t i = 0; i != n; ++i) {
+      auto const className = reader.get<std::string>();
+      auto moduleLabel = reader.get<std::string>();
+      auto instanceName = reader.get<std::string>();
+      auto const codec = codecFor(className);
+      if (codec == nullptr) {
+        throw Exception(errors::DataCorruption)
+          << "SharedMemoryInput: the writing job sent a product of the "
+             "unsupported type "
+          << className << ".\n";
+      }
+      // All reconstituted products belong to this process, so products
+      // that differ only in the process name of the writing job would
+      // clash.
+      if (!registered.emplace(className, moduleLabel, instanceName).second) {
+        throw Exception(errors::Configuration)
+          << "SharedMemoryInput: the writing job sends more than one product "
+             "of type "
+          << className << " with module label '" << moduleLabel
+          << "' and instance name '" << instanceName
+          << "'.\nDrop all but one of them in the SharedMemoryOutput "
+             "module.\n";
+      }
+      codec->reconstitutes(helper, moduleLabel, instanceName);
+      catalog_.push_back(
+        {codec, std::move(moduleLabel), std::move(instanceName)});
+    }
+  }
+
+  void
+  SharedMemoryInputDetail::readFile(std::string const&, FileBlock*& fb)
+  {
+    fb = new FileBlock{FileFormatVersion{1, "SharedMemoryInput"}, {}};
+  }
+
+  void
+  SharedMemoryInputDetail::closeCurrentFile()
+  {}
+
+  void
+  SharedMemoryInputDetail::readRun_(MessageReader& reader)
+  {
+    auto const run = reader.get<RunNumber_t>();
+    auto const time = reader.get<TimeValue_t>();
+    pendingRun_.reset(sourceHelper_.makeRunPrincipal(run, Timestamp{time}));
+  }
+
+  void
+  SharedMemoryInputDetail::readSubRun_(MessageReader& reader)
+  {
+    auto const run = reader.get<RunNumber_t>();
+    auto const subRun = reader.get<SubRunNumber_t>();
+    auto const time = reader.get<TimeValue_t>();
+    pendingSubRun_.reset(
+      sourceHelper_.makeSubRunPrincipal(run, subRun, Timestamp{time}));
+  }
+
+  EventPrincipal*
+  SharedMemoryInputDetail::readEvent_(MessageReader& reader)
+  {
+    auto const run = reader.get<RunNumber_t>();
+    auto const subRun = reader.get<SubRunNumber_t>();
+    auto const event = reader.get<EventNumber_t>();
+    auto const time = reader.get<TimeValue_t>();
+    auto const isReal = reader.get<bool>();
+    auto const type = reader.get<EventAuxiliary::ExperimentType>();
+    std::unique_ptr<EventPrincipal> ep{sourceHelper_.makeEventPrincipal(
+      run, subRun, event, Timestamp{time}, isReal, type)};
+    while (!reader.empty()) {
+      auto const index = reader.get<std::uint32_t>();
+      if (index >= catalog_.size()) {
+        throw Exception(errors::DataCorruption)
+          << "SharedMemoryInput: event " << ep->eventID()
+          << " refers to an unknown product.\n";
+      }
+      auto const& [codec, moduleLabel, instanceName] = catalog_[index];
+      codec->put(reader, *ep, moduleLabel, instanceName);
+    }
+    return ep.release();
+  }
+
+  bool
+  SharedMemoryInputDetail::flush_(RunPrincipal*& outR,
+                                  SubRunPrincipal*& outSR)
+  {
+    outR = pendingRun_.release();
+    outSR = pendingSubRun_.release();
+    return outR != nullptr || outSR != nullptr;
+  }
+
+  bool
+  SharedMemoryInputDetail::readNext(RunPrincipal const*,
+                                    SubRunPrincipal const*,
+                                    RunPrincipal*& outR,
+                                    SubRunPrincipal*& outSR,
+                                    EventPrincipal*& outE)
+  {
+    while (ring_->read(buffer_)) {
+      MessageReader reader{buffer_};
+      switch (reader.get<MessageKind>()) {
+      case MessageKind::Run: {
+        bool const flushed = flush_(outR, outSR);
+        readRun_(reader);
+        if (flushed) {
+          return true;
+        }
+        break;
+      }
+      case MessageKind::SubRun: {
+        bool const flushed = pendingSubRun_ && flush_(outR, outSR);
+        readSubRun_(reader);
+        if (flushed) {
+          return true;
+        }
+        break;
+      }
+      case MessageKind::Event:
+        outE = readEvent_(reader);
+        flush_(outR, outSR);
+        return true;
+      default:
+        throw Exception(errors::DataCorruption)
+          << "SharedMemoryInput: unexpected message in the stream.\n";
+      }
+    }
+    return flush_(outR, outSR);
+  }
+
+} // namespace art
+
+DEFINE_ART_INPUT_SOURCE(art::Source<art::SharedMemoryInputDetail>)
@@ -0,0 +1,210 @@
+// ======================================================================
+//
+// SharedMemoryOutput: hand the kept event products to another art
+//                     process on the same node, which reads them with
+//                     the SharedMemoryInput source, instead of going
+//                     through a file.
+//
+// The products are serialized into the slots of a SharedMemoryRing
+// (see art/Framework/IO/SharedMemory); when all slots are full, the
+// writing job waits for the reading job to catch up.  Only event
+// products of the types supported by ProductCodec are transferred;
+// other kept products are reported once and then ignored.  Run and
+// SubRun boundaries are transferred, but not their products.
+//
+// ======================================================================
+
+#include "art/Framework/Core/OutputModule.h"
+#include "art/Framework/IO/SharedMemory/MessageBuffer.h"
+#include "art/Framework/IO/SharedMemory/ProductCodec.h"
+#include "art/Framework/IO/SharedMemory/SharedMemoryRing.h"
+#include "art/Framework/Principal/EventPrincipal.h"
+#include "art/Framework/Principal/RunPrincipal.h"
+#include "art/Framework/Principal/SubRunPrincipal.h"
+#include "canvas/Persistency/Provenance/BranchDescription.h"
+#include "fhiclcpp/types/Atom.h"
+#include "fhiclcpp/types/ConfigurationTable.h"
+#include "fhiclcpp/types/TableFragment.h"
+#include "messagefacility/MessageLogger/MessageLogger.h"
+
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace art {
+
+  class SharedMemoryOutput : public OutputModule {
+  public:
+    struct Config {
+      fhicl::TableFragment<OutputModule::Config> omConfig;
+      fhicl::Atom<std::string> segmentName{
+        fhicl::Name("segmentName"),
+        fhicl::Comment("Name of the shared-memory segment, which must be\n"
+                       "the same as that given to the SharedMemoryInput\n"
+                       "source of the reading job (e.g. \"/art_stage1\").")};
+      fhicl::Atom<unsigned> slots{
+        fhicl::Name("slots"),
+        fhicl::Comment("Number of events that may be in flight between\n"
+                       "the two jobs."),
+        16u};
+      fhicl::Atom<unsigned> slotSizeMB{
+        fhicl::Name("slotSizeMB"),
+        fhicl::Comment("Size of each slot in MiB, which must accommodate\n"
+                       "the serialized products of the largest event."),
+        4u};
+    };
+
+    using Parameters =
+      fhicl::WrappedTable<Config, OutputModule::Config::KeysToIgnore>;
+    explicit SharedMemoryOutput(Parameters const&);
+
+  private:
+    struct Transferred {
+      ProductID pid;
+      ProductCodec const* codec;
+    };
+
+    void postSelectProducts() override;
+    void beginRun(RunPrincipal const&) override;
+    void beginSubRun(SubRunPrincipal const&) override;
+    void write(EventPrincipal& e) override;
+    void
+    writeSubRun(SubRunPrincipal&) override
+    {}
+    void
+    writeRun(RunPrincipal&) override
+    {}
+    void endJob() override;
+
+    void sendCatalog_();
+    void send_();
+
+    std::unique_ptr<SharedMemoryRing> ring_;
+    std::vector<Transferred> transferred_{};
+    bool catalogSent_{false};
+    std::vector<char> buffer_{};
+  }; // SharedMemoryOutput
+
+  SharedMemoryOutput::SharedMemoryOutput(Parameters const& ps)
+    : OutputModule{ps().omConfig}
+    , ring_{SharedMemoryRing::create(ps().segmentName(),
+                                     ps().slots(),
+                                     ps().slotSizeMB() * 1024ull * 1024ull)}
+  {}
+
+  void
+  SharedMemoryOutput::postSelectProducts()
+  {
+    // The reading job registers its products when it is constructed,
+    // so the set of transferred products cannot change once the
+    // catalog has been sent.
+    if (catalogSent_) {
+      return;
+    }
+    transferred_.clear();
+    for (auto const& [pid, pd] : keptProducts()[InEvent]) {
+      if (auto codec = codecFor(pd.producedClassName())) {
+        transferred_.push_back({pid, codec});
+      } else {
+        mf::LogWarning("SharedMemoryOutput")
+          << "Product " << pd.branchName() << " of type "
+          << pd.producedClassName()
+          << " cannot be transferred through shared memory and will be "
+             "ignored.\n";
+      }
+    }
+  }
+
+  void
+  SharedMemoryOutput::sendCatalog_()
+  {
+    buffer_.clear();
+    MessageWriter writer{buffer_};
+    writer.put(MessageKind::Catalog);
+    writer.put(static_cast<std::uint64_t>(transferred_.size()));
+    auto const& kept = keptProducts()[InEvent];
+    for (auto const& [pid, codec] : transferred_) {
+      auto const& pd = kept.at(pid);
+      writer.put(pd.producedClassName());
+      writer.put(pd.moduleLabel());
+      writer.put(pd.productInstanceName());
+    }
+    ring_->write(buffer_);
+    catalogSent_ = true;
+  }
+
+  void
+  SharedMemoryOutput::send_()
+  {
+    if (!catalogSent_) {
+      // The catalog precedes everything else in the stream, but it is
+      // written only now so that the kept products are known.
+      auto message = std::move(buffer_);
+      sendCatalog_();
+      buffer_ = std::move(message);
+    }
+    ring_->write(buffer_);
+  }
+
+  void
+  SharedMemoryOutput::beginRun(RunPrincipal const& rp)
+  {
+    buffer_.clear();
+    MessageWriter writer{buffer_};
+    writer.put(MessageKind::Run);
+    writer.put(rp.runID().run());
+    writer.put(rp.beginTime().value());
+    send_();
+  }
+
+  void
+  SharedMemoryOutput::beginSubRun(SubRunPrincipal const& srp)
+  {
+    buffer_.clear();
+    MessageWriter writer{buffer_};
+    writer.put(MessageKind::SubRun);
+    writer.put(srp.subRunID().run());
+    writer.put(srp.subRunID().subRun());
+    writer.put(srp.beginTime().value());
+    send_();
+  }
+
+  void
+  SharedMemoryOutput::write(EventPrincipal& e)
+  {
+    buffer_.clear();
+    MessageWriter writer{buffer_};
+    writer.put(MessageKind::Event);
+    auto const& id = e.eventID();
+    writer.put(id.run());
+    writer.put(id.subRun());
+    writer.put(id.event());
+    writer.put(e.time().value());
+    writer.put(e.isReal());
+    writer.put(e.ExperimentType());
+    for (std::uint32_t i = 0; i != transferred_.size(); ++i) {
+      auto const& [pid, codec] = transferred_[i];
+      auto const& oh = e.getForOutput(pid, true);
+      EDProduct const* product = oh.isValid() ? oh.wrapper() : nullptr;
+      if (product == nullptr || !product->isPresent()) {
+        continue;
+      }
+      writer.put(i);
+      codec->encode(*product, writer);
+    }
+    send_();
+  }
+
+  void
+  SharedMemoryOutput::endJob()
+  {
+    if (!catalogSent_) {
+      sendCatalog_();
+    }
+    ring_->close();
+  }
+
+} // namespace art
+
+DEFINE_ART_MODULE(art::SharedMemoryOutput)
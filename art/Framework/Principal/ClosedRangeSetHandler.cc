@@ -6,6 +6,7 @@
 #include "canvas/Persistency/Provenance/EventRange.h"
 #include "canvas/Persistency/Provenance/RangeSet.h"
 
+#include <algorithm>
 #include <utility>
 
 namespace art {
@@ -13,6 +14,14 @@ namespace art {
   namespace {
     constexpr auto invalid_eid [[maybe_unused]] =
       IDNumber<Level::Event>::invalid();
+
+    // Whether the range lies entirely before the event.
+    bool
+    precedes(EventRange const& range, EventID const& id)
+    {
+      return range.subRun() < id.subRun() ||
+             (range.subRun() == id.subRun() && range.end() <= id.event());
+    }
   } // unnamed namespace
 
   ClosedRangeSetHandler::EventInfo::~EventInfo() noexcept = default;
@@ -56,7 +65,10 @@ namespace art {
   // Note: RangeSet has a data member that is a vector, and the vector
   // ctor is not noexcept, so we cannot be noexcept either!
   ClosedRangeSetHandler::ClosedRangeSetHandler(RangeSet const& rs)
-    : ranges_{rs}, idx_{0}, eventInfo_{}
+    : ranges_{rs}
+    , idx_{0}
+    , eventInfo_{}
+    , ordered_{rs.is_sorted() && rs.has_disjoint_ranges()}
   {}
 
   // Note: RangeSet has a data member that is a vector, and the vector
@@ -120,8 +132,32 @@ namespace art {
       idx_ = ranges_.next_subrun_or_end(idx_);
       return;
     }
-    while (idx_ != end_idx() &&
-           !ranges_.at(idx_).contains(id.subRun(), id.event())) {
+    auto const end = end_idx();
+    if (idx_ == end || ranges_.at(idx_).contains(id.subRun(), id.event())) {
+      return;
+    }
+    if (ordered_) {
+      // Skip the ranges that precede the event: an exponential search
+      // followed by a binary search.
+      auto lo = idx_;
+      auto hi = idx_;
+      std::size_t step{1};
+      while (hi != end && precedes(ranges_.at(hi), id)) {
+        lo = hi + 1;
+        hi = std::min(end, hi + step);
+        step *= 2;
+      }
+      while (lo < hi) {
+        auto const mid = lo + (hi - lo) / 2;
+        if (precedes(ranges_.at(mid), id)) {
+          lo = mid + 1;
+        } else {
+          hi = mid;
+        }
+      }
+      idx_ = lo;
+    }
+    while (idx_ != end && !ranges_.at(idx_).contains(id.subRun(), id.event())) {
       ++idx_;
     }
   }
@@ -34,6 +34,12 @@
 //      contain only event 4.  In this way, the inherited RangeSet is
 //      preserved across files.
 //
+//      If the inherited ranges are sorted and disjoint, finding the
+//      range of an event that is not in the current range takes a
+//      time logarithmic in the number of ranges skipped, which
+//      matters for inputs made of many small ranges (e.g. the merge
+//      of many files) when events are skipped or filtered on input.
+//
 
 #include "art/Framework/Principal/RangeSetHandler.h"
 #include "canvas/Persistency/Provenance/EventID.h"
@@ -92,6 +98,8 @@ namespace art {
     RangeSet ranges_{RangeSet::invalid()};
     std::size_t idx_{0};
     EventInfo eventInfo_{};
+    // Whether the ranges may be searched by bisection.
+    bool ordered_{false};
   };
 
 } // namespace art
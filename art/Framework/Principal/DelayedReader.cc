@@ -2,10 +2,25 @@
 #include "art/Framework/Principal/Principal.h"
 // vim: set sw=2 expandtab :
 
+#include "canvas/Persistency/Provenance/Parentage.h"
+#include "canvas/Persistency/Provenance/ParentageID.h"
 #include "canvas/Persistency/Provenance/ProductProvenance.h"
+#include "canvas/Persistency/Provenance/ProductStatus.h"
+
+#include <algorithm>
+#include <cassert>
+#include <map>
 
 using namespace std;
 
+namespace {
+  bool
+  by_product_id(art::ProductProvenance const& pp, art::ProductID const id)
+  {
+    return pp.productID() < id;
+  }
+}
+
 namespace art {
 
   DelayedReader::DelayedReader() = default;
@@ -41,6 +56,98 @@ namespace art {
     return {};
   }
 
+  bool
+  DelayedReader::provenanceDeferrable() const
+  {
+    return provenanceDeferrable_();
+  }
+
+  bool
+  DelayedReader::provenanceDeferrable_() const
+  {
+    return false;
+  }
+
+  void
+  DelayedReader::prefetchProvenance() const
+  {
+    call_once(provenanceRead_, [this] {
+      auto provenance = readProvenance_();
+      sort(provenance.begin(),
+           provenance.end(),
+           [](ProductProvenance const& a, ProductProvenance const& b) {
+             return a.productID() < b.productID();
+           });
+      provenance_ = std::move(provenance);
+    });
+  }
+
+  ProductProvenance const*
+  DelayedReader::storedProvenance_(ProductID const pid) const
+  {
+    prefetchProvenance();
+    auto it = lower_bound(
+      provenance_.cbegin(), provenance_.cend(), pid, by_product_id);
+    if (it == provenance_.cend() || it->productID() != pid) {
+      return nullptr;
+    }
+    return &*it;
+  }
+
+  optional<ProductStatus>
+  DelayedReader::productStatus(ProductID const pid) const
+  {
+    auto const pp = storedProvenance_(pid);
+    if (pp == nullptr) {
+      return nullopt;
+    }
+    if (pp->productStatus() == productstatus::unknown()) {
+      // An old format file, see convertOldFormat_.
+      return productstatus::dummyToPreventDoubleCount();
+    }
+    return pp->productStatus();
+  }
+
+  unique_ptr<ProductProvenance const>
+  DelayedReader::productProvenance(ProductID const pid) const
+  {
+    auto const pp = storedProvenance_(pid);
+    if (pp == nullptr) {
+      return nullptr;
+    }
+    if (pp->productStatus() != productstatus::unknown()) {
+      return make_unique<ProductProvenance const>(*pp);
+    }
+    convertOldFormat_();
+    auto it =
+      lower_bound(converted_.cbegin(), converted_.cend(), pid, by_product_id);
+    assert(it != converted_.cend() && it->productID() == pid);
+    return make_unique<ProductProvenance const>(*it);
+  }
+
+  void
+  DelayedReader::convertOldFormat_() const
+  {
+    // We have an old format file, convert.  The provenance of an old
+    // format file carries the parents of each product only through its
+    // parentage, which is looked up once per distinct parentage.
+    call_once(provenanceConverted_, [this] {
+      map<ParentageID, vector<ProductID>> parents;
+      for (auto const& pp : provenance_) {
+        if (pp.productStatus() != productstatus::unknown()) {
+          continue;
+        }
+        auto const [it, inserted] = parents.try_emplace(pp.parentageID());
+        if (inserted) {
+          it->second = pp.parentage().parents();
+        }
+        converted_.emplace_back(pp.productID(),
+                                productstatus::dummyToPreventDoubleCount(),
+                                it->second);
+      }
+    });
+  }
+
   bool
   DelayedReader::isAvailableAfterCombine(ProductID pid) const
   {
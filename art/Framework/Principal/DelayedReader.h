@@ -12,10 +12,14 @@
 #include "art/Framework/Principal/fwd.h"
 #include "canvas/Persistency/Common/EDProduct.h"
 #include "canvas/Persistency/Provenance/ProductID.h"
+#include "canvas/Persistency/Provenance/ProductProvenance.h"
+#include "canvas/Persistency/Provenance/ProductStatus.h"
 #include "canvas/Persistency/Provenance/fwd.h"
 #include "cetlib/exempt_ptr.h"
 
 #include <memory>
+#include <mutex>
+#include <optional>
 #include <vector>
 
 namespace art {
@@ -33,14 +37,42 @@ namespace art {
     bool isAvailableAfterCombine(ProductID) const;
     std::unique_ptr<Principal> readFromSecondaryFile(int& idx);
 
+    // The provenance of all products is read at once, and kept, when
+    // it is first needed.  If the reader cannot read it from any
+    // thread without the input source lock held, it must instead be
+    // prefetched, with the lock held, when the principal is
+    // constructed.
+    bool provenanceDeferrable() const;
+    void prefetchProvenance() const;
+    // The status of the given product according to its provenance, or
+    // nothing if the input has no provenance for it.  Unlike
+    // productProvenance, this never requires the product's parentage.
+    std::optional<ProductStatus> productStatus(ProductID) const;
+    // The provenance of the given product, or nullptr if the input
+    // has none.  The provenance of old-format files is converted, for
+    // all products at once, the first time this is called for one of
+    // them; this looks up the parentage of each product.
+    std::unique_ptr<ProductProvenance const> productProvenance(
+      ProductID) const;
+
   private:
     virtual std::unique_ptr<EDProduct> getProduct_(Group const*,
                                                    ProductID,
                                                    RangeSet&) const = 0;
     virtual void setPrincipal_(cet::exempt_ptr<Principal>);
     virtual std::vector<ProductProvenance> readProvenance_() const;
+    virtual bool provenanceDeferrable_() const;
     virtual bool isAvailableAfterCombine_(ProductID) const;
     virtual std::unique_ptr<Principal> readFromSecondaryFile_(int& idx);
+
+    ProductProvenance const* storedProvenance_(ProductID) const;
+    void convertOldFormat_() const;
+
+    // Both sorted by product ID.
+    mutable std::vector<ProductProvenance> provenance_{};
+    mutable std::once_flag provenanceRead_{};
+    mutable std::vector<ProductProvenance> converted_{};
+    mutable std::once_flag provenanceConverted_{};
   };
 
 } // namespace art
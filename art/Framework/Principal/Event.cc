@@ -4,6 +4,7 @@
 #include "art/Framework/Principal/EventPrincipal.h"
 #include "art/Framework/Principal/SubRun.h"
 #include "art/Framework/Principal/SubRunPrincipal.h"
+#include "art/Utilities/Globals.h"
 #include "canvas/Persistency/Provenance/BranchType.h"
 
 namespace art {
@@ -13,7 +14,11 @@ namespace art {
   Event::Event(EventPrincipal const& ep,
                ModuleContext const& mc,
                std::optional<ProductInserter> inserter)
-    : ProductRetriever{InEvent, ep, mc, inserter.has_value()}
+    : ProductRetriever{InEvent,
+                       ep,
+                       mc,
+                       inserter.has_value() &&
+                         Globals::instance()->recordProvenance()}
     , inserter_{std::move(inserter)}
     , eventPrincipal_{ep}
     , subRun_{ep.subRunPrincipal().makeSubRun(mc)}
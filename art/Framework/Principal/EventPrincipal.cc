@@ -1,5 +1,6 @@
 #include "art/Framework/Principal/EventPrincipal.h"
 #include "art/Framework/Principal/Event.h"
+#include "art/Utilities/Globals.h"
 
 // vim: set sw=2 expandtab :
 
@@ -116,6 +117,8 @@ namespace art {
     ProductTables const& producedProducts)
   {
     Principal::createGroupsForProducedProducts(producedProducts);
-    refreshProcessHistoryID();
+    if (Globals::instance()->recordProvenance()) {
+      refreshProcessHistoryID();
+    }
   }
 } // namespace art
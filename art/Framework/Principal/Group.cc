@@ -2,6 +2,7 @@
 // vim: set sw=2 expandtab :
 
 #include "art/Framework/Principal/DelayedReader.h"
+#include "art/Framework/Principal/RangeSetsSupported.h"
 #include "canvas/Persistency/Common/WrappedTypeID.h"
 #include "canvas/Persistency/Provenance/BranchDescription.h"
 #include "canvas/Persistency/Provenance/BranchType.h"
@@ -17,11 +18,34 @@ namespace art {
 
   using namespace detail;
 
+  namespace {
+    RangeSet*
+    shared_invalid_range_set()
+    {
+      static RangeSet invalid{RangeSet::invalid()};
+      return &invalid;
+    }
+
+    RangeSet*
+    adopt(unique_ptr<RangeSet>&& rs)
+    {
+      return rs ? rs.release() : shared_invalid_range_set();
+    }
+
+    void
+    release(RangeSet* const rs)
+    {
+      if (rs != shared_invalid_range_set()) {
+        delete rs;
+      }
+    }
+  }
+
   Group::~Group()
   {
     delete productProvenance_.load();
     delete product_.load();
-    delete rangeSet_.load();
+    release(rangeSet_.load());
     delete partnerProduct_.load();
     delete baseProduct_.load();
     delete partnerBaseProduct_.load();
@@ -35,7 +59,7 @@ namespace art {
     : branchDescription_{bd}
     , delayedReader_{reader}
     , product_{edp.release()}
-    , rangeSet_{rs.release()}
+    , rangeSet_{adopt(std::move(rs))}
     , grpType_{gt}
   {}
 
@@ -145,10 +169,35 @@ namespace art {
   Group::productProvenance() const
   {
     std::lock_guard sentry{mutex_};
+    return provenance_();
+  }
+
+  ProductProvenance const*
+  Group::provenance_() const
+  {
+    if (!provenanceResolved_) {
+      // A produced product has no provenance until it is put.
+      if (!branchDescription_.produced()) {
+        productProvenance_ =
+          delayedReader_->productProvenance(productID()).release();
+      }
+      provenanceResolved_ = true;
+    }
     return productProvenance_.load();
   }
 
-  // Called by Principal::ctor_read_provenance()
+  std::optional<ProductStatus>
+  Group::provenanceStatus_() const
+  {
+    if (provenanceResolved_ || branchDescription_.produced()) {
+      if (auto const pp = productProvenance_.load()) {
+        return pp->productStatus();
+      }
+      return std::nullopt;
+    }
+    return delayedReader_->productStatus(productID());
+  }
+
   // Called by Principal::insert_pp
   //   Called by RootDelayedReader::getProduct_
   void
@@ -157,6 +206,7 @@ namespace art {
     std::lock_guard sentry{mutex_};
     delete productProvenance_.load();
     productProvenance_ = pp.release();
+    provenanceResolved_ = true;
   }
 
   // Called by Principal::put
@@ -168,10 +218,11 @@ namespace art {
     std::lock_guard sentry{mutex_};
     delete productProvenance_.load();
     productProvenance_ = pp.release();
+    provenanceResolved_ = true;
     delete product_.load();
     product_ = edp.release();
-    delete rangeSet_.load();
-    rangeSet_ = rs.release();
+    release(rangeSet_.load());
+    rangeSet_ = adopt(std::move(rs));
   }
 
   void
@@ -198,8 +249,8 @@ namespace art {
     baseProduct_ = nullptr;
     delete partnerBaseProduct_.load();
     partnerBaseProduct_ = nullptr;
-    delete rangeSet_.load();
-    rangeSet_ = new RangeSet{RangeSet::invalid()};
+    release(rangeSet_.load());
+    rangeSet_ = shared_invalid_range_set();
   }
 
   bool
@@ -219,7 +270,8 @@ namespace art {
         delayedReader_->isAvailableAfterCombine(branchDescription_.productID());
     }
     auto status = productstatus::uninitialized();
-    if (productProvenance_.load() == nullptr) {
+    auto const pp_status = provenanceStatus_();
+    if (!pp_status) {
       // No provenance, must be a produced product which has not been
       // put yet, or a non-produced product that is available after
       // combine (agggregation) and not yet read, or a non-produced
@@ -248,7 +300,7 @@ namespace art {
     } else {
       // Not a produced product, and not yet delay read, use the status
       // from the on-file provenance.
-      status = productProvenance_.load()->productStatus();
+      status = *pp_status;
     }
     if ((branchDescription_.branchType() == InSubRun) ||
         (branchDescription_.branchType() == InRun)) {
@@ -302,6 +354,12 @@ namespace art {
       // Note: This may call back to us to update the product
       // provenance if run or subRun data product merging creates a
       // new provenance.
+      // Note: The reader sets the range of validity of run and subRun
+      //       products, which therefore may not be the shared one.
+      if (range_sets_supported(branchDescription_.branchType()) &&
+          rangeSet_.load() == shared_invalid_range_set()) {
+        rangeSet_ = new RangeSet{RangeSet::invalid()};
+      }
       product_ =
         delayedReader_
           ->getProduct(this, branchDescription_.productID(), *rangeSet_.load())
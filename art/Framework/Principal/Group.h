@@ -14,6 +14,7 @@
 #include "canvas/Persistency/Common/fwd.h"
 #include "canvas/Persistency/Provenance/ProductID.h"
 #include "canvas/Persistency/Provenance/ProductProvenance.h"
+#include "canvas/Persistency/Provenance/ProductStatus.h"
 #include "canvas/Persistency/Provenance/RangeSet.h"
 #include "canvas/Persistency/Provenance/fwd.h"
 #include "canvas/Utilities/TypeID.h"
@@ -33,6 +34,9 @@ namespace art {
 
     enum class grouptype { normal = 0, assns = 1, assnsWithData = 2 };
 
+    // A null range set stands for RangeSet::invalid(), which is the
+    // range of validity of every event product; no RangeSet is then
+    // allocated for the group.
     Group(DelayedReader*,
           BranchDescription const&,
           std::unique_ptr<RangeSet>&&,
@@ -60,7 +64,6 @@ namespace art {
 
     // Setting internal product provenance and product pointers.
 
-    // Called by Principal::ctor_read_provenance()
     // Called by Principal::insert_pp
     //   Called by RootDelayedReader::getProduct_
     void setProductProvenance(std::unique_ptr<ProductProvenance const>&&);
@@ -71,6 +74,14 @@ namespace art {
                                  std::unique_ptr<RangeSet>&&);
 
   private:
+    // The product provenance, which for a product from the input is
+    // looked up when first needed.  Requires mutex_ to be held.
+    ProductProvenance const* provenance_() const;
+    // The status from the product provenance, or nothing if there is
+    // no provenance.  Unlike provenance_, this does not resolve the
+    // product's parentage.  Requires mutex_ to be held.
+    std::optional<ProductStatus> provenanceStatus_() const;
+
     BranchDescription const& branchDescription_;
 
     // Back pointer to the delayed reader in the principal that owns
@@ -86,9 +97,13 @@ namespace art {
     // pointers together one atomic transaction.
     mutable std::recursive_mutex mutex_{};
     // The product provenance for the data product.
-    // Note: Modified by setProductProvenance (called by Principal ctors and
-    // Principal::insert_pp (called by Principal::put).
-    std::atomic<ProductProvenance const*> productProvenance_{nullptr};
+    // Note: Modified by provenance_, by setProductProvenance (called by
+    // Principal::insert_pp), and by setProductAndProvenance (called by
+    // Principal::put).
+    mutable std::atomic<ProductProvenance const*> productProvenance_{nullptr};
+    // Whether productProvenance_ no longer needs to be looked up in
+    // the delayed reader.
+    mutable bool provenanceResolved_{false};
     // The wrapped data product itself.
     // Note: Modified by setProduct (called by Principal::put)
     // Note: Modified by removeCachedProduct.
@@ -97,6 +112,8 @@ namespace art {
     // Note: Modified by setProduct (called by Principal put).
     // Note: Modified by removeCachedProduct.
     // Note: Modified by resolveProductIfAvailable.
+    // Note: Points to a RangeSet shared by all groups (which must not
+    //       be modified) if the range of validity is invalid.
     mutable std::atomic<RangeSet*> rangeSet_;
     // Are we normal, assns, or assnsWithData?
     grouptype const grpType_;
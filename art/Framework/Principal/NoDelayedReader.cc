@@ -20,4 +20,11 @@ namespace art {
       << "getProduct() called for ProductID: " << pid << '\n';
   }
 
+  bool
+  NoDelayedReader::provenanceDeferrable_() const
+  {
+    // There is no provenance to read.
+    return true;
+  }
+
 } // namespace art
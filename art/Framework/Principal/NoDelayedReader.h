@@ -20,6 +20,7 @@ namespace art {
     [[noreturn]] std::unique_ptr<EDProduct> getProduct_(Group const*,
                                                         ProductID,
                                                         RangeSet&) const;
+    bool provenanceDeferrable_() const override;
   };
 
 } // namespace art
@@ -11,6 +11,7 @@
 #include "art/Persistency/Common/GroupQueryResult.h"
 #include "art/Persistency/Provenance/ModuleContext.h"
 #include "art/Persistency/Provenance/ProcessHistoryRegistry.h"
+#include "art/Utilities/Globals.h"
 #include "canvas/Persistency/Common/WrappedTypeID.h"
 #include "canvas/Persistency/Provenance/BranchDescription.h"
 #include "canvas/Persistency/Provenance/BranchType.h"
@@ -27,6 +28,8 @@
 #include "cetlib/container_algorithms.h"
 #include "cetlib/exempt_ptr.h"
 #include "range/v3/view.hpp"
+#include "tbb/parallel_for_each.h"
+#include "tbb/task_arena.h"
 
 #include <atomic>
 #include <cassert>
@@ -40,6 +43,17 @@ using namespace std;
 
 namespace {
   std::string const indent(2, ' ');
+
+  art::GroupQueryResult
+  not_found(art::WrappedTypeID const& wrapped, art::SelectorBase const& sel)
+  {
+    auto whyFailed =
+      std::make_shared<art::Exception>(art::errors::ProductNotFound);
+    *whyFailed << "Found zero products matching all selection criteria\n"
+               << indent << "C++ type: " << wrapped.product_type << '\n'
+               << sel.print(indent) << '\n';
+    return art::GroupQueryResult{whyFailed};
+  }
 }
 
 namespace art {
@@ -58,8 +72,7 @@ namespace art {
           gt = Group::grouptype::assnsWithData;
         }
       }
-      return make_unique<Group>(
-        reader, bd, make_unique<RangeSet>(RangeSet::invalid()), gt);
+      return make_unique<Group>(reader, bd, nullptr, gt);
     }
 
   } // unnamed namespace
@@ -88,20 +101,12 @@ namespace art {
   void
   Principal::ctor_read_provenance()
   {
-    for (auto&& provenance : delayedReader_->readProvenance()) {
-      auto g = getGroupLocal(provenance.productID());
-      if (g.get() == nullptr) {
-        continue;
-      }
-      if (provenance.productStatus() != productstatus::unknown()) {
-        g->setProductProvenance(make_unique<ProductProvenance>(provenance));
-      } else {
-        // We have an old format file, convert.
-        g->setProductProvenance(make_unique<ProductProvenance>(
-          provenance.productID(),
-          productstatus::dummyToPreventDoubleCount(),
-          provenance.parentage().parents()));
-      }
+    // Each group looks up its provenance when it is first needed, at
+    // which point the reader reads that of all products.  Readers
+    // that need the input source lock to do so, which is held now,
+    // read it here instead.
+    if (!delayedReader_->provenanceDeferrable()) {
+      delayedReader_->prefetchProvenance();
     }
   }
 
@@ -231,12 +236,9 @@ namespace art {
     //
     // Note: The input source lock will be held when this routine is called.
     //
-    // MT-TODO: For right now ignore the delay reading option for
-    //          product provenance. If we do the delay reading then we
-    //          must use a lock to interlock all fetches of provenance
-    //          because the delay read fills the pp_by_pid_ one entry
-    //          at a time, and we do not want other threads to find
-    //          the info only partly there.
+    // Note: The provenance is read as a whole by the delayed reader
+    //       when the first group asks for it, so no group can see
+    //       it partly read.
     std::lock_guard sentry{groupMutex_};
     for (auto const& group : groups_ | ::ranges::views::values) {
       group->resolveProductIfAvailable();
@@ -297,14 +299,8 @@ namespace art {
   cet::exempt_ptr<ProductProvenance const>
   Principal::branchToProductProvenance(ProductID const& pid) const
   {
-    // Note: The input source lock will be held when this routine is called.
-    //
-    // MT-TODO: For right now ignore the delay reading option for
-    //          product provenance. If we do the delay reading then we
-    //          must use a lock to interlock all fetches of provenance
-    //          because the delay read fills the pp_by_pid_ one entry
-    //          at a time, and we do not want other threads to find
-    //          the info only partly there.
+    // Note: The provenance of a product from the input is looked up
+    //       by its group when first needed.
     cet::exempt_ptr<ProductProvenance const> ret;
     auto g = getGroupLocal(pid);
     if (g.get() != nullptr) {
@@ -444,6 +440,11 @@ namespace art {
         }
       }
       processHistory_.push_back(processConfiguration_);
+      if (!Globals::instance()->recordProvenance()) {
+        // Nothing will be written, so the history need not be
+        // registered, and its ID is computed only on request.
+        return;
+      }
       // Optimization note: As of 0_9_0_pre3 For very simple Sources
       // (e.g. EmptyEvent) this routine takes up nearly 50% of the
       // time per event, and 96% of the time for this routine is spent
@@ -493,15 +494,64 @@ namespace art {
     auto const groups = findGroupsForProduct(mc, wrapped, sel, processTag);
     auto const result = resolve_unique_product(groups, wrapped);
     if (!result.has_value()) {
-      auto whyFailed = std::make_shared<Exception>(errors::ProductNotFound);
-      *whyFailed << "Found zero products matching all selection criteria\n"
-                 << indent << "C++ type: " << wrapped.product_type << '\n'
-                 << sel.print(indent) << '\n';
-      return GroupQueryResult{whyFailed};
+      return not_found(wrapped, sel);
     }
     return *result;
   }
 
+  std::vector<GroupQueryResult>
+  Principal::getBySelectors(ModuleContext const& mc,
+                            std::vector<ProductQuery> const& queries) const
+  {
+    std::vector<std::vector<cet::exempt_ptr<Group>>> groups;
+    groups.reserve(queries.size());
+    for (auto const& q : queries) {
+      groups.push_back(
+        findGroupsForProduct(mc, q.wrapped, q.selector, q.processTag));
+    }
+
+    // The groups are ordered by reverse process history, and the
+    // first process with a match wins: the groups of that process are
+    // the ones resolve_unique_product will try first.
+    std::vector<std::pair<cet::exempt_ptr<Group>, TypeID>> to_resolve;
+    for (std::size_t i = 0, n = queries.size(); i != n; ++i) {
+      auto const& candidates = groups[i];
+      if (candidates.empty()) {
+        continue;
+      }
+      auto const& process =
+        candidates.front()->productDescription().processName();
+      for (auto const group : candidates) {
+        if (group->productDescription().processName() != process) {
+          break;
+        }
+        to_resolve.emplace_back(group,
+                                queries[i].wrapped.wrapped_product_type);
+      }
+    }
+    if (to_resolve.size() > 1) {
+      // Isolated so that the waiting thread does not pick up unrelated
+      // tasks (e.g. modules processing other events).
+      tbb::this_task_arena::isolate([&to_resolve] {
+        tbb::parallel_for_each(to_resolve, [](auto const& pr) {
+          pr.first->resolveProductIfAvailable(pr.second);
+        });
+      });
+    }
+
+    std::vector<GroupQueryResult> results;
+    results.reserve(queries.size());
+    for (std::size_t i = 0, n = queries.size(); i != n; ++i) {
+      auto const& q = queries[i];
+      if (auto result = resolve_unique_product(groups[i], q.wrapped)) {
+        results.push_back(std::move(*result));
+      } else {
+        results.push_back(not_found(q.wrapped, q.selector));
+      }
+    }
+    return results;
+  }
+
   GroupQueryResult
   Principal::getByLabel(ModuleContext const& mc,
                         WrappedTypeID const& wrapped,
@@ -731,10 +781,7 @@ namespace art {
           << "Problem found during put of " << branchType_
           << " product: product already put for " << bd.branchName() << '\n';
       }
-      group->setProductAndProvenance(
-        std::move(pp),
-        std::move(edp),
-        make_unique<RangeSet>(RangeSet::invalid()));
+      group->setProductAndProvenance(std::move(pp), std::move(edp), nullptr);
     }
   }
 
@@ -93,6 +93,17 @@ namespace art {
                                           SelectorBase const&,
                                           ProcessTag const&) const;
 
+    // Equivalent to one getBySelector call per query, except that
+    // the products to be read from input are read concurrently.
+    struct ProductQuery {
+      WrappedTypeID const& wrapped;
+      SelectorBase const& selector;
+      ProcessTag const& processTag;
+    };
+    std::vector<GroupQueryResult> getBySelectors(
+      ModuleContext const& mc,
+      std::vector<ProductQuery> const& queries) const;
+
     std::vector<InputTag> getInputTags(ModuleContext const& mc,
                                        WrappedTypeID const& wrapped,
                                        SelectorBase const&,
@@ -7,6 +7,7 @@
 #include "art/Framework/Principal/Selector.h"
 #include "art/Persistency/Provenance/ModuleContext.h"
 #include "art/Persistency/Provenance/ProcessHistoryRegistry.h"
+#include "art/Utilities/Globals.h"
 #include "canvas/Persistency/Provenance/Parentage.h"
 #include "canvas/Persistency/Provenance/ProductID.h"
 #include "canvas/Persistency/Provenance/ProductProvenance.h"
@@ -72,13 +73,16 @@ namespace art {
       }
     }
 
+    // Without recorded provenance, the products get no parentage,
+    // which would otherwise be registered for each product.
+    bool const recordParents = Globals::instance()->recordProvenance();
     for (auto&& [product, pd, rs] : putProducts_ | ::ranges::views::values) {
-      auto pp = make_unique<ProductProvenance const>(
-        pd.productID(), productstatus::present(), retrievedPIDs);
-      principal_->put(pd,
-                      std::move(pp),
-                      std::move(product),
-                      make_unique<RangeSet>(RangeSet::invalid()));
+      auto pp = recordParents ?
+                  make_unique<ProductProvenance const>(
+                    pd.productID(), productstatus::present(), retrievedPIDs) :
+                  make_unique<ProductProvenance const>(
+                    pd.productID(), productstatus::present());
+      principal_->put(pd, std::move(pp), std::move(product), nullptr);
     }
     putProducts_.clear();
   }
@@ -93,7 +97,7 @@ namespace art {
                                                      productstatus::present());
       auto rs = detail::range_sets_supported(branchType_) ?
                   make_unique<RangeSet>(std::move(range_set)) :
-                  make_unique<RangeSet>(RangeSet::invalid());
+                  unique_ptr<RangeSet>{};
       principal_->put(pd, std::move(pp), std::move(product), std::move(rs));
     }
     putProducts_.clear();
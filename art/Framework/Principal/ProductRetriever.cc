@@ -219,6 +219,46 @@ namespace art {
     return qr;
   }
 
+  std::vector<GroupQueryResult>
+  ProductRetriever::getByLabels_(std::vector<LabelQuery> const& queries) const
+  {
+    std::lock_guard lock{mutex_};
+    std::vector<ProcessTag> processTags;
+    std::vector<Selector> selectors;
+    processTags.reserve(queries.size());
+    selectors.reserve(queries.size());
+    for (auto const& [wrapped, tag] : queries) {
+      auto const& processTag =
+        processTags.emplace_back(tag.process(), md_.processName());
+      ProductInfo const pinfo{ProductInfo::ConsumableType::Product,
+                              wrapped.product_type,
+                              tag.label(),
+                              tag.instance(),
+                              processTag};
+      ConsumesInfo::instance()->validateConsumedProduct(
+        branchType_, md_, pinfo);
+      selectors.emplace_back(ModuleLabelSelector{tag.label()} &&
+                             ProductInstanceNameSelector{tag.instance()} &&
+                             ProcessNameSelector{processTag.name()});
+    }
+
+    std::vector<Principal::ProductQuery> principal_queries;
+    principal_queries.reserve(queries.size());
+    for (std::size_t i = 0, n = queries.size(); i != n; ++i) {
+      principal_queries.push_back(
+        {queries[i].wrapped, selectors[i], processTags[i]});
+    }
+    auto qrs = principal_.getBySelectors(mc_, principal_queries);
+    if (recordParents_) {
+      for (auto const& qr : qrs) {
+        if (qr.succeeded() && !qr.failed()) {
+          recordAsParent_(qr.result());
+        }
+      }
+    }
+    return qrs;
+  }
+
   GroupQueryResult
   ProductRetriever::getBySelector_(WrappedTypeID const& wrapped,
                                    SelectorBase const& sel) const
@@ -33,6 +33,7 @@
 #include <ostream>
 #include <set>
 #include <string>
+#include <tuple>
 #include <utility>
 #include <vector>
 
@@ -86,6 +87,24 @@ namespace art {
     template <typename PROD>
     ValidHandle<PROD> getValidHandle(ProductToken<PROD> const& token) const;
 
+    // Bulk product retrieval: equivalent to one getHandle (or
+    // getValidHandle) call per token, but the products are looked up
+    // under a single lock acquisition, and those to be read from input
+    // are read concurrently.  Preferred for modules that consume many
+    // products, e.g.:
+    //
+    //   auto const [hits, tracks] = e.getValidHandles(hitsToken_,
+    //                                                 tracksToken_);
+    template <typename... PRODS>
+    std::tuple<Handle<PRODS>...> getHandles(
+      ProductToken<PRODS> const&... tokens) const;
+    template <typename PROD>
+    std::vector<Handle<PROD>> getHandles(
+      std::vector<ProductToken<PROD>> const& tokens) const;
+    template <typename... PRODS>
+    std::tuple<ValidHandle<PRODS>...> getValidHandles(
+      ProductToken<PRODS> const&... tokens) const;
+
     // Multiple product retrievals
     template <typename PROD>
     std::vector<InputTag> getInputTags(
@@ -176,6 +195,12 @@ namespace art {
                                         SelectorBase const& selector) const;
     GroupQueryResult getByLabel_(WrappedTypeID const& wrapped,
                                  InputTag const& tag) const;
+    struct LabelQuery {
+      WrappedTypeID wrapped;
+      InputTag const& tag;
+    };
+    std::vector<GroupQueryResult> getByLabels_(
+      std::vector<LabelQuery> const& queries) const;
     GroupQueryResult getBySelector_(WrappedTypeID const& wrapped,
                                     SelectorBase const& selector) const;
     GroupQueryResult getByProductID_(ProductID productID) const;
@@ -278,6 +303,49 @@ namespace art {
     return getValidHandle<PROD>(token.inputTag());
   }
 
+  template <typename... PRODS>
+  std::tuple<Handle<PRODS>...>
+  ProductRetriever::getHandles(ProductToken<PRODS> const&... tokens) const
+  {
+    auto const qrs = getByLabels_(
+      {LabelQuery{WrappedTypeID::make<PRODS>(), tokens.inputTag()}...});
+    // The elements of a braced initializer list are evaluated in
+    // order.
+    auto it = qrs.cbegin();
+    return std::tuple<Handle<PRODS>...>{Handle<PRODS>{*it++}...};
+  }
+
+  template <typename PROD>
+  std::vector<Handle<PROD>>
+  ProductRetriever::getHandles(
+    std::vector<ProductToken<PROD>> const& tokens) const
+  {
+    std::vector<LabelQuery> queries;
+    queries.reserve(tokens.size());
+    for (auto const& token : tokens) {
+      queries.push_back({WrappedTypeID::make<PROD>(), token.inputTag()});
+    }
+    auto const qrs = getByLabels_(queries);
+    std::vector<Handle<PROD>> handles;
+    handles.reserve(qrs.size());
+    cet::transform_all(qrs, back_inserter(handles), [](auto const& qr) {
+      return Handle<PROD>{qr};
+    });
+    return handles;
+  }
+
+  template <typename... PRODS>
+  std::tuple<ValidHandle<PRODS>...>
+  ProductRetriever::getValidHandles(ProductToken<PRODS> const&... tokens) const
+  {
+    return std::apply(
+      [](auto const&... hs) {
+        return std::tuple<ValidHandle<PRODS>...>{ValidHandle<PRODS>{
+          hs.product(), hs.productGetter(), *hs.provenance()}...};
+      },
+      getHandles(tokens...));
+  }
+
   template <typename PROD>
   std::vector<InputTag>
   ProductRetriever::getInputTags(SelectorBase const& selector) const
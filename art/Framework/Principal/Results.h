@@ -31,11 +31,13 @@ namespace art {
     Results& operator=(Results&&) = delete;
 
     using ProductRetriever::getHandle;
+    using ProductRetriever::getHandles;
     using ProductRetriever::getInputTags;
     using ProductRetriever::getMany;
     using ProductRetriever::getProduct;
     using ProductRetriever::getProductTokens;
     using ProductRetriever::getValidHandle;
+    using ProductRetriever::getValidHandles;
     using ProductRetriever::getView;
 
     using ProductRetriever::getProcessParameterSet;
@@ -58,11 +58,13 @@ namespace art {
     ProcessHistory const& processHistory() const;
 
     using ProductRetriever::getHandle;
+    using ProductRetriever::getHandles;
     using ProductRetriever::getInputTags;
     using ProductRetriever::getMany;
     using ProductRetriever::getProduct;
     using ProductRetriever::getProductTokens;
     using ProductRetriever::getValidHandle;
+    using ProductRetriever::getValidHandles;
     using ProductRetriever::getView;
 
     Run const& getRun() const;
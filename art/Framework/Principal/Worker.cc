@@ -6,14 +6,16 @@
 #include "art/Framework/Principal/RunPrincipal.h"
 #include "art/Framework/Principal/SubRunPrincipal.h"
 #include "art/Framework/Principal/WorkerParams.h"
+#include "art/Framework/Principal/detail/EventBatcher.h"
 #include "art/Framework/Services/Registry/ActivityRegistry.h"
 #include "art/Persistency/Provenance/ModuleContext.h"
 #include "art/Persistency/Provenance/ModuleDescription.h"
+#include "art/Utilities/ResourceQueue.h"
 #include "art/Utilities/TaskDebugMacros.h"
 #include "art/Utilities/Transition.h"
+#include "art/Utilities/WaitingTaskHolder.h"
 #include "canvas/Utilities/Exception.h"
 #include "cetlib_except/exception.h"
-#include "hep_concurrency/SerialTaskQueueChain.h"
 #include "hep_concurrency/WaitingTask.h"
 #include "hep_concurrency/WaitingTaskList.h"
 #include "messagefacility/MessageLogger/MessageLogger.h"
@@ -30,6 +32,18 @@ using namespace std;
 using mf::LogError;
 
 namespace {
+  void
+  increment(std::atomic<std::size_t>& counter)
+  {
+    counter.fetch_add(1, std::memory_order_relaxed);
+  }
+
+  std::size_t
+  value_of(std::atomic<std::size_t> const& counter)
+  {
+    return counter.load(std::memory_order_relaxed);
+  }
+
   std::string
   brief_context(art::ModuleDescription const& md)
   {
@@ -99,6 +113,26 @@ namespace {
              brief_module_context;
     }
   }
+
+  // A copy of the exception held by 'eptr' if it is a cet::exception,
+  // to which the context of one event may be added without affecting
+  // the other holders; other exceptions are never modified.
+  std::exception_ptr
+  copy_of(std::exception_ptr const& eptr)
+  {
+    try {
+      rethrow_exception(eptr);
+    }
+    catch (art::Exception const& e) {
+      return make_exception_ptr(e);
+    }
+    catch (cet::exception const& e) {
+      return make_exception_ptr(e);
+    }
+    catch (...) {
+      return eptr;
+    }
+  }
 }
 
 namespace art {
@@ -110,6 +144,7 @@ namespace art {
     , md_{md}
     , actions_{wp.actions_}
     , actReg_{wp.actReg_}
+    , taskGroup_{wp.taskGroup_}
     , waitingTasks_{wp.taskGroup_}
   {
     TDEBUG_FUNC_SI(5, wp.scheduleID_)
@@ -136,10 +171,44 @@ namespace art {
     return returnCode_.load();
   }
 
-  SerialTaskQueueChain*
-  Worker::serialTaskQueueChain() const
+  detail::ResourceQueue*
+  Worker::resourceQueue() const
   {
-    return doSerialTaskQueueChain();
+    return doResourceQueue();
+  }
+
+  detail::EventBatcher*
+  Worker::eventBatcher() const
+  {
+    return doEventBatcher();
+  }
+
+  // Only modules that declare external work override these.
+  bool
+  Worker::doHasAcquire() const
+  {
+    return false;
+  }
+
+  void
+  Worker::doAcquire(EventPrincipal&, ModuleContext const&, WaitingTaskHolder)
+  {}
+
+  // Only batched modules override these.
+  detail::EventBatcher*
+  Worker::doEventBatcher() const
+  {
+    return nullptr;
+  }
+
+  vector<bool>
+  Worker::doProcessBatch(vector<detail::BatchEntry> const& batch)
+  {
+    vector<bool> result;
+    for (auto const& [worker, p, mc] : batch) {
+      result.push_back(worker->doProcess(*p, *mc));
+    }
+    return result;
   }
 
   // Used by EventProcessor
@@ -157,39 +226,49 @@ namespace art {
     returnCode_ = false;
   }
 
+  Worker::CountsSnapshot
+  Worker::countsSnapshot() const
+  {
+    return {value_of(counts_.visited),
+            value_of(counts_.run),
+            value_of(counts_.passed),
+            value_of(counts_.failed),
+            value_of(counts_.thrown)};
+  }
+
   // Used only by writeSummary
   size_t
   Worker::timesVisited() const
   {
-    return counts_visited_.load();
+    return value_of(counts_.visited);
   }
 
   // Used only by writeSummary
   size_t
   Worker::timesRun() const
   {
-    return counts_run_.load();
+    return value_of(counts_.run);
   }
 
   // Used only by writeSummary
   size_t
   Worker::timesPassed() const
   {
-    return counts_passed_.load();
+    return value_of(counts_.passed);
   }
 
   // Used only by writeSummary
   size_t
   Worker::timesFailed() const
   {
-    return counts_failed_.load();
+    return value_of(counts_.failed);
   }
 
   // Used only by writeSummary
   size_t
   Worker::timesExcept() const
   {
-    return counts_thrown_.load();
+    return value_of(counts_.thrown);
   }
 
   void
@@ -365,7 +444,7 @@ namespace art {
   void
   Worker::doWork_event(EventPrincipal& p, ModuleContext const& mc)
   try {
-    ++counts_visited_;
+    increment(counts_.visited);
     returnCode_ = false;
     // Transition from Ready state to Working state.
     state_ = Working;
@@ -383,20 +462,20 @@ namespace art {
     if (action == actions::IgnoreCompletely) {
       state_ = Pass;
       returnCode_ = true;
-      ++counts_passed_;
+      increment(counts_.passed);
       mf::LogWarning("IgnoreCompletely") << "Module ignored an exception\n"
                                          << e.what();
       // WARNING: We will continue execution below!!!
     } else if (action == actions::FailModule) {
       state_ = Fail;
       returnCode_ = true;
-      ++counts_failed_;
+      increment(counts_.failed);
       mf::LogWarning("FailModule") << "Module failed due to an exception\n"
                                    << e.what();
       // WARNING: We will continue execution below!!!
     } else {
       state_ = ExceptionThrown;
-      ++counts_thrown_;
+      increment(counts_.thrown);
       e << "The above exception was thrown while processing module "
         << brief_context(md_, p) << '\n';
       if (auto edmEx = dynamic_cast<Exception*>(&e)) {
@@ -410,7 +489,7 @@ namespace art {
   }
   catch (bad_alloc const& bda) {
     state_ = ExceptionThrown;
-    ++counts_thrown_;
+    increment(counts_.thrown);
     auto art_ex =
       Exception{errors::BadAlloc}
       << "A bad_alloc exception occurred during a call to the module "
@@ -422,7 +501,7 @@ namespace art {
   }
   catch (exception const& e) {
     state_ = ExceptionThrown;
-    ++counts_thrown_;
+    increment(counts_.thrown);
     auto art_ex = Exception{errors::StdException}
                   << "An exception occurred during a call to the module "
                   << brief_context(md_, p) << '\n'
@@ -432,7 +511,7 @@ namespace art {
   }
   catch (string const& s) {
     state_ = ExceptionThrown;
-    ++counts_thrown_;
+    increment(counts_.thrown);
     auto art_ex = Exception{errors::BadExceptionType, "string"}
                   << "A string thrown as an exception occurred during a call "
                      "to the module "
@@ -443,7 +522,7 @@ namespace art {
   }
   catch (char const* c) {
     state_ = ExceptionThrown;
-    ++counts_thrown_;
+    increment(counts_.thrown);
     auto art_ex = Exception{errors::BadExceptionType, "char const*"}
                   << "A char const* thrown as an exception occurred during a "
                      "call to the module "
@@ -453,7 +532,7 @@ namespace art {
     rethrow_exception(cached_exception_);
   }
   catch (...) {
-    ++counts_thrown_;
+    increment(counts_.thrown);
     state_ = ExceptionThrown;
     auto art_ex = Exception{errors::Unknown, "repeated"}
                   << "An unknown occurred during a previous call to the module "
@@ -463,7 +542,9 @@ namespace art {
   }
 
   void
-  Worker::runWorker(EventPrincipal& p, ModuleContext const& mc)
+  Worker::runWorker(EventPrincipal& p,
+                    ModuleContext const& mc,
+                    std::exception_ptr const acquireException)
   {
     auto const sid = mc.scheduleID();
     TDEBUG_BEGIN_TASK_SI(4, sid);
@@ -471,6 +552,12 @@ namespace art {
     try {
       // Transition from Ready state to Working state.
       state_ = Working;
+      // An exception from the module's acquire step (or from the
+      // external work it started) is handled exactly as if the
+      // module's event function had thrown it.
+      if (acquireException) {
+        rethrow_exception(acquireException);
+      }
       actReg_.sPreModule.invoke(mc);
       // Note: Only filters ever return false, and when they do it
       // means they have rejected.
@@ -493,20 +580,20 @@ namespace art {
       if (action == actions::IgnoreCompletely) {
         state_ = Pass;
         returnCode_ = true;
-        ++counts_passed_;
+        increment(counts_.passed);
         mf::LogWarning("IgnoreCompletely") << "Module ignored an exception\n"
                                            << e.what();
         // WARNING: We will continue execution below!!!
       } else if (action == actions::FailModule) {
         state_ = Fail;
         returnCode_ = true;
-        ++counts_failed_;
+        increment(counts_.failed);
         mf::LogWarning("FailModule") << "Module failed due to an exception\n"
                                      << e.what();
         // WARNING: We will continue execution below!!!
       } else {
         state_ = ExceptionThrown;
-        ++counts_thrown_;
+        increment(counts_.thrown);
         e << "The above exception was thrown while processing module "
           << brief_context(md_, p);
         if (auto art_ex = dynamic_cast<Exception*>(&e)) {
@@ -522,7 +609,7 @@ namespace art {
     }
     catch (bad_alloc const& bda) {
       state_ = ExceptionThrown;
-      ++counts_thrown_;
+      increment(counts_.thrown);
       auto art_ex =
         Exception{errors::BadAlloc}
         << "A bad_alloc exception was thrown while processing module "
@@ -536,7 +623,7 @@ namespace art {
     }
     catch (exception const& e) {
       state_ = ExceptionThrown;
-      ++counts_thrown_;
+      increment(counts_.thrown);
       auto art_ex = Exception{errors::StdException}
                     << "An exception was thrown while processing module "
                     << brief_context(md_, p) << '\n'
@@ -548,7 +635,7 @@ namespace art {
     }
     catch (string const& s) {
       state_ = ExceptionThrown;
-      ++counts_thrown_;
+      increment(counts_.thrown);
       auto art_ex =
         Exception{errors::BadExceptionType, "string"}
         << "A string was thrown as an exception while processing module "
@@ -561,7 +648,7 @@ namespace art {
     }
     catch (char const* c) {
       state_ = ExceptionThrown;
-      ++counts_thrown_;
+      increment(counts_.thrown);
       auto art_ex =
         Exception{errors::BadExceptionType, "char const*"}
         << "A char const* was thrown as an exception while processing module "
@@ -573,7 +660,7 @@ namespace art {
       return;
     }
     catch (...) {
-      ++counts_thrown_;
+      increment(counts_.thrown);
       state_ = ExceptionThrown;
       auto art_ex =
         Exception{errors::Unknown, "repeated"}
@@ -588,6 +675,116 @@ namespace art {
     TDEBUG_END_TASK_SI(4, sid);
   }
 
+  class Worker::AcquireDoneTask {
+  public:
+    AcquireDoneTask(Worker* worker, EventPrincipal& p, ModuleContext const& mc)
+      : worker_{worker}, p_{p}, mc_{mc}
+    {}
+
+    void
+    operator()(exception_ptr const ex) const
+    {
+      auto const sid = mc_.scheduleID();
+      TDEBUG_BEGIN_TASK_SI(4, sid);
+      if (auto queue = worker_->resourceQueue()) {
+        // The shared resources were released when the acquire step
+        // returned; they must be reacquired for the event step, which
+        // then takes precedence over the events not yet started.
+        TDEBUG_TASK_SI(4, sid) << "pushing onto queue " << hex << queue << dec;
+        queue->push(detail::TaskPriority::high,
+                    [worker = worker_, &p = p_, &mc = mc_, ex] {
+                      worker->runWorker(p, mc, ex);
+                    });
+        TDEBUG_END_TASK_SI(4, sid);
+        return;
+      }
+      worker_->runWorker(p_, mc_, ex);
+      TDEBUG_END_TASK_SI(4, sid);
+    }
+
+  private:
+    Worker* worker_;
+    EventPrincipal& p_;
+    ModuleContext const& mc_;
+  };
+
+  void
+  Worker::runAcquire(EventPrincipal& p, ModuleContext const& mc)
+  {
+    auto const sid = mc.scheduleID();
+    TDEBUG_BEGIN_TASK_SI(4, sid);
+    // The acquire-done task waits for two parties: the holder handed
+    // to the module, which is released when the external work
+    // completes, and this function, which must first determine
+    // whether the acquire call itself threw.
+    auto acquireDoneTask = make_waiting_task(AcquireDoneTask{this, p, mc}, 2);
+    exception_ptr ex{};
+    try {
+      doAcquire(p, mc, WaitingTaskHolder{taskGroup_, acquireDoneTask});
+    }
+    catch (...) {
+      ex = current_exception();
+    }
+    WaitingTaskHolder{taskGroup_, std::move(acquireDoneTask)}.doneWaiting(ex);
+    TDEBUG_END_TASK_SI(4, sid);
+  }
+
+  void
+  Worker::runBatch(vector<detail::BatchEntry> const& batch)
+  {
+    for (auto const& entry : batch) {
+      entry.worker->returnCode_ = false;
+      // Transition from Ready state to Working state.
+      entry.worker->state_ = Working;
+    }
+    try {
+      for (auto const& entry : batch) {
+        actReg_.sPreModule.invoke(*entry.context);
+      }
+      auto const results = doProcessBatch(batch);
+      assert(results.size() == batch.size());
+      for (size_t i = 0; i != batch.size(); ++i) {
+        auto& worker = *batch[i].worker;
+        actReg_.sPostModule.invoke(*batch[i].context);
+        worker.returnCode_ = results[i];
+        worker.state_ = results[i] ? Pass : Fail;
+      }
+    }
+    catch (...) {
+      // Each event of the batch handles the exception as if the module
+      // had thrown it while processing that event alone.  runWorker
+      // adds the event's context to the exception, so each event is
+      // given its own copy.
+      auto const ex = current_exception();
+      for (auto const& [worker, p, mc] : batch) {
+        worker->runWorker(*p, *mc, copy_of(ex));
+      }
+      return;
+    }
+    for (auto const& entry : batch) {
+      entry.worker->waitingTasks_.doneWaiting(exception_ptr{});
+    }
+  }
+
+  void
+  Worker::scheduleBatch_(detail::TaskPriority const priority)
+  {
+    // Any worker of the module may process the batch, which contains
+    // the events of other schedules as well.
+    auto task = [this] {
+      auto batcher = eventBatcher();
+      runBatch(batcher->take());
+      if (batcher->finish()) {
+        scheduleBatch_(detail::TaskPriority::normal);
+      }
+    };
+    if (auto queue = resourceQueue()) {
+      queue->push(priority, task);
+    } else {
+      taskGroup_.run(task);
+    }
+  }
+
   bool
   Worker::isUnique() const
   {
@@ -615,19 +812,47 @@ namespace art {
     // Note: threading: More than one task can enter here in the case
     // that paths running in parallel share the same worker.
     waitingTasks_.add(workerInPathDoneTask);
-    ++counts_visited_;
+    increment(counts_.visited);
     bool expected = false;
     if (workStarted_.compare_exchange_strong(expected, true)) {
-      if (auto chain = serialTaskQueueChain()) {
+      // Modules with external work run their acquire step first; the
+      // event step is then scheduled by the AcquireDoneTask.
+      auto const hasAcquire = doHasAcquire();
+      // An event on the end path has finished its trigger paths, so
+      // it is released sooner by giving its serialized tasks
+      // precedence.
+      auto const priority = mc.onEndPath() ? detail::TaskPriority::high :
+                                             detail::TaskPriority::normal;
+      if (auto batcher = eventBatcher()) {
+        // A batched module processes this event together with those
+        // of the other schedules that have reached it.
+        TDEBUG_FUNC_SI(4, sid) << "adding event to batch";
+        if (batcher->push({this, &p, &mc})) {
+          scheduleBatch_(priority);
+        }
+        TDEBUG_END_FUNC_SI(4, sid);
+        return;
+      }
+      if (auto queue = resourceQueue()) {
         // Must be a serialized shared module (including legacy).
-        TDEBUG_FUNC_SI(4, sid) << "pushing onto chain " << hex << chain << dec;
-        chain->push([&p, &mc, this] { runWorker(p, mc); });
+        TDEBUG_FUNC_SI(4, sid) << "pushing onto queue " << hex << queue << dec;
+        queue->push(priority, [&p, &mc, hasAcquire, this] {
+          if (hasAcquire) {
+            runAcquire(p, mc);
+          } else {
+            runWorker(p, mc);
+          }
+        });
         TDEBUG_END_FUNC_SI(4, sid);
         return;
       }
       // Must be a replicated or shared module with no serialization.
       TDEBUG_FUNC_SI(4, sid) << "calling worker functor";
-      runWorker(p, mc);
+      if (hasAcquire) {
+        runAcquire(p, mc);
+      } else {
+        runWorker(p, mc);
+      }
       TDEBUG_END_FUNC_SI(4, sid);
       return;
     }
@@ -19,35 +19,55 @@
 // exception will be rethrown if the worker is entered again and the
 // state is not Ready.  In other words, execution results (status) are
 // cached and reused until the worker is reset().
+//
+// Modules that declare external work are run in two steps: the
+// module's 'acquire' function is called first, and the 'produce'
+// function is scheduled only once the WaitingTaskHolder passed to
+// 'acquire' signals that the external work is done.  No TBB thread is
+// held while the external work is in flight.
 // ======================================================================
 
 #include "art/Framework/Principal/fwd.h"
 #include "art/Persistency/Provenance/ModuleDescription.h"
+#include "art/Utilities/CacheLine.h"
 #include "art/Utilities/ScheduleID.h"
 #include "art/Utilities/Transition.h"
 #include "hep_concurrency/WaitingTaskList.h"
 
+#include <tbb/task_group.h> // Can't forward-declare this class.
+
 #include <atomic>
 #include <exception>
 #include <string>
 #include <vector>
 
-namespace hep::concurrency {
-  class SerialTaskQueueChain;
-}
-
 namespace art {
   class ActivityRegistry;
   class ModuleContext;
   class FileBlock;
+  class WaitingTaskHolder;
   namespace detail {
+    struct BatchEntry;
+    class EventBatcher;
+    class ResourceQueue;
     class SharedResources;
+    enum class TaskPriority;
   }
 
   class Worker {
   public:
     enum State { Ready, Pass, Fail, Working, ExceptionThrown };
 
+    // A copy of the execution statistics.  Each count is individually
+    // up to date, but the counts are not read as a single transaction.
+    struct CountsSnapshot {
+      std::size_t visited{};
+      std::size_t run{};
+      std::size_t passed{};
+      std::size_t failed{};
+      std::size_t except{};
+    };
+
     virtual ~Worker();
     Worker(ModuleDescription const&, WorkerParams const&);
 
@@ -75,13 +95,17 @@ namespace art {
     bool returnCode() const;
 
     ModuleDescription const& description() const;
-    hep::concurrency::SerialTaskQueueChain* serialTaskQueueChain() const;
+    detail::ResourceQueue* resourceQueue() const;
+    detail::EventBatcher* eventBatcher() const;
 
     // Used by EventProcessor
     // Used by Schedule
     // Used by EndPathExecutor
     void reset();
 
+    // May be called from any thread while events are being processed.
+    CountsSnapshot countsSnapshot() const;
+
     // Used only by writeSummary
     std::size_t timesVisited() const;
     std::size_t timesRun() const;
@@ -89,21 +113,39 @@ namespace art {
     std::size_t timesFailed() const;
     std::size_t timesExcept() const;
 
-    void runWorker(EventPrincipal&, ModuleContext const&);
+    void runWorker(EventPrincipal&,
+                   ModuleContext const&,
+                   std::exception_ptr acquireException = {});
+    // Process the events of a batch, each with the worker of its
+    // schedule, in a single call to the module.
+    void runBatch(std::vector<detail::BatchEntry> const& batch);
     bool isUnique() const;
 
   protected:
     std::string const& label() const;
 
-    std::atomic<std::size_t> counts_visited_{};
-    std::atomic<std::size_t> counts_run_{};
-    std::atomic<std::size_t> counts_passed_{};
-    std::atomic<std::size_t> counts_failed_{};
-    std::atomic<std::size_t> counts_thrown_{};
+    // Note: threading: The counters are kept on their own cache line
+    // so that incrementing them does not contend with the worker state
+    // that the paths of this schedule poll concurrently.  Only the
+    // 'visited' counter can be incremented by more than one path at
+    // the same time; all increments are relaxed since the counters do
+    // not order any other memory accesses.
+    struct alignas(cache_line_size) Counts {
+      std::atomic<std::size_t> visited{};
+      std::atomic<std::size_t> run{};
+      std::atomic<std::size_t> passed{};
+      std::atomic<std::size_t> failed{};
+      std::atomic<std::size_t> thrown{};
+    };
+    Counts counts_{};
 
   private:
-    virtual hep::concurrency::SerialTaskQueueChain* doSerialTaskQueueChain()
-      const = 0;
+    class AcquireDoneTask;
+
+    void runAcquire(EventPrincipal&, ModuleContext const&);
+    void scheduleBatch_(detail::TaskPriority);
+
+    virtual detail::ResourceQueue* doResourceQueue() const = 0;
     virtual void doBeginJob(detail::SharedResources const& resources) = 0;
     virtual void doEndJob() = 0;
     virtual void doBegin(RunPrincipal& rp, ModuleContext const& mc) = 0;
@@ -111,6 +153,13 @@ namespace art {
     virtual void doBegin(SubRunPrincipal& srp, ModuleContext const& mc) = 0;
     virtual void doEnd(SubRunPrincipal& srp, ModuleContext const& mc) = 0;
     virtual bool doProcess(EventPrincipal&, ModuleContext const&) = 0;
+    virtual bool doHasAcquire() const;
+    virtual void doAcquire(EventPrincipal&,
+                           ModuleContext const&,
+                           WaitingTaskHolder);
+    virtual detail::EventBatcher* doEventBatcher() const;
+    virtual std::vector<bool> doProcessBatch(
+      std::vector<detail::BatchEntry> const&);
 
     virtual void doRespondToOpenInputFile(FileBlock const& fb) = 0;
     virtual void doRespondToCloseInputFile(FileBlock const& fb) = 0;
@@ -121,6 +170,7 @@ namespace art {
     ModuleDescription const md_;
     ActionTable const& actions_;
     ActivityRegistry const& actReg_;
+    tbb::task_group& taskGroup_;
     std::atomic<int> state_{Ready};
 
     // if state is 'exception'
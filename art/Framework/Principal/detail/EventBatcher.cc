@@ -0,0 +1,52 @@
+#include "art/Framework/Principal/detail/EventBatcher.h"
+// vim: set sw=2 expandtab :
+
+#include <algorithm>
+#include <cassert>
+#include <iterator>
+
+using namespace std;
+
+namespace art::detail {
+
+  void
+  EventBatcher::setMaxSize(size_t const maxSize) noexcept
+  {
+    maxSize_ = maxSize;
+  }
+
+  bool
+  EventBatcher::push(BatchEntry const& entry)
+  {
+    lock_guard sentry{mutex_};
+    waiting_.push_back(entry);
+    if (inFlight_) {
+      return false;
+    }
+    inFlight_ = true;
+    return true;
+  }
+
+  vector<BatchEntry>
+  EventBatcher::take()
+  {
+    lock_guard sentry{mutex_};
+    assert(inFlight_);
+    auto const n = maxSize_ == 0 ? waiting_.size() :
+                                   min(maxSize_, waiting_.size());
+    auto const end = next(waiting_.begin(), n);
+    vector<BatchEntry> result(waiting_.begin(), end);
+    waiting_.erase(waiting_.begin(), end);
+    return result;
+  }
+
+  bool
+  EventBatcher::finish()
+  {
+    lock_guard sentry{mutex_};
+    assert(inFlight_);
+    inFlight_ = !waiting_.empty();
+    return inFlight_;
+  }
+
+} // namespace art::detail
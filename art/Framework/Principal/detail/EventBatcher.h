@@ -0,0 +1,66 @@
+#ifndef art_Framework_Principal_detail_EventBatcher_h
+#define art_Framework_Principal_detail_EventBatcher_h
+// vim: set sw=2 expandtab :
+
+// ======================================================================
+// EventBatcher: gathers the events, from different schedules, that
+// have reached a batched module on their paths, so that the module
+// can process them in a single call.
+//
+// Only one batch of a module is in flight at a time.  An event that
+// arrives while a batch is being processed waits for the next one,
+// which then includes every event that arrived in the meantime (up to
+// the maximum batch size).  No event ever waits for a batch to fill.
+// ======================================================================
+
+#include <cstddef>
+#include <mutex>
+#include <vector>
+
+namespace art {
+  class EventPrincipal;
+  class ModuleContext;
+  class Worker;
+}
+
+namespace art::detail {
+
+  // An event of a batch, with the worker of its schedule.
+  struct BatchEntry {
+    Worker* worker;
+    EventPrincipal* principal;
+    ModuleContext const* context;
+  };
+
+  class EventBatcher {
+  public:
+    // A maximum size of zero does not limit the batches beyond the
+    // number of schedules.
+    void setMaxSize(std::size_t maxSize) noexcept;
+
+    // Whether the caller must schedule the processing of the next
+    // batch, as none is in flight.
+    bool push(BatchEntry const& entry);
+
+    // The next batch to process, in order of arrival.
+    std::vector<BatchEntry> take();
+
+    // Record that a batch has been processed.  Returns whether events
+    // are waiting, in which case the caller must schedule the next
+    // batch; otherwise, no batch is in flight any more.
+    bool finish();
+
+  private:
+    std::size_t maxSize_{};
+    std::mutex mutex_{};
+    std::vector<BatchEntry> waiting_{};
+    bool inFlight_{false};
+  };
+
+} // namespace art::detail
+
+#endif /* art_Framework_Principal_detail_EventBatcher_h */
+
+// Local Variables:
+// mode: c++
+// End:
@@ -22,10 +22,16 @@ namespace art {
     virtual ~FileTransfer() noexcept = default;
     int translateToLocalFilename(std::string const& uri,
                                  std::string& fileFQname);
+    // Called once the file returned by translateToLocalFilename is no
+    // longer needed, so that a local copy of it may be removed.
+    void releaseLocalFilename(std::string const& fileFQname);
 
   private:
     virtual int doTranslateToLocalFilename(std::string const& uri,
                                            std::string& fileFQname) = 0;
+    virtual void
+    doReleaseLocalFilename(std::string const&)
+    {}
   };
 
   inline int
@@ -35,6 +41,12 @@ namespace art {
     return doTranslateToLocalFilename(uri, fileFQname);
   }
 
+  inline void
+  FileTransfer::releaseLocalFilename(std::string const& fileFQname)
+  {
+    doReleaseLocalFilename(fileFQname);
+  }
+
 } // namespace art
 
 DECLARE_ART_SERVICE_INTERFACE(art::FileTransfer, SHARED)
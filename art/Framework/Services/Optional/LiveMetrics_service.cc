@@ -0,0 +1,606 @@
+// vim: set sw=2 expandtab :
+
+// ======================================================================
+// LiveMetrics
+//
+// Publishes metrics of a running job in the Prometheus text exposition
+// format.  The metrics are written periodically to a file (replaced
+// atomically so that a scraper never sees a partial update) and/or
+// served to every client that connects to a UNIX-domain socket:
+//
+//   services.LiveMetrics: {
+//     interval: 10                     # seconds
+//     filename: "art_metrics.prom"
+//     socket: "/tmp/art_metrics.sock"  # e.g. 'socat - UNIX:<path>'
+//   }
+//
+// The signal callbacks only perform relaxed atomic additions on
+// counters that each schedule keeps on its own cache lines; the
+// counters of all schedules are summed when the metrics are rendered.
+// All formatting and I/O is
+// done on a dedicated exporter thread, outside of the TBB arena.  A
+// client that does not read its data within the send timeout is
+// dropped so that it cannot stall the exporter.
+// ======================================================================
+
+#include "art/Framework/Principal/Event.h"
+#include "art/Framework/Services/Registry/ActivityRegistry.h"
+#include "art/Framework/Services/Registry/ServiceDeclarationMacros.h"
+#include "art/Framework/Services/Registry/ServiceDefinitionMacros.h"
+#include "art/Framework/Services/Registry/ServiceTable.h"
+#include "art/Persistency/Provenance/ModuleContext.h"
+#include "art/Persistency/Provenance/ModuleDescription.h"
+#include "art/Persistency/Provenance/ScheduleContext.h"
+#include "art/Utilities/CacheLine.h"
+#include "art/Utilities/Globals.h"
+#include "canvas/Utilities/Exception.h"
+#include "fhiclcpp/types/Atom.h"
+#include "fhiclcpp/types/Comment.h"
+#include "fhiclcpp/types/Name.h"
+#include "messagefacility/MessageLogger/MessageLogger.h"
+
+#include <sys/socket.h>
+#include <sys/time.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+#include <atomic>
+#include <cerrno>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <memory>
+#include <mutex>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+using namespace std;
+using namespace std::chrono;
+
+namespace art {
+
+  namespace {
+
+    using clock_type = steady_clock;
+
+    // Time allowed for sending the metrics to a connected client.
+    constexpr timeval send_timeout{1, 0};
+
+    uint64_t
+    nanoseconds_since(clock_type::time_point const start)
+    {
+      return duration_cast<nanoseconds>(clock_type::now() - start).count();
+    }
+
+    double
+    seconds_from(uint64_t const ns)
+    {
+      return ns * 1.e-9;
+    }
+
+    void
+    add(atomic<uint64_t>& counter, uint64_t const value)
+    {
+      counter.fetch_add(value, memory_order_relaxed);
+    }
+
+    uint64_t
+    value_of(atomic<uint64_t> const& counter)
+    {
+      return counter.load(memory_order_relaxed);
+    }
+
+    // Resident set size in bytes; zero if it cannot be determined.
+    uint64_t
+    resident_bytes()
+    {
+#ifdef __linux__
+      ifstream statm{"/proc/self/statm"};
+      uint64_t vsize_pages{}, rss_pages{};
+      if (statm >> vsize_pages >> rss_pages) {
+        return rss_pages * static_cast<uint64_t>(sysconf(_SC_PAGESIZE));
+      }
+#endif
+      return 0;
+    }
+
+    void
+    header(ostream& os,
+           string const& name,
+           string const& type,
+           string const& help)
+    {
+      os << "# HELP " << name << ' ' << help << '\n'
+         << "# TYPE " << name << ' ' << type << '\n';
+    }
+
+  } // unnamed namespace
+
+  class LiveMetrics {
+  public:
+    static constexpr bool service_handle_allowed{false};
+
+    struct Config {
+      using Name = fhicl::Name;
+      using Comment = fhicl::Comment;
+      template <typename T>
+      using Atom = fhicl::Atom<T>;
+      Atom<unsigned> interval{
+        Name{"interval"},
+        Comment{"Number of seconds between successive exports."},
+        10u};
+      Atom<string> filename{
+        Name{"filename"},
+        Comment{"File to which the metrics are written.  The file is\n"
+                "replaced atomically at each export."},
+        ""};
+      Atom<string> socket{
+        Name{"socket"},
+        Comment{"Path of a UNIX-domain socket on which the current\n"
+                "metrics are served to each connecting client."},
+        ""};
+    };
+    using Parameters = ServiceTable<Config>;
+    LiveMetrics(Parameters const&, ActivityRegistry&);
+    ~LiveMetrics();
+
+    LiveMetrics(LiveMetrics const&) = delete;
+    LiveMetrics& operator=(LiveMetrics const&) = delete;
+
+  private:
+    struct ModuleStats {
+      atomic<uint64_t> calls{};
+      atomic<uint64_t> nanoseconds{};
+    };
+
+    // The statistics of the modules on one schedule are mostly updated
+    // by that schedule's tasks; as for the start times below, each
+    // schedule's statistics begin on a new cache line.
+    struct alignas(cache_line_size) ModuleStatsLine {
+      static constexpr size_t size{cache_line_size / sizeof(ModuleStats)};
+      ModuleStats stats[size];
+    };
+
+    // The start times of the modules on one schedule are written by
+    // that schedule's tasks only; each schedule's slots begin on a new
+    // cache line so that they are not shared with another schedule.
+    struct alignas(cache_line_size) StartTimes {
+      static constexpr size_t size{cache_line_size /
+                                   sizeof(clock_type::time_point)};
+      clock_type::time_point times[size];
+    };
+
+    struct alignas(cache_line_size) ScheduleStats {
+      // Only touched by the tasks of the owning schedule, which are
+      // never concurrent with each other.
+      clock_type::time_point start{};
+      atomic<uint64_t> events{};
+      atomic<uint64_t> busyNanoseconds{};
+    };
+
+    void postModuleConstruction(ModuleDescription const&);
+    void postBeginJob();
+    void postEndJob();
+    void startSchedule(ScheduleContext);
+    void stopSchedule(ScheduleContext, bool eventDone);
+    void startModule(ModuleContext const&);
+    void stopModule(ModuleContext const&);
+    clock_type::time_point& startTime_(ModuleContext const&,
+                                       size_t index) const;
+    ModuleStats& moduleStats_(ScheduleID::size_type schedule,
+                              size_t index) const;
+    // The calls and nanoseconds of a module, summed over the schedules.
+    pair<uint64_t, uint64_t> moduleTotals_(size_t index) const;
+
+    void run_();
+    void openSocket_();
+    void serveClients_();
+    void export_();
+    string render_();
+
+    milliseconds const interval_;
+    string const filename_;
+    string const socketPath_;
+    ScheduleID::size_type const nschedules_;
+
+    // Filled while the modules are constructed; read-only afterwards.
+    unordered_map<string, size_t> moduleIndices_{};
+    vector<string> moduleLabels_{};
+
+    // Indexed by schedule and module; each schedule uses
+    // statsLinesPerSchedule_ consecutive cache lines.
+    unique_ptr<ModuleStatsLine[]> moduleStatsLines_{};
+    size_t statsLinesPerSchedule_{};
+    unique_ptr<ScheduleStats[]> scheduleStats_{};
+    // Indexed by schedule and module; each schedule uses
+    // startLinesPerSchedule_ consecutive cache lines.
+    unique_ptr<StartTimes[]> moduleStarts_{};
+    size_t startLinesPerSchedule_{};
+
+    // Only used by the exporter thread once it has been started.
+    clock_type::time_point jobStart_{};
+    clock_type::time_point lastExport_{};
+    uint64_t lastEvents_{};
+    double eventRate_{};
+    int socketFd_{-1};
+
+    mutex mutex_{};
+    condition_variable stopRequested_{};
+    bool stop_{false};
+    thread exporter_{};
+  };
+
+  LiveMetrics::LiveMetrics(Parameters const& config, ActivityRegistry& areg)
+    : interval_{seconds{config().interval()}}
+    , filename_{config().filename()}
+    , socketPath_{config().socket()}
+    , nschedules_{Globals::instance()->nschedules()}
+  {
+    if (filename_.empty() && socketPath_.empty()) {
+      throw Exception{errors::Configuration}
+        << "The LiveMetrics service requires a 'filename' or a 'socket' "
+           "(or both) to be specified.\n";
+    }
+    if (config().interval() == 0u) {
+      throw Exception{errors::Configuration}
+        << "The LiveMetrics 'interval' parameter must be positive.\n";
+    }
+    areg.sPostModuleConstruction.watch(this,
+                                       &LiveMetrics::postModuleConstruction);
+    areg.sPostBeginJob.watch(this, &LiveMetrics::postBeginJob);
+    areg.sPostEndJob.watch(this, &LiveMetrics::postEndJob);
+    // Event reading and processing
+    areg.sPreSourceEvent.watch(this, &LiveMetrics::startSchedule);
+    areg.sPostSourceEvent.watch(
+      [this](Event const&, ScheduleContext const sc) {
+        stopSchedule(sc, false);
+      });
+    areg.sPreProcessEvent.watch(
+      [this](Event const&, ScheduleContext const sc) { startSchedule(sc); });
+    areg.sPostProcessEvent.watch(
+      [this](Event const&, ScheduleContext const sc) {
+        stopSchedule(sc, true);
+      });
+    // Module execution
+    areg.sPreModule.watch(this, &LiveMetrics::startModule);
+    areg.sPostModule.watch(this, &LiveMetrics::stopModule);
+    areg.sPreWriteEvent.watch(this, &LiveMetrics::startModule);
+    areg.sPostWriteEvent.watch(this, &LiveMetrics::stopModule);
+  }
+
+  LiveMetrics::~LiveMetrics()
+  {
+    {
+      lock_guard lock{mutex_};
+      stop_ = true;
+    }
+    stopRequested_.notify_one();
+    if (exporter_.joinable()) {
+      exporter_.join();
+    }
+    if (socketFd_ != -1) {
+      close(socketFd_);
+      unlink(socketPath_.c_str());
+    }
+  }
+
+  void
+  LiveMetrics::postModuleConstruction(ModuleDescription const& md)
+  {
+    auto const& label = md.moduleLabel();
+    if (moduleIndices_.try_emplace(label, moduleLabels_.size()).second) {
+      moduleLabels_.push_back(label);
+    }
+  }
+
+  void
+  LiveMetrics::postBeginJob()
+  {
+    auto const nmodules = moduleLabels_.size();
+    statsLinesPerSchedule_ =
+      (nmodules + ModuleStatsLine::size - 1) / ModuleStatsLine::size;
+    moduleStatsLines_ =
+      make_unique<ModuleStatsLine[]>(nschedules_ * statsLinesPerSchedule_);
+    scheduleStats_ = make_unique<ScheduleStats[]>(nschedules_);
+    startLinesPerSchedule_ =
+      (nmodules + StartTimes::size - 1) / StartTimes::size;
+    moduleStarts_ =
+      make_unique<StartTimes[]>(nschedules_ * startLinesPerSchedule_);
+    jobStart_ = lastExport_ = clock_type::now();
+    if (!socketPath_.empty()) {
+      openSocket_();
+    }
+    exporter_ = thread{&LiveMetrics::run_, this};
+  }
+
+  void
+  LiveMetrics::postEndJob()
+  {
+    {
+      lock_guard lock{mutex_};
+      stop_ = true;
+    }
+    stopRequested_.notify_one();
+    if (!exporter_.joinable()) {
+      // beginJob did not complete.
+      return;
+    }
+    exporter_.join();
+    // Final values for anyone scraping the file after the job ends.
+    export_();
+  }
+
+  void
+  LiveMetrics::startSchedule(ScheduleContext const sc)
+  {
+    scheduleStats_[sc.id().id()].start = clock_type::now();
+  }
+
+  void
+  LiveMetrics::stopSchedule(ScheduleContext const sc, bool const eventDone)
+  {
+    auto& stats = scheduleStats_[sc.id().id()];
+    add(stats.busyNanoseconds, nanoseconds_since(stats.start));
+    if (eventDone) {
+      add(stats.events, 1);
+    }
+  }
+
+  clock_type::time_point&
+  LiveMetrics::startTime_(ModuleContext const& mc, size_t const index) const
+  {
+    auto const line = mc.scheduleID().id() * startLinesPerSchedule_ +
+                      index / StartTimes::size;
+    return moduleStarts_[line].times[index % StartTimes::size];
+  }
+
+  LiveMetrics::ModuleStats&
+  LiveMetrics::moduleStats_(ScheduleID::size_type const schedule,
+                            size_t const index) const
+  {
+    auto const line =
+      schedule * statsLinesPerSchedule_ + index / ModuleStatsLine::size;
+    return moduleStatsLines_[line].stats[index % ModuleStatsLine::size];
+  }
+
+  pair<uint64_t, uint64_t>
+  LiveMetrics::moduleTotals_(size_t const index) const
+  {
+    pair<uint64_t, uint64_t> result{};
+    for (ScheduleID::size_type i = 0; i != nschedules_; ++i) {
+      auto const& stats = moduleStats_(i, index);
+      result.first += value_of(stats.calls);
+      result.second += value_of(stats.nanoseconds);
+    }
+    return result;
+  }
+
+  void
+  LiveMetrics::startModule(ModuleContext const& mc)
+  {
+    auto const it = moduleIndices_.find(mc.moduleLabel());
+    if (it == cend(moduleIndices_)) {
+      // E.g. the framework's TriggerResults inserter.
+      return;
+    }
+    startTime_(mc, it->second) = clock_type::now();
+  }
+
+  void
+  LiveMetrics::stopModule(ModuleContext const& mc)
+  {
+    auto const it = moduleIndices_.find(mc.moduleLabel());
+    if (it == cend(moduleIndices_)) {
+      return;
+    }
+    auto& stats = moduleStats_(mc.scheduleID().id(), it->second);
+    add(stats.calls, 1);
+    add(stats.nanoseconds,
+        nanoseconds_since(startTime_(mc, it->second)));
+  }
+
+  void
+  LiveMetrics::openSocket_()
+  {
+    sockaddr_un address{};
+    address.sun_family = AF_UNIX;
+    if (socketPath_.size() >= sizeof(address.sun_path)) {
+      throw Exception{errors::Configuration}
+        << "The LiveMetrics socket path '" << socketPath_
+        << "' is too long.\n";
+    }
+    strncpy(
+      address.sun_path, socketPath_.c_str(), sizeof(address.sun_path) - 1);
+    unlink(socketPath_.c_str());
+    socketFd_ = ::socket(AF_UNIX, SOCK_STREAM | SOCK_NONBLOCK, 0);
+    auto const addr = reinterpret_cast<sockaddr const*>(&address);
+    if (socketFd_ == -1 || bind(socketFd_, addr, sizeof address) == -1 ||
+        listen(socketFd_, 4) == -1) {
+      auto const err = errno;
+      throw Exception{errors::Configuration}
+        << "The LiveMetrics service could not listen on socket '"
+        << socketPath_ << "': " << strerror(err) << '\n';
+    }
+  }
+
+  void
+  LiveMetrics::run_()
+  {
+    // Clients connecting to the socket should not have to wait for a
+    // full export interval.
+    auto const poll = socketFd_ == -1 ? interval_ : milliseconds{100};
+    auto next = clock_type::now() + interval_;
+    unique_lock lock{mutex_};
+    while (!stop_) {
+      stopRequested_.wait_for(lock, poll, [this] { return stop_; });
+      if (stop_) {
+        break;
+      }
+      lock.unlock();
+      serveClients_();
+      if (clock_type::now() >= next) {
+        export_();
+        next += interval_;
+      }
+      lock.lock();
+    }
+  }
+
+  void
+  LiveMetrics::serveClients_()
+  {
+    if (socketFd_ == -1) {
+      return;
+    }
+    int client{};
+    while ((client = accept(socketFd_, nullptr, nullptr)) != -1) {
+      // The accepted socket is blocking; bound the time a client that
+      // does not read can hold up the exporter.
+      setsockopt(client,
+                 SOL_SOCKET,
+                 SO_SNDTIMEO,
+                 &send_timeout,
+                 sizeof send_timeout);
+      auto const text = render_();
+      auto data = text.data();
+      auto remaining = text.size();
+      while (remaining != 0) {
+        auto const n = send(client, data, remaining, MSG_NOSIGNAL);
+        if (n <= 0) {
+          break;
+        }
+        data += n;
+        remaining -= n;
+      }
+      close(client);
+    }
+  }
+
+  void
+  LiveMetrics::export_()
+  {
+    auto const now = clock_type::now();
+    uint64_t events{};
+    for (ScheduleID::size_type i = 0; i != nschedules_; ++i) {
+      events += value_of(scheduleStats_[i].events);
+    }
+    auto const elapsed = duration<double>{now - lastExport_}.count();
+    if (elapsed > 0.) {
+      eventRate_ = (events - lastEvents_) / elapsed;
+    }
+    lastEvents_ = events;
+    lastExport_ = now;
+
+    if (filename_.empty()) {
+      return;
+    }
+    auto const tmpName = filename_ + ".tmp";
+    {
+      ofstream file{tmpName};
+      file << render_();
+      if (!file) {
+        mf::LogWarning("LiveMetrics")
+          << "Could not write metrics to '" << tmpName << "'.";
+        return;
+      }
+    }
+    if (rename(tmpName.c_str(), filename_.c_str()) != 0) {
+      mf::LogWarning("LiveMetrics") << "Could not replace metrics file '"
+                                    << filename_ << "': " << strerror(errno);
+    }
+  }
+
+  string
+  LiveMetrics::render_()
+  {
+    auto const uptime =
+      duration<double>{clock_type::now() - jobStart_}.count();
+    ostringstream os;
+    uint64_t events{};
+    for (ScheduleID::size_type i = 0; i != nschedules_; ++i) {
+      events += value_of(scheduleStats_[i].events);
+    }
+
+    header(os,
+           "art_uptime_seconds",
+           "gauge",
+           "Seconds since the end of beginJob.");
+    os << "art_uptime_seconds " << uptime << '\n';
+
+    header(os,
+           "art_events_processed_total",
+           "counter",
+           "Number of events that have been fully processed.");
+    os << "art_events_processed_total " << events << '\n';
+
+    header(os,
+           "art_event_rate_hertz",
+           "gauge",
+           "Events processed per second over the last export interval.");
+    os << "art_event_rate_hertz " << eventRate_ << '\n';
+
+    header(os,
+           "art_schedule_idle_fraction",
+           "gauge",
+           "Fraction of the job's wall time in which the schedule was "
+           "neither reading nor processing an event.");
+    for (ScheduleID::size_type i = 0; i != nschedules_; ++i) {
+      auto const busy =
+        seconds_from(value_of(scheduleStats_[i].busyNanoseconds));
+      auto const idle = uptime > 0. ? 1. - busy / uptime : 0.;
+      os << "art_schedule_idle_fraction{schedule=\"" << i << "\"} "
+         << (idle < 0. ? 0. : idle) << '\n';
+    }
+
+    header(os,
+           "art_module_calls_total",
+           "counter",
+           "Number of times a module has processed or written an event.");
+    vector<pair<uint64_t, uint64_t>> totals;
+    totals.reserve(moduleLabels_.size());
+    for (size_t i = 0; i != moduleLabels_.size(); ++i) {
+      totals.push_back(moduleTotals_(i));
+      os << "art_module_calls_total{module=\"" << moduleLabels_[i] << "\"} "
+         << totals[i].first << '\n';
+    }
+
+    header(os,
+           "art_module_seconds_total",
+           "counter",
+           "Wall time spent by a module processing or writing events, "
+           "summed over all schedules.");
+    for (size_t i = 0; i != moduleLabels_.size(); ++i) {
+      os << "art_module_seconds_total{module=\"" << moduleLabels_[i]
+         << "\"} " << seconds_from(totals[i].second) << '\n';
+    }
+
+    header(os,
+           "art_module_mean_seconds",
+           "gauge",
+           "Mean wall time per call of a module.");
+    for (size_t i = 0; i != moduleLabels_.size(); ++i) {
+      auto const [calls, ns] = totals[i];
+      auto const secs = seconds_from(ns);
+      os << "art_module_mean_seconds{module=\"" << moduleLabels_[i] << "\"} "
+         << (calls == 0 ? 0. : secs / calls) << '\n';
+    }
+
+    header(os,
+           "art_process_resident_bytes",
+           "gauge",
+           "Resident set size of the process.");
+    os << "art_process_resident_bytes " << resident_bytes() << '\n';
+    return os.str();
+  }
+
+} // namespace art
+
+DECLARE_ART_SERVICE(art::LiveMetrics, SHARED)
+DEFINE_ART_SERVICE(art::LiveMetrics)
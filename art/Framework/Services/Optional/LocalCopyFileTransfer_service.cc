@@ -0,0 +1,162 @@
+// vim: set sw=2 expandtab :
+
+// ======================================================================
+// LocalCopyFileTransfer: a FileTransfer implementation that, like
+// TrivialFileTransfer, accepts file:// URIs, but that copies each file
+// into a scratch directory instead of handing out the original path.
+// An optional delay per transfer stands in for the latency of a real
+// transfer, so that input pre-staging (see InputFileCatalog) can be
+// exercised without network access.  Each copy is removed when it is
+// released, or at the latest when the service is destroyed.
+// ======================================================================
+
+#include "art/Framework/Services/FileServiceInterfaces/FileTransfer.h"
+#include "art/Framework/Services/FileServiceInterfaces/FileTransferStatus.h"
+#include "art/Framework/Services/Registry/ServiceDeclarationMacros.h"
+#include "art/Framework/Services/Registry/ServiceDefinitionMacros.h"
+#include "art/Framework/Services/Registry/ServiceTable.h"
+#include "canvas/Utilities/Exception.h"
+#include "fhiclcpp/types/Atom.h"
+#include "fhiclcpp/types/Comment.h"
+#include "fhiclcpp/types/Name.h"
+
+#include <unistd.h>
+
+#include <algorithm>
+#include <chrono>
+#include <filesystem>
+#include <mutex>
+#include <string>
+#include <system_error>
+#include <thread>
+#include <vector>
+
+using namespace std;
+namespace fs = std::filesystem;
+
+namespace art {
+
+  namespace {
+    string const fileURI{"file://"};
+  } // unnamed namespace
+
+  class LocalCopyFileTransfer : public FileTransfer {
+  public:
+    struct Config {
+      fhicl::Atom<string> scratchDir{
+        fhicl::Name("scratchDir"),
+        fhicl::Comment("Directory into which the files are copied.  An\n"
+                       "empty value selects the system's temporary\n"
+                       "directory."),
+        ""};
+      fhicl::Atom<unsigned> delayMS{
+        fhicl::Name("delayMS"),
+        fhicl::Comment("Additional time (in milliseconds) spent on each\n"
+                       "transfer, to emulate a remote copy."),
+        0u};
+    };
+    using Parameters = ServiceTable<Config>;
+
+    explicit LocalCopyFileTransfer(Parameters const& config);
+    ~LocalCopyFileTransfer();
+
+    LocalCopyFileTransfer(LocalCopyFileTransfer const&) = delete;
+    LocalCopyFileTransfer(LocalCopyFileTransfer&&) = delete;
+    LocalCopyFileTransfer& operator=(LocalCopyFileTransfer const&) = delete;
+    LocalCopyFileTransfer& operator=(LocalCopyFileTransfer&&) = delete;
+
+  private:
+    int doTranslateToLocalFilename(string const& uri,
+                                   string& fileFQname) override;
+    void doReleaseLocalFilename(string const& fileFQname) override;
+
+    fs::path scratchDir_;
+    chrono::milliseconds const delay_;
+    mutex copiesMutex_{};
+    vector<fs::path> copies_{};
+    unsigned long nCopies_{};
+  };
+
+  LocalCopyFileTransfer::LocalCopyFileTransfer(Parameters const& config)
+    : scratchDir_{config().scratchDir()}
+    , delay_{config().delayMS()}
+  {
+    if (scratchDir_.empty()) {
+      scratchDir_ = fs::temp_directory_path();
+    }
+    error_code ec;
+    fs::create_directories(scratchDir_, ec);
+    if (ec || !fs::is_directory(scratchDir_)) {
+      throw Exception(errors::Configuration)
+        << "LocalCopyFileTransfer: cannot use '" << scratchDir_.string()
+        << "' as scratch directory: " << ec.message() << '\n';
+    }
+  }
+
+  LocalCopyFileTransfer::~LocalCopyFileTransfer()
+  {
+    for (auto const& copy : copies_) {
+      error_code ec;
+      fs::remove(copy, ec);
+    }
+  }
+
+  int
+  LocalCopyFileTransfer::doTranslateToLocalFilename(string const& uri,
+                                                    string& fileFQname)
+  {
+    fileFQname = "";
+    if (uri.substr(0, 7) != fileURI) {
+      return FileTransferStatus::BAD_REQUEST;
+    }
+    fs::path const source{uri.substr(7)};
+    if (!fs::is_regular_file(source)) {
+      return FileTransferStatus::NOT_FOUND;
+    }
+    if (delay_.count() != 0) {
+      this_thread::sleep_for(delay_);
+    }
+
+    fs::path copy;
+    {
+      lock_guard lock{copiesMutex_};
+      // The prefix keeps copies of equally named files (and of jobs
+      // sharing the scratch directory) apart.
+      copy = scratchDir_ / (to_string(getpid()) + '_' +
+                            to_string(nCopies_++) + '_' +
+                            source.filename().string());
+      copies_.push_back(copy);
+    }
+    error_code ec;
+    fs::copy_file(source, copy, fs::copy_options::overwrite_existing, ec);
+    if (ec) {
+      doReleaseLocalFilename(copy.string());
+      return FileTransferStatus::SERVER_ERROR;
+    }
+    fileFQname = copy.string();
+    return FileTransferStatus::SUCCESS;
+  }
+
+  void
+  LocalCopyFileTransfer::doReleaseLocalFilename(string const& fileFQname)
+  {
+    // A file still open by its reader remains readable until it is
+    // closed.
+    lock_guard lock{copiesMutex_};
+    auto const it = find(begin(copies_), end(copies_), fs::path{fileFQname});
+    if (it == end(copies_)) {
+      return;
+    }
+    error_code ec;
+    fs::remove(*it, ec);
+    copies_.erase(it);
+  }
+
+} // namespace art
+
+DECLARE_ART_SERVICE_INTERFACE_IMPL(art::LocalCopyFileTransfer,
+                                   art::FileTransfer,
+                                   SHARED)
+
+DEFINE_ART_SERVICE_INTERFACE_IMPL(art::LocalCopyFileTransfer,
+                                  art::FileTransfer)
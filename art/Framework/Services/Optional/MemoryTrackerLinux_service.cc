@@ -30,6 +30,7 @@
 #include "art/Persistency/Provenance/ModuleContext.h"
 #include "art/Persistency/Provenance/ModuleDescription.h"
 #include "art/Persistency/Provenance/PathContext.h"
+#include "art/Utilities/AllocatorStrategy.h"
 #include "art/Utilities/Globals.h"
 #include "art/Utilities/LinuxProcData.h"
 #include "art/Utilities/LinuxProcMgr.h"
@@ -445,7 +446,9 @@ namespace art {
       log << "  Peak virtual memory usage (VmPeak)  : " << unique_value(rVMax)
           << " MB\n"
           << "  Peak resident set size usage (VmHWM): " << unique_value(rRMax)
-          << " MB\n";
+          << " MB\n"
+          << "  Memory allocator                    : "
+          << allocator_description() << '\n';
       if (using_file_database_()) {
         log << "  Details saved in: '" << fileName_ << "'\n";
       }
@@ -0,0 +1,802 @@
+// vim: set sw=2 expandtab :
+
+// ======================================================================
+// Timeline
+//
+// Records when the source, paths, modules, and output modules process
+// each event, on which thread and for which schedule, and writes the
+// result at the end of the job in the Chrome trace-event JSON format.
+// The file can be inspected with chrome://tracing or the Perfetto UI
+// (https://ui.perfetto.dev), which show how the work of the different
+// schedules overlaps on the threads.
+//
+//   services.Timeline: {
+//     filename: "timeline.json"
+//     sampleEvery: 10   # Record every 10th event read from the source
+//     startAfter: 60.   # Ignore the first minute after beginJob...
+//     stopAfter: 120.   # ...and anything after the second minute
+//   }
+//
+// Each thread appends to its own buffer, so recording does not
+// require any synchronization between threads.
+//
+// With 'printAnalysis: true', a summary of the recorded events is
+// logged at the end of the job:
+//
+// Only events whose reading and processing were recorded in full are
+// analyzed; events cut by the 'startAfter' and 'stopAfter' window are
+// ignored.
+//
+//  - the critical path of each event, i.e. the chain of module calls
+//    that determined when the event finished.  The predecessor of a
+//    call on the chain is the call of the same event that finished
+//    last before it started; this follows the path-ordering,
+//    data-dependency, and synchronization edges of the module graph.
+//    The gap between the two is time the module spent waiting for a
+//    thread or for a shared resource;
+//  - the serialized modules--legacy modules and shared modules that
+//    declared shared resources--and the fraction of the time they
+//    were busy;
+//  - the time the schedules waited for the input source, and the time
+//    they spent advancing it to its next item;
+//  - an estimate of the throughput if each serialized module could
+//    run concurrently (i.e. if it were made asynchronous or
+//    replicated).  Modules serialized by the same resource bound the
+//    throughput together.
+// ======================================================================
+
+#include "art/Framework/Principal/Event.h"
+#include "art/Framework/Services/Registry/ActivityRegistry.h"
+#include "art/Framework/Services/Registry/ServiceDeclarationMacros.h"
+#include "art/Framework/Services/Registry/ServiceDefinitionMacros.h"
+#include "art/Framework/Services/Registry/ServiceTable.h"
+#include "art/Persistency/Provenance/ModuleContext.h"
+#include "art/Persistency/Provenance/ModuleDescription.h"
+#include "art/Persistency/Provenance/PathContext.h"
+#include "art/Persistency/Provenance/ScheduleContext.h"
+#include "art/Utilities/CacheLine.h"
+#include "art/Utilities/Globals.h"
+#include "art/Utilities/SharedResource.h"
+#include "canvas/Persistency/Common/HLTPathStatus.h"
+#include "canvas/Utilities/Exception.h"
+#include "cetlib/HorizontalRule.h"
+#include "fhiclcpp/types/Atom.h"
+#include "fhiclcpp/types/Comment.h"
+#include "fhiclcpp/types/Name.h"
+#include "fhiclcpp/types/OptionalAtom.h"
+#include "messagefacility/MessageLogger/MessageLogger.h"
+#include "tbb/enumerable_thread_specific.h"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <fstream>
+#include <functional>
+#include <iomanip>
+#include <iterator>
+#include <limits>
+#include <map>
+#include <set>
+#include <sstream>
+#include <string>
+#include <unordered_set>
+#include <utility>
+#include <vector>
+
+using namespace std;
+using namespace std::chrono;
+
+namespace art {
+
+  namespace {
+
+    using clock_type = steady_clock;
+
+    enum class Category { source, event, path, module, write };
+
+    char const*
+    to_string(Category const c)
+    {
+      switch (c) {
+      case Category::source:
+        return "source";
+      case Category::event:
+        return "event";
+      case Category::path:
+        return "path";
+      case Category::module:
+        return "module";
+      case Category::write:
+        return "write";
+      }
+      return "";
+    }
+
+    // Phases as defined by the trace-event format: 'X' is a complete
+    // event, and 'b'/'e' begin and end an asynchronous event, which
+    // may finish on a different thread than the one it started on.
+    struct Record {
+      char phase;
+      Category category;
+      string const* name;
+      ScheduleID::size_type schedule;
+      int64_t begin; // ns since beginJob
+      int64_t duration{-1}; // -1 until the end has been seen
+    };
+
+    struct ThreadBuffer {
+      explicit ThreadBuffer(unsigned const id) : tid{id} {}
+      unsigned tid;
+      vector<Record> records{};
+      // Complete events whose end has not yet been seen, with the
+      // index of their record (npos if they are not being recorded).
+      vector<pair<size_t, string const*>> open{};
+    };
+
+    struct Entry {
+      Record const* record;
+      unsigned tid;
+    };
+
+    int64_t
+    end_of(Record const& r)
+    {
+      return r.begin + r.duration;
+    }
+
+    double
+    seconds_from(int64_t const ns)
+    {
+      return ns * 1.e-9;
+    }
+
+    string const event_name{"event"};
+
+  } // unnamed namespace
+
+  class Timeline {
+  public:
+    static constexpr bool service_handle_allowed{false};
+
+    struct Config {
+      using Name = fhicl::Name;
+      using Comment = fhicl::Comment;
+      template <typename T>
+      using Atom = fhicl::Atom<T>;
+      template <typename T>
+      using OptionalAtom = fhicl::OptionalAtom<T>;
+      Atom<string> filename{Name{"filename"}, "timeline.json"};
+      Atom<unsigned> sampleEvery{
+        Name{"sampleEvery"},
+        Comment{"Only every N-th event read from the source (and the\n"
+                "processing of that event) is recorded."},
+        1u};
+      Atom<double> startAfter{
+        Name{"startAfter"},
+        Comment{"Number of seconds after beginJob before recording starts."},
+        0.};
+      OptionalAtom<double> stopAfter{
+        Name{"stopAfter"},
+        Comment{"Number of seconds after beginJob after which nothing\n"
+                "more is recorded.  By default, recording continues\n"
+                "until the end of the job."}};
+      Atom<bool> printAnalysis{
+        Name{"printAnalysis"},
+        Comment{"Log a critical-path and serialization analysis of the\n"
+                "recorded events at the end of the job."},
+        false};
+    };
+    using Parameters = ServiceTable<Config>;
+    Timeline(Parameters const&, ActivityRegistry&);
+
+  private:
+    void postSourceConstruction(ModuleDescription const&);
+    void postModuleConstruction(ModuleDescription const&);
+    void postModuleSharedResources(ModuleDescription const&,
+                                   set<string> const&);
+    void postBeginJob();
+    void postEndJob();
+
+    void preSourceAdvance(ScheduleContext);
+    void postSourceAdvance(ScheduleContext);
+    void preSourceEvent(ScheduleContext);
+    void postSourceEvent(Event const&, ScheduleContext);
+    void preProcessEvent(Event const&, ScheduleContext);
+    void postProcessEvent(Event const&, ScheduleContext);
+    void preProcessPath(PathContext const&);
+    void postProcessPath(PathContext const&, HLTPathStatus const&);
+    void preModule(ModuleContext const&, Category);
+    void postModule(ModuleContext const&);
+
+    int64_t now_() const;
+    bool recording_(ScheduleID, int64_t t) const;
+    void begin_(Category, string const*, ScheduleID);
+    void end_(string const*);
+    void async_(char phase, Category, string const*, ScheduleID);
+    vector<Entry> collect_() const;
+    void write_(vector<Entry> const&) const;
+    void analyze_(vector<Entry> const&) const;
+
+    string const filename_;
+    unsigned const sampleEvery_;
+    int64_t const startAfter_;
+    int64_t const stopAfter_;
+    bool const printAnalysis_;
+
+    string sourceType_{"source"};
+    // Filled while the modules are constructed; read-only afterwards.
+    // The elements provide stable names for the records.
+    unordered_set<string> moduleLabels_{};
+    // The shared resources of each serialized module.
+    map<string, set<string>> resources_{};
+
+    struct alignas(cache_line_size) PerSchedule {
+      bool sampled{};
+      int64_t idleSince{-1};
+      int64_t sourceWait{};
+      int64_t advanceStart{};
+      int64_t sourceAdvance{};
+      size_t events{};
+    };
+
+    clock_type::time_point jobStart_{};
+    int64_t jobEnd_{};
+    atomic<size_t> eventsRead_{};
+    // Only accessed by the tasks of the corresponding schedule.
+    vector<PerSchedule> schedules_;
+    atomic<unsigned> nextTid_{};
+    tbb::enumerable_thread_specific<ThreadBuffer> buffers_{
+      [this] { return ThreadBuffer{nextTid_++}; }};
+  };
+
+  Timeline::Timeline(Parameters const& config, ActivityRegistry& areg)
+    : filename_{config().filename()}
+    , sampleEvery_{config().sampleEvery()}
+    , startAfter_{static_cast<int64_t>(config().startAfter() * 1.e9)}
+    , stopAfter_{[&config] {
+      double t{};
+      return config().stopAfter(t) ? static_cast<int64_t>(t * 1.e9) :
+                                     numeric_limits<int64_t>::max();
+    }()}
+    , printAnalysis_{config().printAnalysis()}
+    , schedules_(Globals::instance()->nschedules())
+  {
+    if (sampleEvery_ == 0u) {
+      throw Exception{errors::Configuration}
+        << "The Timeline 'sampleEvery' parameter must be positive.\n";
+    }
+    areg.sPostSourceConstruction.watch(this, &Timeline::postSourceConstruction);
+    areg.sPostModuleConstruction.watch(this, &Timeline::postModuleConstruction);
+    areg.sPostModuleSharedResources.watch(this,
+                                          &Timeline::postModuleSharedResources);
+    areg.sPostBeginJob.watch(this, &Timeline::postBeginJob);
+    areg.sPostEndJob.watch(this, &Timeline::postEndJob);
+    areg.sPreSourceAdvance.watch(this, &Timeline::preSourceAdvance);
+    areg.sPostSourceAdvance.watch(this, &Timeline::postSourceAdvance);
+    areg.sPreSourceEvent.watch(this, &Timeline::preSourceEvent);
+    areg.sPostSourceEvent.watch(this, &Timeline::postSourceEvent);
+    areg.sPreProcessEvent.watch(this, &Timeline::preProcessEvent);
+    areg.sPostProcessEvent.watch(this, &Timeline::postProcessEvent);
+    areg.sPreProcessPath.watch(this, &Timeline::preProcessPath);
+    areg.sPostProcessPath.watch(this, &Timeline::postProcessPath);
+    areg.sPreModule.watch(
+      [this](auto const& mc) { preModule(mc, Category::module); });
+    areg.sPostModule.watch(this, &Timeline::postModule);
+    areg.sPreWriteEvent.watch(
+      [this](auto const& mc) { preModule(mc, Category::write); });
+    areg.sPostWriteEvent.watch(this, &Timeline::postModule);
+  }
+
+  void
+  Timeline::postSourceConstruction(ModuleDescription const& md)
+  {
+    sourceType_ = md.moduleName();
+  }
+
+  void
+  Timeline::postModuleConstruction(ModuleDescription const& md)
+  {
+    moduleLabels_.insert(md.moduleLabel());
+  }
+
+  void
+  Timeline::postModuleSharedResources(ModuleDescription const& md,
+                                      set<string> const& resources)
+  {
+    if (!resources.empty()) {
+      resources_[md.moduleLabel()] = resources;
+    }
+  }
+
+  void
+  Timeline::postBeginJob()
+  {
+    jobStart_ = clock_type::now();
+  }
+
+  void
+  Timeline::postEndJob()
+  {
+    jobEnd_ = now_();
+    auto const entries = collect_();
+    write_(entries);
+    if (printAnalysis_) {
+      analyze_(entries);
+    }
+  }
+
+  int64_t
+  Timeline::now_() const
+  {
+    return duration_cast<nanoseconds>(clock_type::now() - jobStart_).count();
+  }
+
+  bool
+  Timeline::recording_(ScheduleID const sid, int64_t const t) const
+  {
+    return schedules_[sid.id()].sampled && t >= startAfter_ &&
+           t < stopAfter_;
+  }
+
+  void
+  Timeline::begin_(Category const c,
+                   string const* name,
+                   ScheduleID const sid)
+  {
+    auto& buffer = buffers_.local();
+    auto const t = now_();
+    if (!recording_(sid, t)) {
+      // A task from another schedule may be run on this thread before
+      // this one ends; it must not be mistaken for the end.
+      buffer.open.emplace_back(string::npos, name);
+      return;
+    }
+    buffer.open.emplace_back(buffer.records.size(), name);
+    buffer.records.push_back(Record{'X', c, name, sid.id(), t});
+  }
+
+  void
+  Timeline::end_(string const* name)
+  {
+    auto& buffer = buffers_.local();
+    auto const t = now_();
+    // Complete events are strictly nested on a thread.  Begin records
+    // without an end (e.g. if a module threw) are discarded.
+    while (!buffer.open.empty()) {
+      auto const [index, open_name] = buffer.open.back();
+      buffer.open.pop_back();
+      if (index == string::npos) {
+        if (open_name == name) {
+          return;
+        }
+        continue;
+      }
+      auto& record = buffer.records[index];
+      if (open_name == name) {
+        record.duration = t - record.begin;
+        return;
+      }
+      record.duration = -1;
+    }
+  }
+
+  void
+  Timeline::async_(char const phase,
+                   Category const c,
+                   string const* name,
+                   ScheduleID const sid)
+  {
+    auto const t = now_();
+    // Unpaired begin and end records are discarded when writing.
+    if (!recording_(sid, t)) {
+      return;
+    }
+    buffers_.local().records.push_back(Record{phase, c, name, sid.id(), t});
+  }
+
+  // The advance signals and the event signal are emitted once the
+  // input source has been acquired, so the time since the schedule
+  // became idle was spent waiting for the source.  The time spent
+  // advancing the source is accounted for separately.
+  void
+  Timeline::preSourceAdvance(ScheduleContext const sc)
+  {
+    auto& schedule = schedules_[sc.id().id()];
+    auto const t = now_();
+    if (schedule.idleSince >= 0) {
+      schedule.sourceWait += t - schedule.idleSince;
+    }
+    schedule.advanceStart = t;
+  }
+
+  void
+  Timeline::postSourceAdvance(ScheduleContext const sc)
+  {
+    auto& schedule = schedules_[sc.id().id()];
+    auto const t = now_();
+    schedule.sourceAdvance += t - schedule.advanceStart;
+    // Until the event is read, the schedule waits for the source (e.g.
+    // while a new subrun is begun).
+    schedule.idleSince = t;
+  }
+
+  void
+  Timeline::preSourceEvent(ScheduleContext const sc)
+  {
+    auto& schedule = schedules_[sc.id().id()];
+    if (schedule.idleSince >= 0) {
+      schedule.sourceWait += now_() - schedule.idleSince;
+      schedule.idleSince = -1;
+    }
+    schedule.sampled = eventsRead_++ % sampleEvery_ == 0;
+    begin_(Category::source, &sourceType_, sc.id());
+  }
+
+  void
+  Timeline::postSourceEvent(Event const&, ScheduleContext)
+  {
+    end_(&sourceType_);
+  }
+
+  void
+  Timeline::preProcessEvent(Event const&, ScheduleContext const sc)
+  {
+    async_('b', Category::event, &event_name, sc.id());
+  }
+
+  void
+  Timeline::postProcessEvent(Event const&, ScheduleContext const sc)
+  {
+    async_('e', Category::event, &event_name, sc.id());
+    auto& schedule = schedules_[sc.id().id()];
+    ++schedule.events;
+    schedule.idleSince = now_();
+  }
+
+  void
+  Timeline::preProcessPath(PathContext const& pc)
+  {
+    // The path context is owned by its path, which outlives the job.
+    async_('b', Category::path, &pc.pathName(), pc.scheduleID());
+  }
+
+  void
+  Timeline::postProcessPath(PathContext const& pc, HLTPathStatus const&)
+  {
+    async_('e', Category::path, &pc.pathName(), pc.scheduleID());
+  }
+
+  void
+  Timeline::preModule(ModuleContext const& mc, Category const c)
+  {
+    auto const it = moduleLabels_.find(mc.moduleLabel());
+    if (it == cend(moduleLabels_)) {
+      // E.g. the framework's TriggerResults inserter.
+      return;
+    }
+    begin_(c, &*it, mc.scheduleID());
+  }
+
+  void
+  Timeline::postModule(ModuleContext const& mc)
+  {
+    auto const it = moduleLabels_.find(mc.moduleLabel());
+    if (it == cend(moduleLabels_)) {
+      return;
+    }
+    end_(&*it);
+  }
+
+  vector<Entry>
+  Timeline::collect_() const
+  {
+    vector<Entry> entries;
+    for (auto const& buffer : buffers_) {
+      for (auto const& record : buffer.records) {
+        entries.push_back(Entry{&record, buffer.tid});
+      }
+    }
+    sort(begin(entries), end(entries), [](auto const& a, auto const& b) {
+      return a.record->begin < b.record->begin;
+    });
+    return entries;
+  }
+
+  void
+  Timeline::write_(vector<Entry> const& entries) const
+  {
+
+    // Keep only asynchronous events whose begin and end were both
+    // recorded.
+    using Key = pair<ScheduleID::size_type, string const*>;
+    map<Key, size_t> pending;
+    vector<char> keep(entries.size());
+    for (size_t i = 0; i != entries.size(); ++i) {
+      auto const& r = *entries[i].record;
+      Key const key{r.schedule, r.name};
+      switch (r.phase) {
+      case 'X':
+        keep[i] = r.duration >= 0;
+        break;
+      case 'b':
+        pending[key] = i;
+        break;
+      case 'e':
+        if (auto it = pending.find(key); it != pending.end()) {
+          keep[it->second] = keep[i] = true;
+          pending.erase(it);
+        }
+      }
+    }
+
+    ofstream os{filename_};
+    os << "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[";
+    auto sep = "\n";
+    for (auto const& buffer : buffers_) {
+      auto const tid = buffer.tid;
+      os << sep << "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,"
+         << "\"tid\":" << tid << ",\"args\":{\"name\":\"art thread " << tid
+         << "\"}}";
+      sep = ",\n";
+    }
+    os << fixed << setprecision(3);
+    for (size_t i = 0; i != entries.size(); ++i) {
+      if (!keep[i]) {
+        continue;
+      }
+      auto const& [record, tid] = entries[i];
+      auto const& r = *record;
+      os << sep << "{\"name\":\"" << *r.name << "\",\"cat\":\""
+         << to_string(r.category) << "\",\"ph\":\"" << r.phase
+         << "\",\"pid\":1,\"tid\":" << tid << ",\"ts\":" << r.begin * 1.e-3;
+      if (r.phase == 'X') {
+        os << ",\"dur\":" << r.duration * 1.e-3;
+      } else {
+        os << ",\"id\":\"" << r.schedule << ':' << *r.name << '"';
+      }
+      os << ",\"args\":{\"schedule\":" << r.schedule << "}}";
+      sep = ",\n";
+    }
+    os << "\n]}\n";
+    if (!os) {
+      mf::LogWarning("Timeline")
+        << "Could not write the timeline to '" << filename_ << "'.";
+    }
+  }
+
+  void
+  Timeline::analyze_(vector<Entry> const& entries) const
+  {
+    // Calls of the source and of the modules (output writes are
+    // contained in the calls of the output modules), and the ends of
+    // the events, per schedule and in the order in which they started.
+    vector<vector<Record const*>> calls(schedules_.size());
+    for (auto const& entry : entries) {
+      auto const& r = *entry.record;
+      auto const is_call = r.phase == 'X' && r.duration >= 0 &&
+                           r.category != Category::write;
+      auto const is_event_end = r.phase == 'e' && r.category == Category::event;
+      if (is_call || is_event_end) {
+        calls[r.schedule].push_back(&r);
+      }
+    }
+
+    struct Summary {
+      bool isSource{false};
+      size_t calls{};
+      int64_t time{};
+      size_t critical{};
+      int64_t criticalTime{};
+      int64_t criticalWait{};
+      unsigned maxConcurrency{};
+      vector<pair<int64_t, int>> transitions{};
+    };
+    map<string, Summary> summaries;
+    size_t nevents{};
+    int64_t totalLatency{};
+    int64_t first{numeric_limits<int64_t>::max()};
+    int64_t last{};
+
+    auto const is_source = [](Record const* r) {
+      return r->phase == 'X' && r->category == Category::source;
+    };
+    auto const is_event_end = [](Record const* r) { return r->phase == 'e'; };
+    vector<Record const*> event;
+    for (auto const& records : calls) {
+      // Each event starts with the reading of it by the source.  An
+      // event whose end was not recorded was cut by the recording
+      // window; its critical path would be incomplete.
+      auto b = find_if(cbegin(records), cend(records), is_source);
+      while (b != cend(records)) {
+        auto const e = find_if(next(b), cend(records), is_source);
+        if (none_of(b, e, is_event_end)) {
+          b = e;
+          continue;
+        }
+        event.clear();
+        copy_if(b, e, back_inserter(event), not_fn(is_event_end));
+        b = e;
+
+        for (auto const* r : event) {
+          auto& summary = summaries[*r->name];
+          summary.isSource = is_source(r);
+          ++summary.calls;
+          summary.time += r->duration;
+          summary.transitions.emplace_back(r->begin, 1);
+          summary.transitions.emplace_back(end_of(*r), -1);
+          first = min(first, r->begin);
+          last = max(last, end_of(*r));
+        }
+
+        auto const by_end = [](Record const* x, Record const* y) {
+          return end_of(*x) < end_of(*y);
+        };
+        Record const* call = *max_element(cbegin(event), cend(event), by_end);
+        totalLatency += end_of(*call) - event.front()->begin;
+        ++nevents;
+        while (call != nullptr) {
+          Record const* predecessor{nullptr};
+          for (auto const* r : event) {
+            if (r->begin >= call->begin) {
+              break;
+            }
+            if (end_of(*r) <= call->begin &&
+                (predecessor == nullptr ||
+                 end_of(*r) > end_of(*predecessor))) {
+              predecessor = r;
+            }
+          }
+          auto& summary = summaries[*call->name];
+          ++summary.critical;
+          summary.criticalTime += call->duration;
+          if (predecessor != nullptr) {
+            summary.criticalWait += call->begin - end_of(*predecessor);
+          }
+          call = predecessor;
+        }
+      }
+    }
+
+    if (nevents == 0) {
+      mf::LogAbsolute("Timeline")
+        << "No events were recorded in full; no analysis is available.";
+      return;
+    }
+
+    for (auto& [label, summary] : summaries) {
+      auto& transitions = summary.transitions;
+      // Ends sort before starts at the same time.
+      sort(begin(transitions), end(transitions));
+      int concurrency{};
+      for (auto const& t : transitions) {
+        concurrency += t.second;
+        summary.maxConcurrency =
+          max(summary.maxConcurrency, static_cast<unsigned>(concurrency));
+      }
+    }
+
+    // The modules that use each shared resource; only one of them can
+    // process an event at any time.
+    map<string, vector<string const*>> users;
+    for (auto const& [label, summary] : summaries) {
+      if (auto it = resources_.find(label); it != cend(resources_)) {
+        for (auto const& resource : it->second) {
+          users[resource].push_back(&label);
+        }
+      }
+    }
+
+    // Throughput estimates (events per second).  Without serialization,
+    // the throughput is bounded by the number of events in flight
+    // divided by the mean critical-path length of an event.  The input
+    // source and each shared resource bound it by the inverse of the
+    // time per event for which they are held.
+    auto const globals = Globals::instance();
+    auto const nschedules = schedules_.size();
+    auto const inFlight = min<size_t>(nschedules, globals->nthreads());
+    auto const meanLatency = seconds_from(totalLatency) / nevents;
+    auto const parallelBound = inFlight / meanLatency;
+    auto const bound_without = [&](string const* excluded) {
+      auto result = parallelBound;
+      for (auto const& [label, summary] : summaries) {
+        if (summary.isSource) {
+          result = min(result, nevents / seconds_from(summary.time));
+        }
+      }
+      for (auto const& [resource, labels] : users) {
+        int64_t held{};
+        for (auto const* label : labels) {
+          if (label != excluded) {
+            held += summaries.at(*label).time;
+          }
+        }
+        if (held > 0) {
+          result = min(result, nevents / seconds_from(held));
+        }
+      }
+      return result;
+    };
+    auto const predicted = bound_without(nullptr);
+
+    size_t totalEvents{};
+    int64_t totalSourceWait{};
+    int64_t totalSourceAdvance{};
+    for (auto const& schedule : schedules_) {
+      totalEvents += schedule.events;
+      totalSourceWait += schedule.sourceWait;
+      totalSourceAdvance += schedule.sourceAdvance;
+    }
+    auto const wall = seconds_from(jobEnd_);
+    auto const window = seconds_from(last - first);
+
+    ostringstream msg;
+    cet::HorizontalRule const rule{100};
+    msg << '\n' << rule('=') << '\n'
+        << "Timeline analysis (" << nevents << " recorded events, "
+        << nschedules << " schedules, " << globals->nthreads()
+        << " threads)\n"
+        << rule('=') << '\n'
+        << fixed << setprecision(3) << "Observed throughput:     "
+        << totalEvents / wall << " events/s\n"
+        << "Mean event latency:      " << meanLatency << " s\n"
+        << "Estimated throughput:    " << predicted << " events/s\n"
+        << "Waiting for the source:  " << seconds_from(totalSourceWait)
+        << " s summed over schedules ("
+        << 100. * seconds_from(totalSourceWait) / (wall * nschedules)
+        << "% of the schedules' time)\n"
+        << "Advancing the source:    " << seconds_from(totalSourceAdvance)
+        << " s summed over schedules\n";
+
+    msg << rule('-') << '\n'
+        << left << setw(32) << "Module" << right << setw(10) << "Calls"
+        << setw(12) << "Mean (s)" << setw(12) << "On crit."
+        << setw(12) << "Crit. (s)" << setw(12) << "Wait (s)" << setw(10)
+        << "Max par." << '\n'
+        << rule('-') << '\n';
+    for (auto const& [label, s] : summaries) {
+      msg << left << setw(32) << label << right << setw(10) << s.calls
+          << setw(12) << seconds_from(s.time) / s.calls << setw(11)
+          << 100. * s.critical / nevents << '%' << setw(12)
+          << seconds_from(s.criticalTime) << setw(12)
+          << seconds_from(s.criticalWait) << setw(10) << s.maxConcurrency
+          << '\n';
+    }
+
+    msg << rule('-') << '\n'
+        << "Serialized modules (legacy, or shared with shared resources):\n";
+    bool any{false};
+    for (auto const& [label, s] : summaries) {
+      auto const it = resources_.find(label);
+      if (it == cend(resources_)) {
+        continue;
+      }
+      any = true;
+      string by;
+      for (auto const& resource : it->second) {
+        by += by.empty() ? "" : ", ";
+        if (resource == detail::LegacyResource.name) {
+          by += "legacy";
+        } else if (resource == label) {
+          by += "itself";
+        } else {
+          by += resource;
+        }
+      }
+      msg << "  " << left << setw(30) << label << right << " [" << by
+          << "] busy " << setw(7) << 100. * seconds_from(s.time) / window
+          << "% of the recorded window, estimated speedup if not "
+             "serialized: x"
+          << bound_without(&label) / predicted << '\n';
+    }
+    if (!any) {
+      msg << "  [ none ]\n";
+    }
+    msg << rule('=');
+    mf::LogAbsolute("Timeline") << msg.str();
+  }
+
+} // namespace art
+
+DECLARE_ART_SERVICE(art::Timeline, SHARED)
+DEFINE_ART_SERVICE(art::Timeline)
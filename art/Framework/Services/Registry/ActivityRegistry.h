@@ -24,6 +24,7 @@
 #include "art/Persistency/Provenance/ScheduleContext.h"
 
 #include <functional>
+#include <set>
 #include <string>
 #include <vector>
 
@@ -68,15 +69,23 @@ public:
   GlobalSignal<detail::SignalResponseType::LIFO, void(ModuleDescription const&)>
     sPostSourceConstruction;
 
-  // Signal is emitted before the source starts creating an Event
+  // Signals are emitted before and after the source creates an Event.
+  // Sources that hand out events without the input source lock (e.g.
+  // EmptyEvent with 'concurrentEvents' set) emit them outside that
+  // lock, so they may be emitted concurrently for different schedules.
   GlobalSignal<detail::SignalResponseType::FIFO, void(ScheduleContext)>
     sPreSourceEvent;
-
-  // Signal is emitted after the source starts creating an Event
   GlobalSignal<detail::SignalResponseType::LIFO,
                void(Event const&, ScheduleContext)>
     sPostSourceEvent;
 
+  // Signals are emitted before and after a schedule, holding the input
+  // source lock, advances the source to its next item in the event loop
+  GlobalSignal<detail::SignalResponseType::FIFO, void(ScheduleContext)>
+    sPreSourceAdvance;
+  GlobalSignal<detail::SignalResponseType::LIFO, void(ScheduleContext)>
+    sPostSourceAdvance;
+
   // Signal is emitted before the source starts creating a SubRun
   GlobalSignal<detail::SignalResponseType::FIFO, void()> sPreSourceSubRun;
 
@@ -132,7 +141,10 @@ public:
     sPostProcessEvent;
 
   // Signal is emitted after the event has been processed, but before
-  // the event has been written.
+  // the event has been written.  As for sPreModule, the write signals
+  // of different output modules (those with 'writeConcurrently' set)
+  // may be emitted concurrently for the same event; those of one
+  // module never are.
   GlobalSignal<detail::SignalResponseType::FIFO, void(ModuleContext const&)>
     sPreWriteEvent;
 
@@ -233,6 +245,13 @@ public:
   GlobalSignal<detail::SignalResponseType::LIFO, void(ModuleDescription const&)>
     sPostModuleConstruction;
 
+  // Signal is emitted after the module was constructed, with the names
+  // of the shared resources that serialize its event processing (empty
+  // if the module may process events concurrently)
+  GlobalSignal<detail::SignalResponseType::LIFO,
+               void(ModuleDescription const&, std::set<std::string> const&)>
+    sPostModuleSharedResources;
+
   // Signal is emitted before module does respondToOpenInputFile
   GlobalSignal<detail::SignalResponseType::FIFO, void(ModuleDescription const&)>
     sPreModuleRespondToOpenInputFile;
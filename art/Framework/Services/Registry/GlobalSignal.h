@@ -8,13 +8,18 @@
 // users wishing to register for callbacks; the invoke() and clear()
 // functions are intended to be called only by art code.
 //
+// The slots are registered while the services are constructed and are
+// stored contiguously, so that invoking a signal with no slots costs a
+// single test.  Callers may check empty() to avoid constructing
+// arguments that nobody would receive.
+//
 ////////////////////////////////////////////////////////////////////////
 
 #include "art/Framework/Services/Registry/detail/SignalResponseType.h"
 #include "art/Framework/Services/Registry/detail/makeWatchFunc.h"
 
-#include <deque>
 #include <functional>
+#include <vector>
 
 namespace art {
   template <detail::SignalResponseType, typename ResultType, typename... Args>
@@ -53,8 +58,14 @@ namespace art {
 
     void invoke(Args const&... args) const; // Discard ResultType.
 
+    bool
+    empty() const noexcept
+    {
+      return signal_.empty();
+    }
+
   private:
-    std::deque<slot_type> signal_;
+    std::vector<slot_type> signal_;
   };
 
   // 1.
@@ -126,7 +137,7 @@ namespace art {
   void
   GlobalSignal<SRTYPE, ResultType(Args...)>::invoke(Args const&... args) const
   {
-    for (auto f : signal_) {
+    for (auto const& f : signal_) {
       f(args...);
     }
   }
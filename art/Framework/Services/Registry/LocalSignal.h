@@ -17,13 +17,17 @@
 // invoke...() access should be only from within the correct schedule's
 // context so lock-free access to the correct signal is automatic and
 // safe.
+//
+// As for GlobalSignal, the slots of each schedule are stored
+// contiguously, and empty() allows callers to skip constructing the
+// arguments of a signal that has no slots.
 ////////////////////////////////////////////////////////////////////////
 #include "art/Framework/Services/Registry/detail/SignalResponseType.h"
 #include "art/Framework/Services/Registry/detail/makeWatchFunc.h"
 #include "art/Utilities/ScheduleID.h"
 
-#include <deque>
 #include <functional>
+#include <vector>
 
 namespace art {
   template <detail::SignalResponseType, typename ResultType, typename... Args>
@@ -40,7 +44,7 @@ namespace art {
 
   private:
     // Required for derivative alias below.
-    using ContainerType_ = std::vector<std::deque<slot_type>>;
+    using ContainerType_ = std::vector<std::vector<slot_type>>;
 
   public:
     using size_type = typename ContainerType_::size_type;
@@ -70,6 +74,12 @@ namespace art {
 
     void invoke(ScheduleID const, Args&&... args) const; // Discard ResultType.
 
+    bool
+    empty(ScheduleID const sID) const
+    {
+      return signals_.at(sID.id()).empty();
+    }
+
   private:
     ContainerType_ signals_;
   };
@@ -166,7 +176,7 @@ namespace art {
   LocalSignal<STYPE, ResultType(Args...)>::invoke(ScheduleID const sID,
                                                   Args&&... args) const
   {
-    for (auto f : signals_.at(sID.id())) {
+    for (auto const& f : signals_.at(sID.id())) {
       f(std::forward<Args>(args)...);
     }
   }
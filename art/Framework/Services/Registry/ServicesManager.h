@@ -6,12 +6,12 @@
 #include "art/Framework/Services/Registry/detail/ServiceHelper.h"
 #include "art/Framework/Services/Registry/detail/ServiceWrapper.h"
 #include "art/Framework/Services/Registry/detail/ServiceWrapperBase.h"
+#include "art/Utilities/PluginLibraryLoader.h"
 #include "art/Utilities/PluginSuffixes.h"
 #include "canvas/Persistency/Provenance/BranchDescription.h"
 #include "canvas/Utilities/Exception.h"
 #include "canvas/Utilities/TypeID.h"
 #include "cetlib/HorizontalRule.h"
-#include "cetlib/LibraryManager.h"
 #include "cetlib/bold_fontify.h"
 #include "cetlib_except/demangle.h"
 #include "fhiclcpp/fwd.h"
@@ -75,7 +75,7 @@ namespace art {
   private:
     ActivityRegistry& actReg_;
     detail::SharedResources& resources_;
-    cet::LibraryManager lm_{Suffixes::service()};
+    PluginLibraryLoader lm_{Suffixes::service()};
     std::map<TypeID, detail::ServiceCacheEntry> services_{};
     std::vector<TypeID> requestedCreationOrder_{};
     std::stack<std::shared_ptr<detail::ServiceWrapperBase>>
@@ -22,7 +22,7 @@ namespace art {
     std::enable_if_t<STYPE == SignalResponseType::LIFO>
     connect_to_signal(SIGNAL& s, FUNC f)
     {
-      s.emplace_front(f);
+      s.emplace(s.begin(), f);
     }
   } // namespace detail
 } // namespace art
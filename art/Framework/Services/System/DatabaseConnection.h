@@ -9,8 +9,10 @@
 #include "fhiclcpp/fwd.h"
 
 #include <memory>
+#include <mutex>
 #include <string>
 #include <utility>
+#include <vector>
 
 namespace art {
 
@@ -23,12 +25,28 @@ namespace art {
     std::unique_ptr<cet::sqlite::Connection>
     get(std::string const& filename, PolicyArgs&&... policyArgs)
     {
+      if (!filename.empty() && filename != ":memory:") {
+        std::lock_guard lock{filesMutex_};
+        files_.push_back(filename);
+      }
       return factory_.make_connection<DatabaseOpenPolicy>(
         filename, std::forward<PolicyArgs>(policyArgs)...);
     }
 
+    // The database files to which connections have been made, in
+    // order (in-memory databases excluded).  Such connections cannot
+    // be shared by forked processes.
+    std::vector<std::string>
+    files() const
+    {
+      std::lock_guard lock{filesMutex_};
+      return files_;
+    }
+
   private:
     cet::sqlite::ConnectionFactory factory_;
+    mutable std::mutex filesMutex_{};
+    std::vector<std::string> files_{};
   };
 
 } // namespace art
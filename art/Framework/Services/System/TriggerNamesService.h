@@ -22,16 +22,37 @@
 // process only.  The second getTrigPaths function is an exception.
 // It will return the trigger path names from previous processes.
 //
+// For per-event queries, the index-based functions are preferred to
+// pathResults, which builds a map of all path names for every call.
+// The path names of a TriggerResults object, and the index of each
+// name, are resolved once per trigger configuration (i.e. per
+// TriggerResults::parameterSetID()) and published; thereafter
+// pathNames, pathIndex and pathResult take no lock and do not
+// allocate.  For example:
+//
+//   auto const& tr = e.getProduct(triggerResultsToken);
+//   auto const i = triggerNames->pathIndex(tr, "p1");
+//   bool const accepted = tr.at(i).accept();
+//
+// All functions may be called concurrently from any schedule.
+//
 
 #include "art/Framework/Principal/fwd.h"
 #include "art/Framework/Services/Registry/detail/system_service_macros.h"
 #include "art/Persistency/Provenance/PathSpec.h"
 #include "canvas/Persistency/Common/HLTPathStatus.h"
 #include "canvas/Persistency/Common/TriggerResults.h"
+#include "fhiclcpp/ParameterSetID.h"
 #include "fhiclcpp/fwd.h"
 
+#include <atomic>
+#include <cstddef>
 #include <functional>
+#include <map>
+#include <memory>
+#include <mutex>
 #include <string>
+#include <unordered_map>
 #include <vector>
 
 namespace art {
@@ -55,6 +76,16 @@ namespace art {
       Event const& e,
       std::string const& process_name = "current_process") const;
 
+    // The names of the paths whose statuses are recorded in the
+    // TriggerResults object, in the same order.
+    std::vector<std::string> const& pathNames(TriggerResults const& tr) const;
+    // The index of the named path in the TriggerResults object.
+    // Throws if there is no such path.
+    std::size_t pathIndex(TriggerResults const& tr,
+                          std::string const& path_name) const;
+    HLTPathStatus const& pathResult(TriggerResults const& tr,
+                                    std::string const& path_name) const;
+
     // Current process only
     std::string const& getProcessName() const;
     std::vector<std::string> const& getTrigPaths() const;
@@ -73,11 +104,33 @@ namespace art {
       std::vector<std::vector<std::string>> moduleNames{};
     };
 
+    struct PathTable {
+      std::vector<std::string> names{};
+      std::unordered_map<std::string, std::size_t> indices{};
+    };
+
   private:
+    using path_tables_t =
+      std::map<fhicl::ParameterSetID, PathTable const*>;
+
     size_t index_(detail::entry_selector_t selector) const;
     DataPerProcess const& currentData_() const;
-
-    std::map<std::string, DataPerProcess> mutable dataPerProcess_;
+    PathTable const& pathTable_(TriggerResults const& tr) const;
+    // Called with publishMutex_ held, or from the constructor.
+    PathTable const& publish_(fhicl::ParameterSetID const& id,
+                              std::vector<std::string> names) const;
+
+    DataPerProcess const currentProcessData_;
+    // The path tables per trigger configuration.  A published map is
+    // never modified: a configuration is added by publishing an
+    // extended copy.  Tables and superseded maps are kept until the
+    // service is destroyed, so readers need no lock.  The mutex
+    // serializes publishers only.
+    std::atomic<path_tables_t const*> mutable pathTables_{nullptr};
+    std::vector<std::unique_ptr<PathTable const>> mutable tables_{};
+    std::vector<std::unique_ptr<path_tables_t const>> mutable
+      publishedTables_{};
+    std::mutex mutable publishMutex_{};
   };
 
 } // namespace art
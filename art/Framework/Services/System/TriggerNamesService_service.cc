@@ -4,18 +4,18 @@
 #include "art/Persistency/Provenance/PathSpec.h"
 #include "art/Utilities/Globals.h"
 #include "canvas/Persistency/Common/TriggerResults.h"
-#include "canvas/Persistency/Provenance/ProcessConfiguration.h"
-#include "canvas/Persistency/Provenance/ProcessHistory.h"
 #include "fhiclcpp/ParameterSet.h"
 #include "fhiclcpp/ParameterSetRegistry.h"
 
 // vim: set sw=2 expandtab :
 
 #include <algorithm>
+#include <atomic>
 #include <cassert>
 #include <cstddef>
 #include <limits>
-#include <optional>
+#include <memory>
+#include <mutex>
 #include <string>
 #include <vector>
 
@@ -71,15 +71,15 @@ namespace art {
   TriggerNamesService::TriggerNamesService(
     ParameterSet const& trigger_paths_pset,
     ParameterSet const& physics_pset)
+    : currentProcessData_{data_for_process(trigger_paths_pset, physics_pset)}
   {
-    dataPerProcess_.try_emplace(
-      getProcessName(), data_for_process(trigger_paths_pset, physics_pset));
+    publish_(trigger_paths_pset.id(), currentProcessData_.triggerPathNames);
   }
 
   DataPerProcess const&
   TriggerNamesService::currentData_() const
   {
-    return dataPerProcess_.at(getProcessName());
+    return currentProcessData_;
   }
 
   // =================================================================================
@@ -100,35 +100,97 @@ namespace art {
                                    string const& process_name) const
   {
     auto const& tr = triggerResults(e, process_name);
-    auto const& pname =
-      process_name == "current_process" ? getProcessName() : process_name;
-
-    auto it = dataPerProcess_.find(process_name);
-    if (it == cend(dataPerProcess_)) {
-      auto config = e.processHistory().getConfigurationForProcess(pname);
-      if (not config) {
-        throw lookup_exception(pname)
-          << "Could not locate process configuration for the process '" << pname
-          << "'\n"
-          << "This can happen if the ParameterSets were dropped on input.\n"
-          << "Please contact artists@fnal.gov for guidance.\n";
+    auto const& names = pathNames(tr);
+
+    map<string, HLTPathStatus> result;
+    for (size_t i = 0, n = tr.size(); i != n; ++i) {
+      result.try_emplace(names[i], tr.at(i));
+    }
+    return result;
+  }
+
+  TriggerNamesService::PathTable const&
+  TriggerNamesService::publish_(ParameterSetID const& id,
+                                vector<string> names) const
+  {
+    PathTable table{std::move(names)};
+    for (size_t i = 0, n = size(table.names); i != n; ++i) {
+      table.indices.try_emplace(table.names[i], i);
+    }
+    auto const& result =
+      *tables_.emplace_back(make_unique<PathTable const>(std::move(table)));
+    auto const current = pathTables_.load(memory_order_relaxed);
+    auto tables = current == nullptr ? make_unique<path_tables_t>() :
+                                       make_unique<path_tables_t>(*current);
+    tables->try_emplace(id, &result);
+    pathTables_.store(publishedTables_.emplace_back(std::move(tables)).get(),
+                      memory_order_release);
+    return result;
+  }
+
+  TriggerNamesService::PathTable const&
+  TriggerNamesService::pathTable_(TriggerResults const& tr) const
+  {
+    auto const& id = tr.parameterSetID();
+    {
+      auto const tables = pathTables_.load(memory_order_acquire);
+      if (auto it = tables->find(id); it != tables->cend()) {
+        return *it->second;
       }
+    }
 
-      auto const& trigger_pset = ParameterSetRegistry::get(tr.parameterSetID());
-      auto const& pset = ParameterSetRegistry::get(config->parameterSetID());
-      auto data =
-        data_for_process(trigger_pset, pset.get<ParameterSet>("physics"));
-      it = dataPerProcess_.try_emplace(process_name, std::move(data)).first;
+    std::lock_guard sentry{publishMutex_};
+    // Another schedule may have published the table meanwhile.
+    auto const tables = pathTables_.load(memory_order_relaxed);
+    if (auto it = tables->find(id); it != tables->cend()) {
+      return *it->second;
+    }
+    ParameterSet trigger_pset;
+    if (!ParameterSetRegistry::get(id, trigger_pset)) {
+      throw Exception{errors::OtherArt}
+        << "The trigger path names for the TriggerResults with parameter "
+           "set ID "
+        << id.to_string() << " could not be found.\n"
+        << "This can happen if the ParameterSets were dropped on input.\n"
+        << "Please contact artists@fnal.gov for guidance.\n";
+    }
+    vector<string> names;
+    for (auto const& spec :
+         path_specs(trigger_pset.get<vector<string>>("trigger_paths"))) {
+      names.push_back(spec.name);
     }
+    return publish_(id, std::move(names));
+  }
 
-    auto const& names = it->second.triggerPathNames;
+  vector<string> const&
+  TriggerNamesService::pathNames(TriggerResults const& tr) const
+  {
+    auto const& names = pathTable_(tr).names;
     assert(size(names) == tr.size());
+    return names;
+  }
 
-    map<string, HLTPathStatus> result;
-    for (size_t i = 0, n = tr.size(); i != n; ++i) {
-      result.try_emplace(names[i], tr.at(i));
+  size_t
+  TriggerNamesService::pathIndex(TriggerResults const& tr,
+                                 string const& path_name) const
+  {
+    auto const& table = pathTable_(tr);
+    assert(size(table.names) == tr.size());
+    auto const it = table.indices.find(path_name);
+    if (it == cend(table.indices)) {
+      throw Exception{errors::OtherArt}
+        << "No trigger path named '" << path_name
+        << "' is recorded in the TriggerResults with parameter set ID "
+        << tr.parameterSetID().to_string() << ".\n";
     }
-    return result;
+    return it->second;
+  }
+
+  HLTPathStatus const&
+  TriggerNamesService::pathResult(TriggerResults const& tr,
+                                  string const& path_name) const
+  {
+    return tr.at(pathIndex(tr, path_name));
   }
 
   // =================================================================================
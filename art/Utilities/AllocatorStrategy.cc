@@ -0,0 +1,79 @@
+#include "art/Utilities/AllocatorStrategy.h"
+// vim: set sw=2 expandtab :
+
+#include "canvas/Utilities/Exception.h"
+
+#ifdef __linux__
+#include <dlfcn.h>
+#include <malloc.h>
+#endif // __linux__
+
+using namespace std;
+
+namespace {
+  string description{"glibc1"};
+
+  // Whether TBB's malloc replacement has been loaded into the process.
+  bool
+  tbbmalloc_proxy_loaded()
+  {
+#ifdef __linux__
+    for (auto const name : {"libtbbmalloc_proxy.so.2",
+                            "libtbbmalloc_proxy.so"}) {
+      if (auto handle = dlopen(name, RTLD_LAZY | RTLD_NOLOAD)) {
+        dlclose(handle);
+        return true;
+      }
+    }
+#endif // __linux__
+    return false;
+  }
+}
+
+namespace art {
+
+  void
+  configure_allocator(string const& strategy, unsigned const arenaMax)
+  {
+    if (strategy == "glibc1") {
+#ifdef __linux__
+      // The arenas are 64 MiB in size, and the default is 8 *
+      // num_of_cores.  Using the default means that when using 40
+      // threads we get 40 arenas, which means we have 40 * 64 MiB =
+      // 2560 MiB of virtual address space devoted to per-thread heaps.
+      mallopt(M_ARENA_MAX, 1);
+#endif // __linux__
+      description = strategy;
+    } else if (strategy == "glibcN") {
+#ifdef __linux__
+      if (arenaMax != 0) {
+        mallopt(M_ARENA_MAX, arenaMax);
+      }
+#endif // __linux__
+      description = strategy + " (arena_max: " +
+                    (arenaMax == 0 ? "system default" : to_string(arenaMax)) +
+                    ")";
+    } else if (strategy == "tbbmalloc") {
+      if (!tbbmalloc_proxy_loaded()) {
+        throw Exception{errors::Configuration}
+          << "The 'tbbmalloc' allocator was requested, but TBB's malloc "
+             "replacement is not loaded.\n"
+             "Run art with LD_PRELOAD=libtbbmalloc_proxy.so.2, or choose "
+             "'glibc1' or 'glibcN'.\n";
+      }
+      description = strategy;
+    } else {
+      throw Exception{errors::Configuration}
+        << "Unknown allocator strategy '" << strategy
+        << "'; the supported strategies are 'glibc1', 'glibcN' and "
+           "'tbbmalloc'.\n";
+    }
+  }
+
+  string const&
+  allocator_description()
+  {
+    return description;
+  }
+
+} // namespace art
@@ -0,0 +1,40 @@
+#ifndef art_Utilities_AllocatorStrategy_h
+#define art_Utilities_AllocatorStrategy_h
+// vim: set sw=2 expandtab :
+
+// ======================================================================
+// The memory-allocation strategy of the process, selected by the
+// services.scheduler.allocator parameter:
+//
+//   glibc1    - the system allocator with a single arena (default),
+//               which minimizes the virtual address space at the cost
+//               of lock contention between threads;
+//   glibcN    - the system allocator with up to 'arena_max' arenas
+//               (its own default if zero), each of which reserves
+//               64 MiB of address space;
+//   tbbmalloc - TBB's scalable allocator, which must replace malloc
+//               when the program is loaded, e.g. through
+//               LD_PRELOAD=libtbbmalloc_proxy.so.2.
+//
+// configure_allocator must be called once, before any threads are
+// started.  It throws a Configuration exception for an unknown
+// strategy, or if 'tbbmalloc' is requested but not in effect.
+// ======================================================================
+
+#include <string>
+
+namespace art {
+
+  void configure_allocator(std::string const& strategy, unsigned arenaMax);
+
+  // The strategy in effect, as for the job summary (e.g. "glibcN
+  // (arena_max: 8)").
+  std::string const& allocator_description();
+
+} // namespace art
+
+#endif /* art_Utilities_AllocatorStrategy_h */
+
+// Local Variables:
+// mode: c++
+// End:
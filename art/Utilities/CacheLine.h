@@ -0,0 +1,26 @@
+#ifndef art_Utilities_CacheLine_h
+#define art_Utilities_CacheLine_h
+// vim: set sw=2 expandtab :
+
+// ======================================================================
+// The assumed size of a cache line.  Data that is updated frequently
+// by one thread (e.g. execution counters) is aligned to this boundary
+// so that it does not share a cache line with data that other threads
+// are updating at the same time.
+//
+// std::hardware_destructive_interference_size is not used because its
+// value may differ between translation units compiled with different
+// tuning flags, which would make it unsuitable for class layouts.
+// ======================================================================
+
+#include <cstddef>
+
+namespace art {
+  inline constexpr std::size_t cache_line_size{64};
+}
+
+#endif /* art_Utilities_CacheLine_h */
+
+// Local Variables:
+// mode: c++
+// End:
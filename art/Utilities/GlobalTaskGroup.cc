@@ -7,8 +7,9 @@ art::GlobalTaskGroup::GlobalTaskGroup(unsigned const n_threads,
 {}
 
 void
-art::GlobalTaskGroup::may_run(hep::concurrency::WaitingTaskPtr task,
-                              std::exception_ptr ex_ptr)
+art::detail::may_run(tbb::task_group& group,
+                     hep::concurrency::WaitingTaskPtr task,
+                     std::exception_ptr ex_ptr)
 {
   // A non-null exception pointer is always registered with the task
   // even if the task's 'done' count will not yet decrement to zero.
@@ -18,6 +19,13 @@ art::GlobalTaskGroup::may_run(hep::concurrency::WaitingTaskPtr task,
     task->dependentTaskFailed(ex_ptr);
   }
   if (task->decrement_done_count() == 0u) {
-    group_.run([t = std::move(task)] { (*t)(); });
+    group.run([t = std::move(task)] { (*t)(); });
   }
 }
+
+void
+art::GlobalTaskGroup::may_run(hep::concurrency::WaitingTaskPtr task,
+                              std::exception_ptr ex_ptr)
+{
+  detail::may_run(group_, std::move(task), ex_ptr);
+}
@@ -8,6 +8,14 @@
 #include <exception>
 
 namespace art {
+  namespace detail {
+    // Launch the task onto the group once its 'done' count reaches
+    // zero, registering the exception, if any, with it.
+    void may_run(tbb::task_group& group,
+                 hep::concurrency::WaitingTaskPtr task,
+                 std::exception_ptr ex_ptr = {});
+  }
+
   class GlobalTaskGroup {
   public:
     GlobalTaskGroup(unsigned n_threads, unsigned stack_size);
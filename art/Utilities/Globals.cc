@@ -80,4 +80,28 @@ namespace art {
     triggerPathNames_ = triggerPathNames;
   }
 
+  unsigned
+  Globals::processIndex() const
+  {
+    return processIndex_;
+  }
+
+  void
+  Globals::setProcessIndex(unsigned const processIndex)
+  {
+    processIndex_ = processIndex;
+  }
+
+  bool
+  Globals::recordProvenance() const
+  {
+    return recordProvenance_;
+  }
+
+  void
+  Globals::setRecordProvenance(bool const recordProvenance)
+  {
+    recordProvenance_ = recordProvenance;
+  }
+
 } // namespace art
@@ -11,6 +11,8 @@
 namespace art {
 
   class Globals {
+    friend class EventProcessor;
+    friend class ForkCoordinator;
     friend class PathManager;
     friend class Scheduler;
 
@@ -27,6 +29,13 @@ namespace art {
     std::string const& processName() const;
     fhicl::ParameterSet const& triggerPSet() const;
     std::vector<std::string> const& triggerPathNames() const;
+    // Index of this process among the worker processes of a job run
+    // with --fork; zero otherwise.
+    unsigned processIndex() const;
+    // Whether the parentage of produced products and the process
+    // histories of events are recorded.  They are needed only by
+    // output modules and by modules inspecting provenance.
+    bool recordProvenance() const;
 
   private:
     Globals();
@@ -36,9 +45,13 @@ namespace art {
     void setProcessName(std::string const&);
     void setTriggerPSet(fhicl::ParameterSet const&);
     void setTriggerPathNames(std::vector<std::string> const&);
+    void setProcessIndex(unsigned);
+    void setRecordProvenance(bool);
 
     int nschedules_{1};
     int nthreads_{1};
+    unsigned processIndex_{0};
+    bool recordProvenance_{true};
     std::string processName_;
 
     // Parameter set of trigger paths, the key is "trigger_paths",
@@ -0,0 +1,67 @@
+#ifndef art_Utilities_PluginFactory_h
+#define art_Utilities_PluginFactory_h
+// vim: set sw=2 expandtab :
+
+// ======================================================================
+// PluginFactory: the interface of cet::BasicPluginFactory, for tools
+// and other plugins, with the libraries obtained through a
+// PluginLibraryLoader so that indexed plugins are found without
+// scanning the plugin path.
+// ======================================================================
+
+#include "art/Utilities/PluginLibraryLoader.h"
+#include "art/Utilities/PluginSuffixes.h"
+
+#include <functional>
+#include <string>
+#include <type_traits>
+#include <utility>
+
+namespace art {
+
+  class PluginFactory {
+  public:
+    explicit PluginFactory(std::string const& suffix = Suffixes::plugin(),
+                           std::string makerName = "makePlugin",
+                           std::string pluginTypeFuncName = "pluginType")
+      : loader_{suffix}
+      , makerName_{std::move(makerName)}
+      , pluginTypeFuncName_{std::move(pluginTypeFuncName)}
+    {}
+
+    std::string
+    pluginType(std::string const& libspec) const
+    {
+      return loader_.getSymbolByLibspec<std::string (*)()>(
+        libspec, pluginTypeFuncName_)();
+    }
+
+    template <typename RESULT_TYPE, typename... ARGS>
+    std::enable_if_t<!std::is_function_v<RESULT_TYPE>, RESULT_TYPE>
+    makePlugin(std::string const& libspec, ARGS&&... args) const
+    {
+      return loader_.getSymbolByLibspec<RESULT_TYPE (*)(ARGS...)>(
+        libspec, makerName_)(std::forward<ARGS>(args)...);
+    }
+
+    template <typename FUNCTION_TYPE>
+    std::enable_if_t<std::is_function_v<FUNCTION_TYPE>,
+                     std::function<FUNCTION_TYPE>>
+    makePlugin(std::string const& libspec) const
+    {
+      return loader_.getSymbolByLibspec<FUNCTION_TYPE*>(libspec, makerName_);
+    }
+
+  private:
+    PluginLibraryLoader const loader_;
+    std::string const makerName_;
+    std::string const pluginTypeFuncName_;
+  };
+
+} // namespace art
+
+#endif /* art_Utilities_PluginFactory_h */
+
+// Local Variables:
+// mode: c++
+// End:
@@ -0,0 +1,197 @@
+#include "art/Utilities/PluginIndex.h"
+// vim: set sw=2 expandtab :
+
+#include "cetlib/LibraryManager.h"
+
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+#include <istream>
+#include <ostream>
+#include <set>
+#include <system_error>
+
+using namespace std;
+
+namespace {
+  string const magic{"art_plugin_index"};
+  string const path_key{"plugin_path"};
+  string const directory_key{"directory"};
+  string const plugin_key{"plugin"};
+
+  // The path searched by cet::LibraryManager.
+  string
+  plugin_path()
+  {
+    for (auto const name : {"CET_PLUGIN_PATH", "LD_LIBRARY_PATH"}) {
+      if (auto const value = getenv(name)) {
+        return value;
+      }
+    }
+    return {};
+  }
+
+  long long
+  modification_time(string const& path)
+  {
+    error_code ec;
+    auto const time = filesystem::last_write_time(path, ec);
+    return ec ? -1ll : static_cast<long long>(time.time_since_epoch().count());
+  }
+
+  vector<string>
+  split(string const& line, char const delimiter)
+  {
+    vector<string> result;
+    string::size_type begin{};
+    while (true) {
+      auto const end = line.find(delimiter, begin);
+      result.push_back(line.substr(begin, end - begin));
+      if (end == string::npos) {
+        return result;
+      }
+      begin = end + 1;
+    }
+  }
+}
+
+namespace art {
+
+  PluginIndex const&
+  PluginIndex::instance()
+  {
+    static PluginIndex const index = [] {
+      auto const filename = getenv("ART_PLUGIN_INDEX");
+      if (filename == nullptr || *filename == '\0') {
+        return PluginIndex{};
+      }
+      ifstream is{filename};
+      return is ? PluginIndex{is} : PluginIndex{};
+    }();
+    return index;
+  }
+
+  PluginIndex::PluginIndex(istream& is)
+  {
+    string line;
+    if (!getline(is, line) ||
+        line != magic + '\t' + to_string(version())) {
+      return;
+    }
+    auto path = plugin_path();
+    if (!getline(is, line) || line != path_key + '\t' + path) {
+      return;
+    }
+    decltype(directories_) directories;
+    decltype(entries_) entries;
+    while (getline(is, line)) {
+      auto const fields = split(line, '\t');
+      if (fields[0] == directory_key && fields.size() == 3) {
+        auto const modified = atoll(fields[2].c_str());
+        if (modified != modification_time(fields[1])) {
+          // The directory has changed since the index was made.
+          return;
+        }
+        directories.emplace_back(fields[1], modified);
+      } else if (fields[0] == plugin_key && fields.size() == 6) {
+        entries.emplace(pair{fields[1], fields[2]},
+                        Entry{fields[3], fields[5], atoll(fields[4].c_str())});
+      }
+    }
+    path_ = move(path);
+    directories_ = move(directories);
+    entries_ = move(entries);
+  }
+
+  PluginIndex
+  PluginIndex::make(vector<string> const& suffixes,
+                    type_resolver const& type_of)
+  {
+    PluginIndex result;
+    result.path_ = plugin_path();
+    for (auto const& directory : split(result.path_, ':')) {
+      if (!directory.empty()) {
+        result.directories_.emplace_back(directory,
+                                         modification_time(directory));
+      }
+    }
+    for (auto const& suffix : suffixes) {
+      cet::LibraryManager const lm{suffix};
+      vector<string> libraries;
+      lm.getLoadableLibraries(libraries);
+      map<string, string> found;
+      set<string> ambiguous;
+      for (auto const& library : libraries) {
+        auto const [short_spec, long_spec] = specs_for(library, suffix);
+        for (auto const& spec : {short_spec, long_spec}) {
+          if (spec.empty()) {
+            continue;
+          }
+          if (auto const [it, inserted] = found.emplace(spec, library);
+              !inserted && it->second != library) {
+            ambiguous.insert(spec);
+          }
+        }
+      }
+      map<string, string> types;
+      for (auto const& [spec, library] : found) {
+        if (ambiguous.count(spec) != 0) {
+          continue;
+        }
+        auto const [it, inserted] = types.try_emplace(library);
+        if (inserted && type_of) {
+          it->second = type_of(suffix, specs_for(library, suffix).second);
+        }
+        result.entries_.emplace(
+          pair{suffix, spec},
+          Entry{library, it->second, modification_time(library)});
+      }
+    }
+    return result;
+  }
+
+  pair<string, string>
+  PluginIndex::specs_for(string const& library, string const& suffix)
+  {
+    auto name = library.substr(library.find_last_of('/') + 1);
+    auto const end = name.rfind('_' + suffix + '.');
+    if (name.compare(0, 3, "lib") != 0 || end == string::npos || end <= 3) {
+      return {};
+    }
+    name = name.substr(3, end - 3);
+    auto const short_spec = name.substr(name.find_last_of('_') + 1);
+    for (auto& c : name) {
+      if (c == '_') {
+        c = '/';
+      }
+    }
+    return {short_spec, name};
+  }
+
+  PluginIndex::Entry const*
+  PluginIndex::find(string const& suffix, string const& spec) const
+  {
+    auto const it = entries_.find(pair{suffix, spec});
+    if (it == entries_.cend() ||
+        it->second.modified != modification_time(it->second.library)) {
+      return nullptr;
+    }
+    return &it->second;
+  }
+
+  void
+  PluginIndex::write(ostream& os) const
+  {
+    os << magic << '\t' << version() << '\n';
+    os << path_key << '\t' << path_ << '\n';
+    for (auto const& [directory, modified] : directories_) {
+      os << directory_key << '\t' << directory << '\t' << modified << '\n';
+    }
+    for (auto const& [key, entry] : entries_) {
+      os << plugin_key << '\t' << key.first << '\t' << key.second << '\t'
+         << entry.library << '\t' << entry.modified << '\t' << entry.type
+         << '\n';
+    }
+  }
+
+} // namespace art
@@ -0,0 +1,98 @@
+#ifndef art_Utilities_PluginIndex_h
+#define art_Utilities_PluginIndex_h
+// vim: set sw=2 expandtab :
+
+// ======================================================================
+// PluginIndex: a persistent map from plugin specification (short, e.g.
+// "EmptyEvent", or long, e.g. "art/Framework/Modules/EmptyEvent") and
+// plugin suffix (e.g. "source") to the library providing the plugin,
+// and to the plugin's type where one can be determined.
+//
+// Resolving a specification otherwise requires scanning every
+// directory on the plugin path (CET_PLUGIN_PATH or, if it is not set,
+// LD_LIBRARY_PATH).  The index is written by the 'make-plugin-index'
+// program, typically when the software is installed, and is used when
+// the ART_PLUGIN_INDEX environment variable names it.
+//
+// The index records the version of its format, the plugin path for
+// which it was made, and the modification times of the directories on
+// that path and of each indexed library.  An index of another version,
+// for another path, or for a directory that has since changed (a
+// library added, removed or renamed) is ignored as a whole; a library
+// modified since the index was made is not resolved through the index.
+// In either case the usual scan is done instead.  Specifications that
+// were ambiguous when the index was made are not indexed, so that the
+// scan reports them as usual.
+// ======================================================================
+
+#include <functional>
+#include <iosfwd>
+#include <map>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace art {
+
+  class PluginIndex {
+  public:
+    struct Entry {
+      std::string library;
+      std::string type;
+      long long modified;
+    };
+
+    // The type of the plugin with the given suffix and long
+    // specification, or an empty string.
+    using type_resolver =
+      std::function<std::string(std::string const&, std::string const&)>;
+
+    static constexpr unsigned
+    version() noexcept
+    {
+      return 2u;
+    }
+
+    // The index named by ART_PLUGIN_INDEX, or an empty index.
+    static PluginIndex const& instance();
+
+    PluginIndex() = default;
+    explicit PluginIndex(std::istream& is);
+
+    // Index the libraries with the given suffixes that can be found
+    // on the current plugin path.
+    static PluginIndex make(std::vector<std::string> const& suffixes,
+                            type_resolver const& type_of = {});
+
+    // The short and long specifications of the plugin provided by
+    // 'library', whose file name must be lib<long specification, with
+    // '/' replaced by '_'>_<suffix>.so; empty strings otherwise.
+    static std::pair<std::string, std::string> specs_for(
+      std::string const& library,
+      std::string const& suffix);
+
+    // The entry for the plugin, or nullptr if it is not indexed or its
+    // library has been modified since the index was made.
+    Entry const* find(std::string const& suffix,
+                      std::string const& spec) const;
+    bool
+    empty() const noexcept
+    {
+      return entries_.empty();
+    }
+
+    void write(std::ostream& os) const;
+
+  private:
+    std::string path_{};
+    std::vector<std::pair<std::string, long long>> directories_{};
+    std::map<std::pair<std::string, std::string>, Entry> entries_{};
+  };
+
+} // namespace art
+
+#endif /* art_Utilities_PluginIndex_h */
+
+// Local Variables:
+// mode: c++
+// End:
@@ -0,0 +1,42 @@
+#include "art/Utilities/PluginLibraryLoader.h"
+// vim: set sw=2 expandtab :
+
+#include "art/Utilities/PluginIndex.h"
+
+#include <dlfcn.h>
+
+using namespace std;
+
+namespace art {
+
+  PluginLibraryLoader::PluginLibraryLoader(string suffix)
+    : suffix_{move(suffix)}
+  {}
+
+  void*
+  PluginLibraryLoader::indexedSymbol_(string const& libspec,
+                                      string const& sym_name) const
+  {
+    auto const entry = PluginIndex::instance().find(suffix_, libspec);
+    if (entry == nullptr) {
+      return nullptr;
+    }
+    // Loaded as cet::LibraryManager would; the library stays loaded
+    // for the rest of the job.  Any failure is left to the scan to
+    // report.
+    auto const handle = dlopen(entry->library.c_str(), RTLD_LAZY | RTLD_GLOBAL);
+    if (handle == nullptr) {
+      return nullptr;
+    }
+    return dlsym(handle, sym_name.c_str());
+  }
+
+  cet::LibraryManager const&
+  PluginLibraryLoader::libraryManager_() const
+  {
+    call_once(scanned_,
+              [this] { lm_ = make_unique<cet::LibraryManager>(suffix_); });
+    return *lm_;
+  }
+
+} // namespace art
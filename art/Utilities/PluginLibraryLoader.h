@@ -0,0 +1,75 @@
+#ifndef art_Utilities_PluginLibraryLoader_h
+#define art_Utilities_PluginLibraryLoader_h
+// vim: set sw=2 expandtab :
+
+// ======================================================================
+// PluginLibraryLoader: obtain symbols from the plugin libraries with a
+// given suffix, resolving plugin specifications through the
+// PluginIndex when possible.
+//
+// The cet::LibraryManager, whose construction scans the plugin path,
+// is created only for specifications that the index cannot resolve,
+// so that a job whose plugins are all indexed does no scan at all.
+// ======================================================================
+
+#include "cetlib/LibraryManager.h"
+
+#include <memory>
+#include <mutex>
+#include <string>
+
+namespace art {
+
+  class PluginLibraryLoader {
+  public:
+    explicit PluginLibraryLoader(std::string suffix);
+
+    template <typename T>
+    void getSymbolByLibspec(std::string const& libspec,
+                            std::string const& sym_name,
+                            T& sym) const;
+    template <typename T>
+    T getSymbolByLibspec(std::string const& libspec,
+                         std::string const& sym_name) const;
+
+  private:
+    // The symbol from the indexed library, or nullptr.
+    void* indexedSymbol_(std::string const& libspec,
+                         std::string const& sym_name) const;
+    cet::LibraryManager const& libraryManager_() const;
+
+    std::string const suffix_;
+    mutable std::once_flag scanned_{};
+    mutable std::unique_ptr<cet::LibraryManager> lm_{nullptr};
+  };
+
+  template <typename T>
+  void
+  PluginLibraryLoader::getSymbolByLibspec(std::string const& libspec,
+                                          std::string const& sym_name,
+                                          T& sym) const
+  {
+    if (auto const symbol = indexedSymbol_(libspec, sym_name)) {
+      sym = reinterpret_cast<T>(symbol);
+      return;
+    }
+    libraryManager_().getSymbolByLibspec(libspec, sym_name, sym);
+  }
+
+  template <typename T>
+  T
+  PluginLibraryLoader::getSymbolByLibspec(std::string const& libspec,
+                                          std::string const& sym_name) const
+  {
+    T sym{nullptr};
+    getSymbolByLibspec(libspec, sym_name, sym);
+    return sym;
+  }
+
+} // namespace art
+
+#endif /* art_Utilities_PluginLibraryLoader_h */
+
+// Local Variables:
+// mode: c++
+// End:
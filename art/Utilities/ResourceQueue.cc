@@ -0,0 +1,148 @@
+#include "art/Utilities/ResourceQueue.h"
+// vim: set sw=2 expandtab :
+
+#include <algorithm>
+#include <cassert>
+
+using namespace std;
+
+namespace {
+  unsigned
+  rank_of(art::detail::TaskPriority const priority)
+  {
+    return priority == art::detail::TaskPriority::high ? 0 : 1;
+  }
+
+  bool
+  overlap(vector<unsigned> const& a, vector<unsigned> const& b)
+  {
+    auto ia = a.cbegin();
+    auto ib = b.cbegin();
+    while (ia != a.cend() && ib != b.cend()) {
+      if (*ia == *ib) {
+        return true;
+      }
+      *ia < *ib ? ++ia : ++ib;
+    }
+    return false;
+  }
+}
+
+namespace art::detail {
+
+  ResourceArbiter::ResourceArbiter(tbb::task_group& group,
+                                   unsigned const nResources,
+                                   unsigned const maxBatch)
+    : group_{group}, maxBatch_{max(maxBatch, 1u)}, busy_(nResources)
+  {}
+
+  void
+  ResourceArbiter::push(ResourceQueue const& queue,
+                        TaskPriority const priority,
+                        function<void()> task)
+  {
+    vector<Task> ready;
+    {
+      lock_guard sentry{mutex_};
+      waiting_.emplace(key_t{rank_of(priority), nextTask_++},
+                       Task{&queue, move(task)});
+      ready = acquireReady_();
+    }
+    launch_(move(ready));
+  }
+
+  // Must be called with the mutex held.
+  vector<ResourceArbiter::Task>
+  ResourceArbiter::acquireReady_()
+  {
+    vector<Task> result;
+    // The resources either held or reserved by an earlier waiting task.
+    auto claimed = busy_;
+    for (auto it = waiting_.begin(); it != waiting_.end();) {
+      auto const& resources = it->second.queue->resources();
+      bool const available =
+        none_of(resources.cbegin(), resources.cend(), [&claimed](auto r) {
+          return claimed[r];
+        });
+      for (auto const r : resources) {
+        claimed[r] = true;
+      }
+      if (!available) {
+        ++it;
+        continue;
+      }
+      for (auto const r : resources) {
+        busy_[r] = true;
+      }
+      result.push_back(move(it->second));
+      it = waiting_.erase(it);
+    }
+    return result;
+  }
+
+  // Must be called with the mutex held.
+  ResourceArbiter::tasks_t::iterator
+  ResourceArbiter::nextInBatch_(ResourceQueue const& queue)
+  {
+    auto const next =
+      find_if(waiting_.begin(), waiting_.end(), [&queue](auto const& pr) {
+        return pr.second.queue == &queue;
+      });
+    if (next == waiting_.end()) {
+      return next;
+    }
+    auto const& resources = queue.resources();
+    auto const preempted =
+      any_of(waiting_.begin(), next, [&next, &resources](auto const& pr) {
+        return pr.first.first < next->first.first &&
+               overlap(pr.second.queue->resources(), resources);
+      });
+    return preempted ? waiting_.end() : next;
+  }
+
+  void
+  ResourceArbiter::launch_(vector<Task> tasks)
+  {
+    for (auto& task : tasks) {
+      group_.run([this, task = move(task)] { run_(task); });
+    }
+  }
+
+  void
+  ResourceArbiter::run_(Task task)
+  {
+    auto const& queue = *task.queue;
+    for (unsigned n = 1;; ++n) {
+      task.func();
+      vector<Task> ready;
+      {
+        lock_guard sentry{mutex_};
+        if (n < maxBatch_) {
+          if (auto it = nextInBatch_(queue); it != waiting_.end()) {
+            task = move(it->second);
+            waiting_.erase(it);
+            continue;
+          }
+        }
+        for (auto const r : queue.resources()) {
+          assert(busy_[r]);
+          busy_[r] = false;
+        }
+        ready = acquireReady_();
+      }
+      launch_(move(ready));
+      return;
+    }
+  }
+
+  ResourceQueue::ResourceQueue(shared_ptr<ResourceArbiter> arbiter,
+                               vector<unsigned> resources)
+    : arbiter_{move(arbiter)}, resources_{move(resources)}
+  {
+    sort(resources_.begin(), resources_.end());
+    resources_.erase(unique(resources_.begin(), resources_.end()),
+                     resources_.end());
+    assert(!resources_.empty());
+  }
+
+} // namespace art::detail
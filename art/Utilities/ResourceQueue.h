@@ -0,0 +1,115 @@
+#ifndef art_Utilities_ResourceQueue_h
+#define art_Utilities_ResourceQueue_h
+// vim: set sw=2 expandtab :
+
+// ======================================================================
+// ResourceArbiter and ResourceQueue: serialize the event tasks of
+// shared and legacy modules with respect to the shared resources they
+// use.
+//
+// Each serialized module owns a ResourceQueue naming the resources it
+// needs.  A task pushed onto the queue runs once all of those
+// resources are free, and holds them until it returns.  Unlike a
+// chain of FIFO serial queues, the arbiter
+//
+//  - starts the waiting task of highest priority first, in order of
+//    submission among equal priorities.  Tasks whose events have
+//    otherwise finished processing are given the higher priority, so
+//    that their events stop occupying a schedule sooner.
+//
+//  - lets a module run up to 'maxBatch' of its own waiting tasks
+//    back-to-back while holding its resources, which amortizes the
+//    cost of acquiring them and of warming up the serialized code.
+//    A batch ends early when a task of higher priority is waiting for
+//    any of the held resources.
+//
+// A waiting task reserves the resources it needs: no task of lower
+// priority, or submitted later, may acquire any of them before it,
+// so that tasks needing many resources (e.g. those of legacy modules)
+// are not starved.  Batching is the one exception to this order.
+// A module that already holds its resources may run its own later
+// tasks ahead of tasks of equal priority that other modules submitted
+// earlier and that wait for any of those resources.  Those tasks are
+// therefore delayed by at most 'maxBatch - 1' tasks of that module.
+// Tasks must not throw.
+// ======================================================================
+
+#include "tbb/task_group.h"
+
+#include <cstdint>
+#include <functional>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <utility>
+#include <vector>
+
+namespace art::detail {
+
+  enum class TaskPriority { normal, high };
+
+  class ResourceQueue;
+
+  class ResourceArbiter {
+  public:
+    ResourceArbiter(tbb::task_group& group,
+                    unsigned nResources,
+                    unsigned maxBatch);
+
+    void push(ResourceQueue const& queue,
+              TaskPriority priority,
+              std::function<void()> task);
+
+  private:
+    struct Task {
+      ResourceQueue const* queue;
+      std::function<void()> func;
+    };
+    // Ordered by decreasing priority, then by submission.
+    using key_t = std::pair<unsigned, std::uint64_t>;
+    using tasks_t = std::map<key_t, Task>;
+
+    std::vector<Task> acquireReady_();
+    tasks_t::iterator nextInBatch_(ResourceQueue const& queue);
+    void launch_(std::vector<Task> tasks);
+    void run_(Task task);
+
+    tbb::task_group& group_;
+    unsigned const maxBatch_;
+    std::mutex mutex_{};
+    std::vector<bool> busy_;
+    std::uint64_t nextTask_{};
+    tasks_t waiting_{};
+  };
+
+  class ResourceQueue {
+  public:
+    ResourceQueue(std::shared_ptr<ResourceArbiter> arbiter,
+                  std::vector<unsigned> resources);
+
+    template <typename F>
+    void
+    push(TaskPriority const priority, F&& f)
+    {
+      arbiter_->push(*this, priority, std::forward<F>(f));
+    }
+
+    // The indices of the resources, in increasing order.
+    std::vector<unsigned> const&
+    resources() const noexcept
+    {
+      return resources_;
+    }
+
+  private:
+    std::shared_ptr<ResourceArbiter> arbiter_;
+    std::vector<unsigned> resources_;
+  };
+
+} // namespace art::detail
+
+#endif /* art_Utilities_ResourceQueue_h */
+
+// Local Variables:
+// mode: c++
+// End:
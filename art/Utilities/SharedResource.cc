@@ -2,17 +2,17 @@
 #include "canvas/Utilities/Exception.h"
 #include "cetlib/container_algorithms.h"
 #include "cetlib_except/demangle.h"
-#include "hep_concurrency/SerialTaskQueue.h"
 #include "range/v3/view.hpp"
 
 #include <algorithm>
 #include <cassert>
+#include <iterator>
 #include <memory>
+#include <numeric>
 #include <string>
 #include <utility>
 #include <vector>
 
-using namespace hep::concurrency;
 using namespace std::string_literals;
 
 namespace {
@@ -39,7 +39,7 @@ namespace art::detail {
     // Propulate queues for known shared resources.  Creating these
     // slots does *not* automatically introduce synchronization.
     // Synchronization is enabled based on the resource-names argument
-    // presented to the 'createQueues' member function.
+    // presented to the 'createQueue' member function.
     registerSharedResource(LegacyResource);
   }
 
@@ -71,63 +71,47 @@ namespace art::detail {
   {
     ensure_not_frozen(name);
     ++resourceCounts_[name];
-    if (name == LegacyResource.name) {
-      ++nLegacy_;
-    }
   }
 
   void
-  SharedResources::freeze(tbb::task_group& group)
+  SharedResources::freeze(tbb::task_group& group, unsigned const maxBatch)
   {
     frozen_ = true;
 
-    std::vector<std::pair<unsigned, std::string>> resources_sorted_by_count;
-    for (auto const& [name, count] : resourceCounts_) {
-      // Make sure all non-legacy resources have a higher count, which
-      // makes legacy always the first queue.
-      auto const offset = (name == LegacyResource.name) ? 0u : nLegacy_;
-      resources_sorted_by_count.emplace_back(count + offset, name);
-    }
-    cet::sort_all(resources_sorted_by_count, [](auto const& a, auto const& b) {
-      return a.first < b.first;
-    });
-
+    // Each resource is identified by its index.  As the arbiter
+    // acquires all of a module's resources at once, their order is
+    // immaterial.
     using namespace ::ranges;
-    sortedResources_ =
-      resources_sorted_by_count | views::values |
-      views::transform([&group](auto const& key) {
-        return std::pair{key, std::make_shared<SerialTaskQueue>(group)};
-      }) |
-      to<std::vector>();
-
-    // Not needed any more now that we have a sorted list of resources.
+    resourceNames_ = resourceCounts_ | views::keys | to<std::vector>();
+    arbiter_ = std::make_shared<ResourceArbiter>(
+      group, resourceNames_.size(), maxBatch);
+
+    // Not needed any more now that we have a list of resources.
     resourceCounts_.clear();
   }
 
-  std::vector<std::shared_ptr<SerialTaskQueue>>
-  SharedResources::createQueues(
+  std::unique_ptr<ResourceQueue>
+  SharedResources::createQueue(
     std::vector<std::string> const& resourceNames) const
   {
-    using namespace ::ranges;
+    std::vector<unsigned> indices;
     if (cet::search_all(resourceNames, LegacyResource.name)) {
       // We do not trust legacy modules as they may be accessing one
       // of the shared resources without our knowledge.  We therefore
       // isolate them from all other shared modules (and each other).
-      return sortedResources_ | views::values | to<std::vector>();
+      indices.resize(resourceNames_.size());
+      std::iota(begin(indices), end(indices), 0u);
+      return std::make_unique<ResourceQueue>(arbiter_, std::move(indices));
     }
-    std::vector<std::shared_ptr<SerialTaskQueue>> result;
-    // Not for a legacy module, get the queues for the named resources.
+    // Not for a legacy module, get the indices of the named resources.
     for (auto const& name : resourceNames) {
-      auto it =
-        std::find_if(begin(sortedResources_),
-                     end(sortedResources_),
-                     [&name](auto const& pr) { return pr.first == name; });
-      assert(it != sortedResources_.end());
-      result.push_back(it->second);
+      auto it = std::find(begin(resourceNames_), end(resourceNames_), name);
+      assert(it != resourceNames_.end());
+      indices.push_back(std::distance(begin(resourceNames_), it));
     }
 
-    assert(not empty(result));
-    return result;
+    assert(not empty(indices));
+    return std::make_unique<ResourceQueue>(arbiter_, std::move(indices));
   }
 
 } // namespace art
@@ -1,9 +1,10 @@
 #ifndef art_Utilities_SharedResource_h
 #define art_Utilities_SharedResource_h
 
-#include "hep_concurrency/SerialTaskQueue.h"
+#include "art/Utilities/ResourceQueue.h"
 
 #include <map>
+#include <memory>
 #include <set>
 #include <string>
 #include <typeinfo>
@@ -34,10 +35,11 @@ namespace art::detail {
 
     void registerSharedResources(std::set<std::string> const& names);
     void registerSharedResource(detail::SharedResource_t const&);
-    void freeze(tbb::task_group& group);
+    // Up to 'maxBatch' queued tasks of a module may be run while it
+    // holds its resources.
+    void freeze(tbb::task_group& group, unsigned maxBatch = 1);
 
-    using queue_ptr_t = std::shared_ptr<hep::concurrency::SerialTaskQueue>;
-    std::vector<queue_ptr_t> createQueues(
+    std::unique_ptr<ResourceQueue> createQueue(
       std::vector<std::string> const& resourceNames) const;
 
   private:
@@ -45,9 +47,9 @@ namespace art::detail {
     void ensure_not_frozen(std::string const& name);
 
     std::map<std::string, unsigned> resourceCounts_;
-    std::vector<std::pair<std::string, queue_ptr_t>> sortedResources_;
+    std::vector<std::string> resourceNames_;
+    std::shared_ptr<ResourceArbiter> arbiter_;
     bool frozen_{false};
-    unsigned nLegacy_{};
   };
 }
 
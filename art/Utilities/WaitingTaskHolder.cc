@@ -0,0 +1,48 @@
+#include "art/Utilities/WaitingTaskHolder.h"
+// vim: set sw=2 expandtab :
+
+#include "art/Utilities/GlobalTaskGroup.h"
+
+#include <utility>
+
+using namespace hep::concurrency;
+
+namespace art {
+
+  WaitingTaskHolder::WaitingTaskHolder(tbb::task_group& group,
+                                       WaitingTaskPtr task)
+    : group_{&group}, task_{std::move(task)}
+  {}
+
+  WaitingTaskHolder::~WaitingTaskHolder()
+  {
+    doneWaiting();
+  }
+
+  WaitingTaskHolder::WaitingTaskHolder(WaitingTaskHolder&& other) noexcept
+    : group_{other.group_}, task_{std::move(other.task_)}
+  {}
+
+  WaitingTaskHolder&
+  WaitingTaskHolder::operator=(WaitingTaskHolder&& other) noexcept
+  {
+    if (this != &other) {
+      doneWaiting();
+      group_ = other.group_;
+      task_ = std::move(other.task_);
+    }
+    return *this;
+  }
+
+  void
+  WaitingTaskHolder::doneWaiting(std::exception_ptr ex_ptr)
+  {
+    // Only the first call has an effect.
+    auto task = std::move(task_);
+    if (!task) {
+      return;
+    }
+    detail::may_run(*group_, std::move(task), ex_ptr);
+  }
+
+} // namespace art
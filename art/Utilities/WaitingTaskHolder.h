@@ -0,0 +1,54 @@
+#ifndef art_Utilities_WaitingTaskHolder_h
+#define art_Utilities_WaitingTaskHolder_h
+// vim: set sw=2 expandtab :
+
+// ======================================================================
+// WaitingTaskHolder: a move-only handle to a waiting task that is
+// launched once the holder signals that it is done waiting.
+//
+// The holder is handed to a module's 'acquire' function, which may
+// start work external to the TBB arena (e.g. a request to an inference
+// server or a database) and return immediately.  Whoever completes
+// the external work must call doneWaiting(), passing along an
+// exception if the work failed.  If the holder is destroyed before
+// doneWaiting() has been called, it is treated as a successful
+// completion.
+//
+// The task is spawned onto the framework's task group; doneWaiting()
+// may therefore be called from any thread, including threads that
+// are not managed by TBB.
+// ======================================================================
+
+#include "hep_concurrency/WaitingTask.h"
+
+#include <exception>
+
+#include <tbb/task_group.h> // Can't forward-declare this class.
+
+namespace art {
+
+  class WaitingTaskHolder {
+  public:
+    WaitingTaskHolder(tbb::task_group& group,
+                      hep::concurrency::WaitingTaskPtr task);
+    ~WaitingTaskHolder();
+
+    WaitingTaskHolder(WaitingTaskHolder const&) = delete;
+    WaitingTaskHolder& operator=(WaitingTaskHolder const&) = delete;
+    WaitingTaskHolder(WaitingTaskHolder&&) noexcept;
+    WaitingTaskHolder& operator=(WaitingTaskHolder&&) noexcept;
+
+    void doneWaiting(std::exception_ptr ex_ptr = {});
+
+  private:
+    tbb::task_group* group_;
+    hep::concurrency::WaitingTaskPtr task_;
+  };
+
+} // namespace art
+
+#endif /* art_Utilities_WaitingTaskHolder_h */
+
+// Local Variables:
+// mode: c++
+// End:
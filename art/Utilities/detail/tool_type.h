@@ -1,8 +1,8 @@
 #ifndef art_Utilities_detail_tool_type_h
 #define art_Utilities_detail_tool_type_h
 
+#include "art/Utilities/PluginFactory.h"
 #include "canvas/Utilities/Exception.h"
-#include "cetlib/BasicPluginFactory.h"
 
 #include <functional>
 #include <memory>
@@ -23,7 +23,7 @@ namespace art::detail {
     using return_type = std::unique_ptr<T>;
 
     static auto
-    make_plugin(cet::BasicPluginFactory& factory,
+    make_plugin(PluginFactory& factory,
                 std::string const& libspec,
                 fhicl::ParameterSet const& pset)
     {
@@ -36,7 +36,7 @@ namespace art::detail {
     using return_type = std::function<T>;
 
     static auto
-    make_plugin(cet::BasicPluginFactory& factory,
+    make_plugin(PluginFactory& factory,
                 std::string const& libspec,
                 fhicl::ParameterSet const&,
                 std::string const& function_plugin_type)
@@ -15,6 +15,7 @@ namespace art {
   struct MallocOpts;
   class MallocOptionsSetter; // MallocOpts.h
   class TypeID;
+  class WaitingTaskHolder;
 } // namespace art
 #endif /* art_Utilities_fwd_h */
 
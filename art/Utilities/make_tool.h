@@ -1,10 +1,10 @@
 #ifndef art_Utilities_make_tool_h
 #define art_Utilities_make_tool_h
 
+#include "art/Utilities/PluginFactory.h"
 #include "art/Utilities/PluginSuffixes.h"
 #include "art/Utilities/detail/tool_type.h"
 #include "canvas/Utilities/Exception.h"
-#include "cetlib/BasicPluginFactory.h"
 #include "cetlib/detail/wrapLibraryManagerException.h"
 #include "fhiclcpp/ParameterSet.h"
 
@@ -17,7 +17,7 @@ namespace art {
   std::enable_if_t<std::is_class<T>::value, tool_return_type<T>>
   make_tool(fhicl::ParameterSet const& pset)
   {
-    cet::BasicPluginFactory factory{Suffixes::tool(), "makeTool"};
+    PluginFactory factory{Suffixes::tool(), "makeTool"};
     std::string const libspec{pset.get<std::string>("tool_type")};
     tool_return_type<T> result;
     try {
@@ -35,8 +35,7 @@ namespace art {
   make_tool(fhicl::ParameterSet const& pset,
             std::string const& function_tool_type)
   {
-    cet::BasicPluginFactory factory{
-      Suffixes::tool(), "toolFunction", "toolType"};
+    PluginFactory factory{Suffixes::tool(), "toolFunction", "toolType"};
     std::string const libspec{pset.get<std::string>("tool_type")};
     tool_return_type<T> result;
     try {
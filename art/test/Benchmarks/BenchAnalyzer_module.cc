@@ -0,0 +1,51 @@
+// vim: set sw=2 expandtab :
+
+// ======================================================================
+// An analyzer that only retrieves the products it is configured to
+// read; see BenchProducer_module.cc.
+// ======================================================================
+
+#include "art/Framework/Core/SharedAnalyzer.h"
+#include "art/Framework/Principal/Event.h"
+#include "canvas/Utilities/InputTag.h"
+#include "fhiclcpp/types/Sequence.h"
+
+#include <atomic>
+#include <vector>
+
+namespace arttest {
+  class BenchAnalyzer : public art::SharedAnalyzer {
+  public:
+    struct Config {
+      fhicl::Sequence<art::InputTag> inputs{
+        fhicl::Name{"inputs"},
+        fhicl::Comment{"Labels of the int products to be read."},
+        {}};
+    };
+    using Parameters = Table<Config>;
+    explicit BenchAnalyzer(Parameters const& p, art::ProcessingFrame const&)
+      : SharedAnalyzer{p}
+    {
+      for (auto const& tag : p().inputs()) {
+        tokens_.push_back(consumes<int>(tag));
+      }
+      async<art::InEvent>();
+    }
+
+  private:
+    void
+    analyze(art::Event const& e, art::ProcessingFrame const&) override
+    {
+      int sum{};
+      for (auto const& token : tokens_) {
+        sum += e.getProduct(token);
+      }
+      sum_ += sum;
+    }
+
+    std::vector<art::ProductToken<int>> tokens_;
+    std::atomic<long> sum_{};
+  };
+}
+
+DEFINE_ART_MODULE(arttest::BenchAnalyzer)
@@ -0,0 +1,36 @@
+// vim: set sw=2 expandtab :
+
+// ======================================================================
+// A producer that does (almost) no work, so that a job consisting of
+// such modules measures the framework's per-module overhead: the
+// scheduling of the module, the signals emitted around it, and the
+// insertion of its product.
+// ======================================================================
+
+#include "art/Framework/Core/SharedProducer.h"
+#include "art/Framework/Principal/Event.h"
+
+#include <memory>
+
+namespace arttest {
+  class BenchProducer : public art::SharedProducer {
+  public:
+    struct Config {};
+    using Parameters = Table<Config>;
+    explicit BenchProducer(Parameters const& p, art::ProcessingFrame const&)
+      : SharedProducer{p}
+    {
+      produces<int>();
+      async<art::InEvent>();
+    }
+
+  private:
+    void
+    produce(art::Event& e, art::ProcessingFrame const&) override
+    {
+      e.put(std::make_unique<int>(e.event()));
+    }
+  };
+}
+
+DEFINE_ART_MODULE(arttest::BenchProducer)
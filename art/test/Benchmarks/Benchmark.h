@@ -0,0 +1,164 @@
+#ifndef art_test_Benchmarks_Benchmark_h
+#define art_test_Benchmarks_Benchmark_h
+// vim: set sw=2 expandtab :
+
+// ======================================================================
+// A minimal timing harness for the framework's microbenchmarks.
+//
+// Each benchmark executable registers any number of functions and
+// calls run(argc, argv) from main().  A function is called in batches
+// of increasing size until a batch takes at least the minimum time;
+// the fastest of several such batches is reported, in nanoseconds per
+// call.  Results are printed as a table, or written as JSON with
+//
+//   <benchmark> --json <file>
+//
+// in the format read by run_benchmarks and compare_benchmarks.
+// ======================================================================
+
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <cstring>
+#include <fstream>
+#include <functional>
+#include <iomanip>
+#include <iostream>
+#include <limits>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace arttest::benchmark {
+
+  // Keeps the compiler from optimizing away a computed value.
+  template <typename T>
+  inline void
+  do_not_optimize(T const& value)
+  {
+    asm volatile("" : : "r"(&value) : "memory");
+  }
+
+  class Registry {
+  public:
+    static Registry&
+    instance()
+    {
+      static Registry registry;
+      return registry;
+    }
+
+    void
+    add(std::string name, std::function<void()> f)
+    {
+      benchmarks_.emplace_back(std::move(name), std::move(f));
+    }
+
+    auto const&
+    benchmarks() const
+    {
+      return benchmarks_;
+    }
+
+  private:
+    std::vector<std::pair<std::string, std::function<void()>>> benchmarks_;
+  };
+
+  struct Result {
+    std::string name;
+    std::size_t iterations;
+    double ns_per_op;
+  };
+
+  inline Result
+  measure(std::string const& name, std::function<void()> const& f)
+  {
+    using namespace std::chrono;
+    constexpr auto min_batch_time = milliseconds{100};
+    constexpr int repetitions{5};
+
+    // Warm up, and determine the batch size.
+    std::size_t batch{1};
+    while (true) {
+      auto const begin = steady_clock::now();
+      for (std::size_t i = 0; i != batch; ++i) {
+        f();
+      }
+      if (steady_clock::now() - begin >= min_batch_time) {
+        break;
+      }
+      batch *= 2;
+    }
+
+    auto best = std::numeric_limits<double>::max();
+    for (int r = 0; r != repetitions; ++r) {
+      auto const begin = steady_clock::now();
+      for (std::size_t i = 0; i != batch; ++i) {
+        f();
+      }
+      duration<double, std::nano> const elapsed{steady_clock::now() - begin};
+      best = std::min(best, elapsed.count() / batch);
+    }
+    return {name, batch, best};
+  }
+
+  inline int
+  run(int argc, char** argv)
+  {
+    char const* json_file{nullptr};
+    for (int i = 1; i < argc; ++i) {
+      if (std::strcmp(argv[i], "--json") == 0 && i + 1 < argc) {
+        json_file = argv[++i];
+      } else {
+        std::cerr << "Usage: " << argv[0] << " [--json <file>]\n";
+        return 1;
+      }
+    }
+
+    std::vector<Result> results;
+    for (auto const& [name, f] : Registry::instance().benchmarks()) {
+      results.push_back(measure(name, f));
+      auto const& r = results.back();
+      std::cout << std::left << std::setw(50) << r.name << std::right
+                << std::fixed << std::setprecision(2) << std::setw(14)
+                << r.ns_per_op << " ns/op\n";
+    }
+
+    if (json_file) {
+      std::ofstream os{json_file};
+      os << "{\n  \"benchmarks\": [";
+      auto sep = "\n";
+      for (auto const& r : results) {
+        os << sep << "    {\"name\": \"" << r.name
+           << "\", \"kind\": \"micro\", \"iterations\": " << r.iterations
+           << ", \"ns_per_op\": " << r.ns_per_op << '}';
+        sep = ",\n";
+      }
+      os << "\n  ]\n}\n";
+    }
+    return 0;
+  }
+
+  struct Registration {
+    Registration(std::string name, std::function<void()> f)
+    {
+      Registry::instance().add(std::move(name), std::move(f));
+    }
+  };
+
+} // namespace arttest::benchmark
+
+#define ART_BENCHMARK_CAT2(a, b) a##b
+#define ART_BENCHMARK_CAT(a, b) ART_BENCHMARK_CAT2(a, b)
+#define ART_BENCHMARK(name, ...)                                               \
+  static arttest::benchmark::Registration const ART_BENCHMARK_CAT(             \
+    art_benchmark_, __LINE__)                                                  \
+  {                                                                            \
+    name, __VA_ARGS__                                                          \
+  }
+
+#endif /* art_test_Benchmarks_Benchmark_h */
+
+// Local Variables:
+// mode: c++
+// End:
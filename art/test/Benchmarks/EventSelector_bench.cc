@@ -0,0 +1,84 @@
+// vim: set sw=2 expandtab :
+
+// ======================================================================
+// Cost of evaluating SelectEvents expressions against the trigger
+// results of an event, as done for each analyzer and output module
+// that is configured with SelectEvents.
+// ======================================================================
+
+#include "art/Framework/Core/EventSelector.h"
+#include "art/test/Benchmarks/Benchmark.h"
+#include "canvas/Persistency/Common/HLTGlobalStatus.h"
+#include "canvas/Persistency/Common/HLTPathStatus.h"
+#include "canvas/Persistency/Common/TriggerResults.h"
+#include "fhiclcpp/ParameterSet.h"
+#include "fhiclcpp/ParameterSetRegistry.h"
+
+#include <string>
+#include <vector>
+
+using namespace art;
+using arttest::benchmark::do_not_optimize;
+
+namespace {
+
+  using Strings = std::vector<std::string>;
+  constexpr unsigned npaths{20};
+
+  TriggerResults
+  make_trigger_results()
+  {
+    Strings paths;
+    HLTGlobalStatus status(npaths);
+    for (unsigned i = 0; i != npaths; ++i) {
+      paths.push_back("p" + std::to_string(i));
+      status.at(i) = HLTPathStatus(i % 3 == 0 ? hlt::Fail : hlt::Pass);
+    }
+    fhicl::ParameterSet trigger_pset;
+    trigger_pset.put<Strings>("trigger_paths", paths);
+    fhicl::ParameterSetRegistry::put(trigger_pset);
+    return TriggerResults{status, trigger_pset.id()};
+  }
+
+  // Constructed on first use rather than during static
+  // initialization, which would depend on the registries' order of
+  // initialization.
+  struct Selectors {
+    TriggerResults const results{make_trigger_results()};
+    EventSelector const single{Strings{"p1"}};
+    EventSelector const several{Strings{"p0", "p3", "p6", "p19"}};
+    EventSelector const wildcard{Strings{"p1*"}};
+    EventSelector const negated{Strings{"!p0", "!p3"}};
+  };
+
+  Selectors const&
+  selectors()
+  {
+    static Selectors const s;
+    return s;
+  }
+
+  void
+  accept(EventSelector const& selector)
+  {
+    auto const result =
+      selector.acceptEvent(ScheduleID::first(), selectors().results);
+    do_not_optimize(result);
+  }
+
+  ART_BENCHMARK("EventSelector::acceptEvent (1 path)",
+                [] { accept(selectors().single); });
+  ART_BENCHMARK("EventSelector::acceptEvent (4 paths)",
+                [] { accept(selectors().several); });
+  ART_BENCHMARK("EventSelector::acceptEvent (wildcard)",
+                [] { accept(selectors().wildcard); });
+  ART_BENCHMARK("EventSelector::acceptEvent (negated)",
+                [] { accept(selectors().negated); });
+
+} // unnamed namespace
+
+int
+main(int argc, char** argv)
+{
+  return arttest::benchmark::run(argc, argv);
+}
@@ -0,0 +1,69 @@
+// vim: set sw=2 expandtab :
+
+// ======================================================================
+// Cost of emitting a framework signal, for different numbers of
+// watching slots.  The per-module signals (sPreModule/sPostModule) are
+// emitted twice per module per event.
+// ======================================================================
+
+#include "art/Framework/Services/Registry/GlobalSignal.h"
+#include "art/test/Benchmarks/Benchmark.h"
+
+#include <cstddef>
+#include <string>
+
+using namespace art;
+using arttest::benchmark::do_not_optimize;
+
+namespace {
+
+  using signal_t =
+    GlobalSignal<detail::SignalResponseType::FIFO, void(std::string const&)>;
+
+  std::size_t counter{};
+
+  struct Watcher {
+    void
+    slot(std::string const& s)
+    {
+      counter += s.size();
+    }
+  };
+
+  Watcher watcher;
+
+  signal_t
+  make_signal(unsigned const nslots)
+  {
+    signal_t result;
+    for (unsigned i = 0; i != nslots; ++i) {
+      result.watch(&watcher, &Watcher::slot);
+    }
+    return result;
+  }
+
+  signal_t const no_slots{make_signal(0)};
+  signal_t const one_slot{make_signal(1)};
+  signal_t const four_slots{make_signal(4)};
+  std::string const label{"moduleLabel"};
+
+  ART_BENCHMARK("GlobalSignal::invoke (0 slots)", [] {
+    no_slots.invoke(label);
+    do_not_optimize(counter);
+  });
+  ART_BENCHMARK("GlobalSignal::invoke (1 slot)", [] {
+    one_slot.invoke(label);
+    do_not_optimize(counter);
+  });
+  ART_BENCHMARK("GlobalSignal::invoke (4 slots)", [] {
+    four_slots.invoke(label);
+    do_not_optimize(counter);
+  });
+
+} // unnamed namespace
+
+int
+main(int argc, char** argv)
+{
+  return arttest::benchmark::run(argc, argv);
+}
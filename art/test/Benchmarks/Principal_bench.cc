@@ -0,0 +1,163 @@
+// vim: set sw=2 expandtab :
+
+// ======================================================================
+// Cost of looking up products in an EventPrincipal, which is done for
+// every getBy*/getHandle call made by a module.  The principal holds
+// 'nproducts' products, all put by one process.
+// ======================================================================
+
+#include "art/Framework/Principal/EventPrincipal.h"
+#include "art/Framework/Principal/ProcessTag.h"
+#include "art/Framework/Principal/RunPrincipal.h"
+#include "art/Framework/Principal/SubRunPrincipal.h"
+#include "art/Persistency/Common/GroupQueryResult.h"
+#include "art/Persistency/Provenance/ModuleContext.h"
+#include "art/Version/GetReleaseVersion.h"
+#include "art/test/Benchmarks/Benchmark.h"
+#include "art/test/TestObjects/ToyProducts.h"
+#include "canvas/Persistency/Common/WrappedTypeID.h"
+#include "canvas/Persistency/Common/Wrapper.h"
+#include "canvas/Persistency/Provenance/BranchDescription.h"
+#include "canvas/Persistency/Provenance/EventAuxiliary.h"
+#include "canvas/Persistency/Provenance/Parentage.h"
+#include "canvas/Persistency/Provenance/ProcessConfiguration.h"
+#include "canvas/Persistency/Provenance/ProductProvenance.h"
+#include "canvas/Persistency/Provenance/ProductStatus.h"
+#include "canvas/Persistency/Provenance/ProductTables.h"
+#include "canvas/Persistency/Provenance/RunAuxiliary.h"
+#include "canvas/Persistency/Provenance/SubRunAuxiliary.h"
+#include "canvas/Persistency/Provenance/Timestamp.h"
+#include "canvas/Persistency/Provenance/TypeLabel.h"
+#include "canvas/Utilities/TypeID.h"
+#include "fhiclcpp/ParameterSet.h"
+
+#include <memory>
+#include <string>
+#include <vector>
+
+using namespace art;
+using namespace std::string_literals;
+using arttest::benchmark::do_not_optimize;
+
+namespace {
+
+  constexpr unsigned nproducts{100};
+  std::string const process_name{"BENCH"};
+  std::string const module_label{"benchProducer"};
+
+  std::string
+  instance_name(unsigned const i)
+  {
+    return "i" + std::to_string(i);
+  }
+
+  // Making a functional EventPrincipal is not trivial; see also
+  // art/test/Framework/Principal/EventPrincipal_t.cc.
+  struct Fixture {
+    Fixture();
+
+    std::unique_ptr<ProcessConfiguration> process;
+    ProductTables tables{ProductTables::invalid()};
+    std::vector<ProductID> pids;
+    std::unique_ptr<RunPrincipal> run;
+    std::unique_ptr<SubRunPrincipal> subRun;
+    std::unique_ptr<EventPrincipal> event;
+  };
+
+  Fixture::Fixture()
+  {
+    fhicl::ParameterSet modParams;
+    modParams.put("module_type", "DummyProducer"s);
+    modParams.put("module_label", module_label);
+    fhicl::ParameterSet processParams;
+    processParams.put(module_label, modParams);
+    processParams.put("process_name", process_name);
+    process = std::make_unique<ProcessConfiguration>(
+      process_name, processParams.id(), getReleaseVersion());
+
+    TypeID const dummyType{typeid(arttest::DummyProduct)};
+    ProductDescriptions descriptions;
+    for (unsigned i = 0; i != nproducts; ++i) {
+      descriptions.emplace_back(
+        InEvent,
+        TypeLabel{dummyType,
+                  instance_name(i),
+                  SupportsView<arttest::DummyProduct>::value,
+                  false},
+        module_label,
+        modParams.id(),
+        *process);
+      pids.push_back(descriptions.back().productID());
+    }
+    tables = ProductTables{descriptions};
+
+    EventID const eventID{101, 87, 20};
+    constexpr Timestamp now{1234567UL};
+    run = std::make_unique<RunPrincipal>(
+      RunAuxiliary{eventID.run(), now, now}, *process, nullptr);
+    subRun = std::make_unique<SubRunPrincipal>(
+      SubRunAuxiliary{eventID.run(), eventID.subRun(), now, now},
+      *process,
+      nullptr);
+    subRun->setRunPrincipal(run.get());
+    event = std::make_unique<EventPrincipal>(
+      EventAuxiliary{eventID, now, true}, *process, nullptr);
+    event->setSubRunPrincipal(subRun.get());
+    event->createGroupsForProducedProducts(tables);
+    event->enableLookupOfProducedProducts();
+
+    auto const parentage = std::make_shared<Parentage>();
+    for (auto const pid : pids) {
+      auto const pd = tables.get(InEvent).description(pid);
+      event->put(*pd,
+                 std::make_unique<ProductProvenance const>(
+                   pid, productstatus::present(), parentage->parents()),
+                 std::make_unique<Wrapper<arttest::DummyProduct>>(),
+                 std::make_unique<RangeSet>(RangeSet::invalid()));
+    }
+  }
+
+  Fixture const&
+  fixture()
+  {
+    static Fixture const f;
+    return f;
+  }
+
+  auto const invalid_module_context = ModuleContext::invalid();
+  auto const wrapped = WrappedTypeID::make<arttest::DummyProduct>();
+
+  ART_BENCHMARK("Principal::getByProductID", [] {
+    auto const& f = fixture();
+    auto const result = f.event->getByProductID(f.pids[nproducts / 2]);
+    do_not_optimize(result);
+  });
+
+  ART_BENCHMARK("Principal::getByLabel (found)", [] {
+    static auto const instance = instance_name(nproducts / 2);
+    auto const result = fixture().event->getByLabel(
+      invalid_module_context,
+      wrapped,
+      module_label,
+      instance,
+      ProcessTag{process_name, process_name});
+    do_not_optimize(result);
+  });
+
+  ART_BENCHMARK("Principal::getByLabel (not found)", [] {
+    auto const result =
+      fixture().event->getByLabel(invalid_module_context,
+                                  wrapped,
+                                  "absent"s,
+                                  ""s,
+                                  ProcessTag{""s, process_name});
+    do_not_optimize(result);
+  });
+
+} // unnamed namespace
+
+int
+main(int argc, char** argv)
+{
+  return arttest::benchmark::run(argc, argv);
+}
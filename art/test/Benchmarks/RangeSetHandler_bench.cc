@@ -0,0 +1,120 @@
+// vim: set sw=2 expandtab :
+
+// ======================================================================
+// Cost of tracking the event ranges of a subrun over a sequence of
+// output-file switches, as done for every event and at every switch
+// by the framework.  Each benchmark processes one subrun of
+// 'nevents' events, switching output files every 'events_per_file'
+// events (splitting the current range, collecting the seen ranges,
+// and rebasing).
+//
+// The closed-handler benchmarks model an input made of many small
+// ranges, e.g. the merge of many files: every event is processed, or
+// only the first event of every 'stride'-th range (e.g. after
+// filtering on input).
+// ======================================================================
+
+#include "art/Framework/Principal/ClosedRangeSetHandler.h"
+#include "art/Framework/Principal/OpenRangeSetHandler.h"
+#include "art/test/Benchmarks/Benchmark.h"
+#include "canvas/Persistency/Provenance/EventID.h"
+#include "canvas/Persistency/Provenance/EventRange.h"
+#include "canvas/Persistency/Provenance/RangeSet.h"
+
+#include <cstddef>
+#include <vector>
+
+using namespace art;
+using arttest::benchmark::do_not_optimize;
+
+namespace {
+
+  constexpr RunNumber_t run{1};
+  constexpr SubRunNumber_t subrun{0};
+  constexpr unsigned nevents{100'000};
+  constexpr unsigned events_per_range{10};
+  constexpr unsigned events_per_file{10'000};
+
+  std::size_t nseen{};
+
+  void
+  switch_file(RangeSetHandler& handler)
+  {
+    handler.maybeSplitRange();
+    nseen += handler.seenRanges().ranges().size();
+    handler.rebase();
+  }
+
+  void
+  process(RangeSetHandler& handler, std::vector<EventID> const& events)
+  {
+    unsigned n{};
+    for (auto const& id : events) {
+      handler.update(id, false);
+      if (++n % events_per_file == 0) {
+        switch_file(handler);
+      }
+    }
+    handler.flushRanges();
+    nseen += handler.seenRanges().ranges().size();
+    do_not_optimize(nseen);
+  }
+
+  std::vector<EventID>
+  all_events()
+  {
+    std::vector<EventID> result;
+    for (unsigned e = 1; e <= nevents; ++e) {
+      result.emplace_back(run, subrun, e);
+    }
+    return result;
+  }
+
+  // Events 1..nevents in ranges of 'events_per_range' events, with a
+  // one-event gap between ranges.
+  RangeSet
+  input_ranges()
+  {
+    std::vector<EventRange> ranges;
+    for (unsigned b = 1; b <= nevents; b += events_per_range + 1) {
+      ranges.emplace_back(subrun, b, b + events_per_range);
+    }
+    return RangeSet{run, ranges};
+  }
+
+  std::vector<EventID>
+  input_events(unsigned const stride)
+  {
+    std::vector<EventID> result;
+    auto const step = stride * (events_per_range + 1);
+    for (unsigned e = 1; e <= nevents; e += step) {
+      result.emplace_back(run, subrun, e);
+    }
+    return result;
+  }
+
+  std::vector<EventID> const open_events{all_events()};
+  RangeSet const closed_ranges{input_ranges()};
+  std::vector<EventID> const closed_events{input_events(1)};
+  std::vector<EventID> const sparse_events{input_events(100)};
+
+  ART_BENCHMARK("OpenRangeSetHandler (100k events, file switches)", [] {
+    OpenRangeSetHandler handler{run};
+    process(handler, open_events);
+  });
+  ART_BENCHMARK("ClosedRangeSetHandler (9k ranges, file switches)", [] {
+    ClosedRangeSetHandler handler{closed_ranges};
+    process(handler, closed_events);
+  });
+  ART_BENCHMARK("ClosedRangeSetHandler (9k ranges, sparse events)", [] {
+    ClosedRangeSetHandler handler{closed_ranges};
+    process(handler, sparse_events);
+  });
+
+} // unnamed namespace
+
+int
+main(int argc, char** argv)
+{
+  return arttest::benchmark::run(argc, argv);
+}
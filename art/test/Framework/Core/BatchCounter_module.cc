@@ -0,0 +1,49 @@
+#include "boost/test/unit_test.hpp"
+
+#include "art/Framework/Core/BatchAnalyzer.h"
+#include "art/Framework/Principal/Event.h"
+#include "fhiclcpp/types/Atom.h"
+
+#include <atomic>
+
+namespace {
+  class BatchCounter : public art::BatchAnalyzer {
+  public:
+    struct Config {
+      fhicl::Atom<unsigned> expected{
+        fhicl::Name{"expected"},
+        fhicl::Comment{
+          "The number of events expected to be processed, based on the "
+          "'SelectEvents'\n"
+          "and 'RejectEvents' parameters."}};
+    };
+    using Parameters = Table<Config>;
+    explicit BatchCounter(Parameters const& p, art::ProcessingFrame const&)
+      : BatchAnalyzer{p}, expected_{p().expected()}
+    {
+      async<art::InEvent>();
+    }
+
+  private:
+    void
+    analyzeEvents(std::span<art::Event const* const> events,
+                  art::ProcessingFrame const&) override
+    {
+      for (auto const* e : events) {
+        BOOST_TEST(e->event() % 2 == 0);
+      }
+      n_ += events.size();
+    }
+
+    void
+    endJob(art::ProcessingFrame const&) override
+    {
+      BOOST_TEST(n_.load() == expected_);
+    }
+
+    unsigned const expected_;
+    std::atomic<unsigned> n_{};
+  };
+}
+
+DEFINE_ART_MODULE(BatchCounter)
@@ -0,0 +1,104 @@
+#include "boost/test/unit_test.hpp"
+
+#include "art/Framework/Core/BatchFilter.h"
+#include "art/Framework/Principal/Event.h"
+#include "cetlib_except/exception.h"
+#include "fhiclcpp/types/Atom.h"
+#include "fhiclcpp/types/OptionalAtom.h"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <string>
+#include <thread>
+
+namespace {
+  // Passes the events with an even event number.
+  class BatchParity : public art::BatchFilter {
+  public:
+    struct Config {
+      fhicl::Atom<unsigned> expected{
+        fhicl::Name{"expected"},
+        fhicl::Comment{"Number of events expected to be processed."}};
+      fhicl::Atom<unsigned> maxBatchSize{fhicl::Name{"maxBatchSize"}, 0u};
+      fhicl::Atom<unsigned> delay{
+        fhicl::Name{"delay"},
+        fhicl::Comment{"Time (in milliseconds) spent on each batch."},
+        0u};
+      fhicl::Atom<bool> batched{
+        fhicl::Name{"batched"},
+        fhicl::Comment{
+          "Whether at least one batch of more than one event is expected."},
+        false};
+      fhicl::OptionalAtom<std::string> throwCategory{
+        fhicl::Name{"throwCategory"},
+        fhicl::Comment{"If specified, the category of the exception thrown "
+                       "after each batch is processed."}};
+    };
+    using Parameters = Table<Config>;
+    explicit BatchParity(Parameters const& p, art::ProcessingFrame const&)
+      : BatchFilter{p}
+      , expected_{p().expected()}
+      , maxBatchSize_{p().maxBatchSize()}
+      , delay_{p().delay()}
+      , batched_{p().batched()}
+      , throws_{p().throwCategory(throwCategory_)}
+    {
+      async<art::InEvent>();
+      maxBatchSize(maxBatchSize_);
+    }
+
+  private:
+    void
+    filterEvents(std::span<art::Event* const> events,
+                 std::span<bool> results,
+                 art::ProcessingFrame const& frame) override
+    {
+      BOOST_TEST_REQUIRE(events.size() == results.size());
+      BOOST_TEST(!events.empty());
+      if (maxBatchSize_ != 0) {
+        BOOST_TEST(events.size() <= maxBatchSize_);
+      }
+      BOOST_TEST(!frame.scheduleID().isValid());
+      // Batches of a module are never processed concurrently.
+      BOOST_TEST(++inFlight_ == 1);
+      // The events of other schedules reach the module in the meantime,
+      // and make up the next batch.
+      std::this_thread::sleep_for(std::chrono::milliseconds{delay_});
+      std::transform(
+        events.begin(), events.end(), results.begin(), [](auto const* e) {
+          return e->event() % 2 == 0;
+        });
+      n_ += events.size();
+      if (events.size() > largest_) {
+        largest_ = events.size();
+      }
+      --inFlight_;
+      if (throws_) {
+        throw cet::exception{throwCategory_}
+          << "Batch of " << events.size() << " events.\n";
+      }
+    }
+
+    void
+    endJob(art::ProcessingFrame const&) override
+    {
+      BOOST_TEST(n_.load() == expected_);
+      if (batched_) {
+        BOOST_TEST(largest_.load() > 1u);
+      }
+    }
+
+    unsigned const expected_;
+    unsigned const maxBatchSize_;
+    unsigned const delay_;
+    bool const batched_;
+    std::string throwCategory_{};
+    bool const throws_;
+    std::atomic<unsigned> inFlight_{};
+    std::atomic<unsigned> n_{};
+    std::atomic<std::size_t> largest_{};
+  };
+}
+
+DEFINE_ART_MODULE(BatchParity)
@@ -50,6 +50,12 @@ namespace {
     BOOST_TEST(size(results) == 2ull);
     BOOST_TEST(results.at("a").accept() == expectedA_);
     BOOST_TEST(results.at("b").accept() == expectedB_);
+
+    auto const& tr = e.getProduct(token_);
+    BOOST_TEST(triggerNames_->pathNames(tr) == orderedPaths_);
+    auto const index_a = triggerNames_->pathIndex(tr, "a");
+    BOOST_TEST(tr.at(index_a).accept() == expectedA_);
+    BOOST_TEST(triggerNames_->pathResult(tr, "b").accept() == expectedB_);
   }
 }
 
@@ -0,0 +1,126 @@
+#include "boost/test/unit_test.hpp"
+
+#include "art/Framework/Core/SharedProducer.h"
+#include "art/Framework/Principal/Event.h"
+#include "art/Utilities/WaitingTaskHolder.h"
+#include "fhiclcpp/types/Atom.h"
+
+#include <atomic>
+#include <chrono>
+#include <map>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace {
+  class ExternalWork : public art::SharedProducer {
+  public:
+    struct Config {
+      fhicl::Atom<unsigned> expected{
+        fhicl::Name{"expected"},
+        fhicl::Comment{"Number of events expected to be processed."}};
+      fhicl::Atom<unsigned> latency{
+        fhicl::Name{"latency"},
+        fhicl::Comment{"Duration (in milliseconds) of the simulated external "
+                       "work."}};
+      fhicl::Atom<unsigned> latencySpread{
+        fhicl::Name{"latencySpread"},
+        fhicl::Comment{
+          "If non-zero, the latency of event n is multiplied by\n"
+          "latencySpread - n % latencySpread, so that consecutive events\n"
+          "finish out of order."},
+        0};
+      fhicl::Atom<bool> serialized{
+        fhicl::Name{"serialized"},
+        fhicl::Comment{"If true, the module is serialized wrt. itself."},
+        false};
+    };
+    using Parameters = Table<Config>;
+    explicit ExternalWork(Parameters const& p, art::ProcessingFrame const&)
+      : SharedProducer{p}
+      , expected_{p().expected()}
+      , latency_{std::chrono::milliseconds{p().latency()}}
+      , latencySpread_{p().latencySpread()}
+    {
+      if (p().serialized()) {
+        serialize();
+      } else {
+        async<art::InEvent>();
+      }
+      externalWork<art::InEvent>();
+    }
+
+    ~ExternalWork() { joinWorkers(); }
+
+  private:
+    void
+    acquire(art::Event const& e,
+            art::ProcessingFrame const&,
+            art::WaitingTaskHolder holder) override
+    {
+      ++acquired_;
+      auto latency = latency_;
+      if (latencySpread_ != 0) {
+        latency *= latencySpread_ - e.event() % latencySpread_;
+      }
+      // Simulate a request to an external server that completes on a
+      // thread not managed by TBB.
+      auto const id = e.id();
+      auto work = [this, latency, id, h = std::move(holder)]() mutable {
+        std::this_thread::sleep_for(latency);
+        {
+          std::lock_guard lock{m_};
+          results_[id] = id.event();
+        }
+        h.doneWaiting();
+      };
+      std::lock_guard lock{m_};
+      workers_.emplace_back(std::move(work));
+    }
+
+    void
+    joinWorkers()
+    {
+      std::vector<std::thread> workers;
+      {
+        std::lock_guard lock{m_};
+        workers.swap(workers_);
+      }
+      for (auto& worker : workers) {
+        worker.join();
+      }
+    }
+
+    void
+    produce(art::Event& e, art::ProcessingFrame const&) override
+    {
+      // The external work must be finished before produce is called.
+      std::lock_guard lock{m_};
+      auto const it = results_.find(e.id());
+      BOOST_TEST_REQUIRE((it != results_.cend()));
+      BOOST_TEST(it->second == e.event());
+      results_.erase(it);
+      ++produced_;
+    }
+
+    void
+    endJob(art::ProcessingFrame const&) override
+    {
+      joinWorkers();
+      BOOST_TEST(acquired_.load() == expected_);
+      BOOST_TEST(produced_.load() == expected_);
+      BOOST_TEST(results_.empty());
+    }
+
+    unsigned const expected_;
+    std::chrono::milliseconds const latency_;
+    unsigned const latencySpread_;
+    std::atomic<unsigned> acquired_{};
+    std::atomic<unsigned> produced_{};
+    std::mutex m_{};
+    std::map<art::EventID, art::EventNumber_t> results_{};
+    std::vector<std::thread> workers_{};
+  };
+}
+
+DEFINE_ART_MODULE(ExternalWork)
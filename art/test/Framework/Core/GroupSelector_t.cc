@@ -60,16 +60,20 @@ namespace {
       params.get<std::vector<std::string>>(parameterName, {"keep *"}),
       parameterName,
       testname);
-    std::vector<bool> results;
-
-    for (std::size_t i{}; i < art::NumBranchTypes; ++i) {
-      auto const bt = static_cast<art::BranchType>(i);
-      auto const& descriptions = pTables.descriptions(bt);
-      art::GroupSelector const gs{gsr, descriptions};
-      apply_gs(gs, descriptions, results);
+    // The second pass is served from the cache of rule outcomes.
+    for (int pass{}; pass != 2; ++pass) {
+      std::vector<bool> results;
+
+      for (std::size_t i{}; i < art::NumBranchTypes; ++i) {
+        auto const bt = static_cast<art::BranchType>(i);
+        auto const& descriptions = pTables.descriptions(bt);
+        art::GroupSelector const gs{gsr, descriptions};
+        apply_gs(gs, descriptions, results);
+      }
+
+      BOOST_TEST_REQUIRE(expected == results,
+                         boost::test_tools::per_element{});
     }
-
-    BOOST_TEST_REQUIRE(expected == results, boost::test_tools::per_element{});
   }
 
   class GlobalSetup {
@@ -0,0 +1,48 @@
+// vim: set sw=2 expandtab :
+
+// A producer with a validated configuration.  Its value must match the
+// number in its module label (e.g. 'mod03' for 3), so that a job with
+// many such modules checks that each was constructed from its own
+// configuration.
+
+#include "art/Framework/Core/EDProducer.h"
+#include "art/Framework/Principal/fwd.h"
+#include "canvas/Utilities/Exception.h"
+#include "fhiclcpp/types/Atom.h"
+
+#include <string>
+
+namespace art::test {
+  class PMTestConfigured : public EDProducer {
+  public:
+    struct Config {
+      fhicl::Atom<int> value{fhicl::Name{"value"}};
+    };
+    using Parameters = Table<Config>;
+    explicit PMTestConfigured(Parameters const& p)
+      : EDProducer{p}, value_{p().value()}
+    {}
+
+  private:
+    void
+    beginJob() override
+    {
+      auto const& label = moduleDescription().moduleLabel();
+      auto const digits = label.find_first_of("0123456789");
+      if (digits == std::string::npos ||
+          std::stoi(label.substr(digits)) != value_) {
+        throw Exception{errors::LogicError}
+          << "Module " << label << " was configured with value " << value_
+          << ".\n";
+      }
+    }
+
+    void
+    produce(Event&) override
+    {}
+
+    int const value_;
+  };
+}
+
+DEFINE_ART_MODULE(art::test::PMTestConfigured)
@@ -0,0 +1,61 @@
+#include "boost/test/unit_test.hpp"
+
+#include "art/Framework/Core/SharedProducer.h"
+#include "art/Framework/Principal/Event.h"
+#include "art/Framework/Principal/Handle.h"
+#include "art/Framework/Principal/Provenance.h"
+#include "canvas/Utilities/InputTag.h"
+#include "fhiclcpp/types/Atom.h"
+
+#include <memory>
+#include <string>
+
+namespace {
+  // Produces an int, adding to it the int read from the 'input'
+  // product, if any, whose recorded parents are checked.
+  class ParentsProducer : public art::SharedProducer {
+  public:
+    struct Config {
+      fhicl::Atom<std::string> input{
+        fhicl::Name{"input"},
+        fhicl::Comment{"The input tag of the int product to read, if any."},
+        ""};
+      fhicl::Atom<unsigned> expectedParents{
+        fhicl::Name{"expectedParents"},
+        fhicl::Comment{"The number of parents expected to be recorded for the "
+                       "'input' product."},
+        0u};
+    };
+    using Parameters = Table<Config>;
+    explicit ParentsProducer(Parameters const& p, art::ProcessingFrame const&)
+      : SharedProducer{p}
+      , input_{p().input()}
+      , expectedParents_{p().expectedParents()}
+    {
+      if (!input_.empty()) {
+        consumes<int>(input_);
+      }
+      produces<int>();
+      async<art::InEvent>();
+    }
+
+  private:
+    void
+    produce(art::Event& e, art::ProcessingFrame const&) override
+    {
+      int value{1};
+      if (!input_.empty()) {
+        auto const h = e.getHandle<int>(input_);
+        BOOST_TEST_REQUIRE(h.isValid());
+        BOOST_TEST(h.provenance()->parents().size() == expectedParents_);
+        value += *h;
+      }
+      e.put(std::make_unique<int>(value));
+    }
+
+    art::InputTag const input_;
+    unsigned const expectedParents_;
+  };
+}
+
+DEFINE_ART_MODULE(ParentsProducer)
@@ -0,0 +1,91 @@
+#include "boost/test/unit_test.hpp"
+
+#include "art/Framework/Core/OutputModule.h"
+#include "art/Framework/Principal/EventPrincipal.h"
+#include "art/Framework/Principal/fwd.h"
+#include "fhiclcpp/types/Atom.h"
+#include "fhiclcpp/types/ConfigurationTable.h"
+
+#include <atomic>
+#include <chrono>
+#include <set>
+#include <thread>
+
+// Records the events written, and checks at the end of the job that
+// each of them was written exactly once, and that the writes of this
+// module never overlapped each other.  With 'ordered', also checks
+// that the events were written in increasing order.  With
+// 'expectOverlap', also checks that a write of this module overlapped
+// that of another WriteRecorder at least once.
+
+namespace {
+  // Shared by all WriteRecorder modules of the job.
+  std::atomic<unsigned> writesInFlight{};
+  std::atomic<bool> writesOverlapped{false};
+
+  class WriteRecorder : public art::OutputModule {
+  public:
+    struct Config {
+      fhicl::TableFragment<art::OutputModule::Config> omConfig;
+      fhicl::Atom<unsigned> expected{fhicl::Name{"expected"}};
+      fhicl::Atom<unsigned> writeDelayMS{fhicl::Name{"writeDelayMS"}, 0};
+      fhicl::Atom<bool> ordered{fhicl::Name{"ordered"}, false};
+      fhicl::Atom<bool> expectOverlap{fhicl::Name{"expectOverlap"}, false};
+    };
+    using Parameters =
+      fhicl::WrappedTable<Config, art::OutputModule::Config::KeysToIgnore>;
+    explicit WriteRecorder(Parameters const& p)
+      : OutputModule{p().omConfig}
+      , expected_{p().expected()}
+      , writeDelay_{p().writeDelayMS()}
+      , ordered_{p().ordered()}
+      , expectOverlap_{p().expectOverlap()}
+    {}
+
+  private:
+    void
+    write(art::EventPrincipal& ep) override
+    {
+      BOOST_TEST(writing_.fetch_add(1) == 0);
+      if (writesInFlight.fetch_add(1) != 0) {
+        writesOverlapped = true;
+      }
+      std::this_thread::sleep_for(writeDelay_);
+      auto const& id = ep.eventID();
+      if (ordered_ && !ids_.empty()) {
+        BOOST_TEST(*ids_.rbegin() < id,
+                   "event " << id << " written after " << *ids_.rbegin());
+      }
+      BOOST_TEST(ids_.insert(id).second,
+                 "event " << id << " written more than once");
+      --writesInFlight;
+      --writing_;
+    }
+
+    void
+    writeRun(art::RunPrincipal&) override
+    {}
+
+    void
+    writeSubRun(art::SubRunPrincipal&) override
+    {}
+
+    void
+    endJob() override
+    {
+      BOOST_TEST(ids_.size() == expected_);
+      if (expectOverlap_) {
+        BOOST_TEST(writesOverlapped.load());
+      }
+    }
+
+    unsigned const expected_;
+    std::chrono::milliseconds const writeDelay_;
+    bool const ordered_;
+    bool const expectOverlap_;
+    std::atomic<unsigned> writing_{};
+    std::set<art::EventID> ids_{};
+  };
+}
+
+DEFINE_ART_MODULE(WriteRecorder)
@@ -0,0 +1,103 @@
+#define BOOST_TEST_MODULE (EventReorderBuffer_t)
+#include "boost/test/unit_test.hpp"
+
+#include "art/Framework/EventProcessor/EventReorderBuffer.h"
+
+using art::EventReorderBuffer;
+using art::ScheduleID;
+
+BOOST_AUTO_TEST_SUITE(EventReorderBuffer_t)
+
+BOOST_AUTO_TEST_CASE(in_order)
+{
+  EventReorderBuffer buffer{0};
+  buffer.reset();
+  for (unsigned i = 0; i != 3; ++i) {
+    BOOST_TEST(buffer.mayRead(ScheduleID(0)));
+    auto const ticket = buffer.issue();
+    BOOST_TEST(ticket == i);
+    BOOST_TEST(buffer.mayFinish(ticket, ScheduleID(0), true));
+    auto const released = buffer.release(ticket);
+    BOOST_TEST(!released.next);
+    BOOST_TEST(released.readers.empty());
+  }
+}
+
+BOOST_AUTO_TEST_CASE(out_of_order)
+{
+  EventReorderBuffer buffer{0};
+  auto const t0 = buffer.issue();
+  auto const t1 = buffer.issue();
+  auto const t2 = buffer.issue();
+  BOOST_TEST(!buffer.mayFinish(t2, ScheduleID(2), true));
+  BOOST_TEST(!buffer.mayFinish(t1, ScheduleID(1), false));
+  BOOST_TEST(buffer.mayFinish(t0, ScheduleID(0), true));
+
+  auto released = buffer.release(t0);
+  BOOST_REQUIRE(released.next);
+  BOOST_TEST(released.next->sid == ScheduleID(1));
+  BOOST_TEST(released.next->ticket == t1);
+  BOOST_TEST(!released.next->write);
+
+  released = buffer.release(t1);
+  BOOST_REQUIRE(released.next);
+  BOOST_TEST(released.next->sid == ScheduleID(2));
+  BOOST_TEST(released.next->write);
+
+  released = buffer.release(t2);
+  BOOST_TEST(!released.next);
+  buffer.reset();
+}
+
+BOOST_AUTO_TEST_CASE(window)
+{
+  EventReorderBuffer buffer{2};
+  BOOST_TEST(buffer.mayRead(ScheduleID(0)));
+  auto const t0 = buffer.issue();
+  BOOST_TEST(buffer.mayRead(ScheduleID(1)));
+  auto const t1 = buffer.issue();
+  BOOST_TEST(!buffer.mayRead(ScheduleID(2)));
+  BOOST_TEST(!buffer.mayRead(ScheduleID(3)));
+
+  BOOST_TEST(!buffer.mayFinish(t1, ScheduleID(1), true));
+  BOOST_TEST(buffer.mayFinish(t0, ScheduleID(0), true));
+  auto released = buffer.release(t0);
+  BOOST_REQUIRE(released.next);
+  BOOST_TEST(released.readers.size() == 1u);
+
+  released = buffer.release(t1);
+  BOOST_TEST(!released.next);
+  BOOST_TEST(released.readers.size() == 1u);
+  buffer.reset();
+}
+
+// Schedules that ask to read before either has been issued a ticket
+// must not exceed the window together.
+BOOST_AUTO_TEST_CASE(reserved_slots)
+{
+  EventReorderBuffer buffer{2};
+  BOOST_TEST(buffer.mayRead(ScheduleID(0)));
+  BOOST_TEST(buffer.mayRead(ScheduleID(1)));
+  BOOST_TEST(!buffer.mayRead(ScheduleID(2)));
+
+  // Schedule 0 finds no event to read: its slot goes to schedule 2.
+  auto const readers = buffer.cancelRead();
+  BOOST_TEST_REQUIRE(readers.size() == 1u);
+  BOOST_TEST(readers[0] == ScheduleID(2));
+  BOOST_TEST(buffer.mayRead(ScheduleID(2)));
+  BOOST_TEST(!buffer.mayRead(ScheduleID(0)));
+
+  auto const t1 = buffer.issue();
+  auto const t2 = buffer.issue();
+  BOOST_TEST(buffer.mayFinish(t1, ScheduleID(1), true));
+  auto released = buffer.release(t1);
+  BOOST_TEST(released.readers.size() == 1u);
+  BOOST_TEST(buffer.mayRead(ScheduleID(0)));
+  BOOST_TEST(buffer.cancelRead().empty());
+  BOOST_TEST(buffer.mayFinish(t2, ScheduleID(2), true));
+  released = buffer.release(t2);
+  BOOST_TEST(released.readers.empty());
+  buffer.reset();
+}
+
+BOOST_AUTO_TEST_SUITE_END()
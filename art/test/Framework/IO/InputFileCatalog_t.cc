@@ -0,0 +1,152 @@
+#define BOOST_TEST_MODULE (InputFileCatalog_t)
+#include "boost/test/unit_test.hpp"
+
+#include "art/Framework/IO/Catalog/InputFileCatalog.h"
+#include "art/Framework/Services/Registry/ActivityRegistry.h"
+#include "art/Framework/Services/Registry/ServiceHandle.h"
+#include "art/Framework/Services/Registry/ServicesManager.h"
+#include "art/Utilities/SharedResource.h"
+#include "art/test/Framework/IO/RecordingFileDelivery.h"
+#include "fhiclcpp/ParameterSet.h"
+#include "fhiclcpp/types/Table.h"
+#include "fhiclcpp/types/TableFragment.h"
+
+#include <algorithm>
+#include <filesystem>
+#include <fstream>
+#include <string>
+#include <vector>
+
+namespace fs = std::filesystem;
+using namespace std::string_literals;
+
+namespace {
+  struct Config {
+    fhicl::TableFragment<art::InputFileCatalog::Config> catalog;
+  };
+
+  auto
+  position_of(std::vector<std::string> const& records,
+              std::string const& entry)
+  {
+    auto const it = std::find(cbegin(records), cend(records), entry);
+    BOOST_TEST_REQUIRE((it != cend(records)), "missing '" << entry << "'");
+    return it - cbegin(records);
+  }
+
+  struct StagingFixture {
+    StagingFixture()
+    {
+      fs::create_directories(inputDir);
+      for (auto const& name : {"a.root", "b.root", "c.root"}) {
+        std::ofstream{inputDir / name} << name;
+      }
+    }
+
+    fs::path const inputDir{fs::absolute("InputFileCatalog_t.d/input")};
+    fs::path const scratchDir{fs::absolute("InputFileCatalog_t.d/scratch")};
+    art::ActivityRegistry areg;
+    art::detail::SharedResources resources;
+  };
+}
+
+BOOST_FIXTURE_TEST_SUITE(InputFileCatalog_t, StagingFixture)
+
+// Four files, of which the second cannot be transferred, are staged
+// with a depth of 2.  The files must be handed out, and delivered, in
+// order; each delivery may only be requested once the file two places
+// before it has been disposed of; the status of each file must be
+// reported exactly as without staging; and the local copy of each file
+// must be removed once the file has been consumed.
+BOOST_AUTO_TEST_CASE(prestaged_delivery_order)
+{
+  std::vector<std::string> uris;
+  for (auto const& name : {"a.root", "missing.root", "b.root", "c.root"}) {
+    uris.push_back("file://" + (inputDir / name).string());
+  }
+
+  auto services = fhicl::ParameterSet::make(
+    "CatalogInterface: { service_type: CatalogInterface "
+    "                    service_provider: RecordingFileDelivery } "
+    "FileTransfer: { service_type: FileTransfer "
+    "                service_provider: LocalCopyFileTransfer "
+    "                scratchDir: \"" +
+    scratchDir.string() +
+    "\" "
+    "                delayMS: 20 }");
+  art::ServicesManager manager{std::move(services), areg, resources};
+
+  fhicl::ParameterSet pset;
+  pset.put("fileNames", uris);
+  pset.put("prestageDepth", 2u);
+  fhicl::Table<Config> const table{pset};
+
+  std::vector<std::string> seen;
+  std::vector<fs::path> copies;
+  {
+    art::InputFileCatalog catalog{table().catalog};
+    // With a single attempt, the file that cannot be transferred is
+    // skipped without a retry.
+    while (catalog.getNextFile(1)) {
+      if (!copies.empty()) {
+        BOOST_TEST(!fs::exists(copies.back()));
+      }
+      auto const& file = catalog.currentFile();
+      if (file.skipped()) {
+        BOOST_TEST(file.fileName().empty());
+        seen.push_back("skipped "s + fs::path{file.uri()}.filename().string());
+        continue;
+      }
+      fs::path const copy{file.fileName()};
+      BOOST_TEST(copy.parent_path() == scratchDir);
+      BOOST_TEST(fs::is_regular_file(copy));
+      copies.push_back(copy);
+      seen.push_back(fs::path{file.uri()}.filename().string());
+    }
+    // The catalog is not searchable, so the last copy was released
+    // when the end of the catalog was reached.
+    BOOST_TEST(!fs::exists(copies.back()));
+  }
+  std::vector<std::string> const expected_seen{
+    "a.root", "skipped missing.root", "b.root", "c.root"};
+  BOOST_TEST(seen == expected_seen, boost::test_tools::per_element{});
+
+  auto const records =
+    art::ServiceHandle<art::test::RecordingFileDelivery>{}->records();
+  std::vector<std::string> deliveries;
+  std::copy_if(cbegin(records),
+               cend(records),
+               back_inserter(deliveries),
+               [](auto const& r) { return r.starts_with("delivered "); });
+  std::vector<std::string> expected_deliveries;
+  for (auto const& uri : uris) {
+    expected_deliveries.push_back("delivered " + uri);
+  }
+  BOOST_TEST(deliveries == expected_deliveries,
+             boost::test_tools::per_element{});
+
+  // Dispositions: the skipped file is never transferred nor consumed.
+  std::vector<std::string> const done{"CONSUMED " + uris[0],
+                                      "SKIPPED " + uris[1],
+                                      "CONSUMED " + uris[2],
+                                      "CONSUMED " + uris[3]};
+  for (auto const& entry : done) {
+    BOOST_TEST(std::count(cbegin(records), cend(records), entry) == 1);
+  }
+  for (auto const i : {0, 2, 3}) {
+    BOOST_TEST(position_of(records, "TRANSFERED " + uris[i]) <
+               position_of(records, done[i]));
+  }
+  for (auto const& status : {"TRANSFERED "s, "CONSUMED "s}) {
+    BOOST_TEST(std::count(cbegin(records), cend(records), status + uris[1]) ==
+               0);
+  }
+
+  // At most two files are delivered but not yet disposed of.
+  for (std::size_t i = 2; i != uris.size(); ++i) {
+    BOOST_TEST(position_of(records, done[i - 2]) <
+               position_of(records, expected_deliveries[i]));
+  }
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -58,11 +58,13 @@ BOOST_AUTO_TEST_CASE(testSubstitutions)
   std::vector<std::string> const patterns{"f/stem_%r_%s_%R_%S.root"s,
                                           "f/stem_%l.root"s,
                                           "f/stem_%p.root"s,
-                                          "f/stem_%5R_%2S.root"s};
+                                          "f/stem_%5R_%2S.root"s,
+                                          "f/stem_%w.root"s};
   std::vector<std::string> const answers{"f/stem_1_0_2_3.root"s,
                                          "f/stem_label.root"s,
                                          "f/stem_DEVEL.root"s,
-                                         "f/stem_00002_03.root"s};
+                                         "f/stem_00002_03.root"s,
+                                         "f/stem_0.root"s};
   simulateJob();
   PostCloseFileRenamer fr{fstats};
   for (size_t i{0}, e = patterns.size(); i != e; ++i) {
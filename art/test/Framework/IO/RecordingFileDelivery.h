@@ -0,0 +1,55 @@
+#ifndef art_test_Framework_IO_RecordingFileDelivery_h
+#define art_test_Framework_IO_RecordingFileDelivery_h
+
+// RecordingFileDelivery: a file-delivery service for tests that hands
+// out the configured URIs in order, without checking that they exist,
+// and records every delivery and status update it receives.
+
+#include "art/Framework/Services/FileServiceInterfaces/CatalogInterface.h"
+#include "art/Framework/Services/Registry/ServiceDeclarationMacros.h"
+
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace art::test {
+  class RecordingFileDelivery : public CatalogInterface {
+  public:
+    struct Config {};
+    using Parameters = ServiceTable<Config>;
+    explicit RecordingFileDelivery(Parameters const&);
+
+    // Entries are "delivered <uri>" and "<disposition> <uri>".
+    std::vector<std::string> records() const;
+
+  private:
+    void doConfigure(std::vector<std::string> const& items) override;
+    int doGetNextFileURI(std::string& uri, double& waitTime) override;
+    void doUpdateStatus(std::string const& uri,
+                        FileDisposition status) override;
+    void doOutputFileOpened(std::string const&) override;
+    void doOutputModuleInitiated(std::string const&,
+                                 fhicl::ParameterSet const&) override;
+    void doOutputFileClosed(std::string const&, std::string const&) override;
+    void doEventSelected(std::string const&,
+                         EventID const&,
+                         HLTGlobalStatus const&) override;
+    bool doIsSearchable() override;
+    void doRewind() override;
+
+    mutable std::mutex mutex_{};
+    std::vector<std::string> uris_{};
+    std::size_t next_{};
+    std::vector<std::string> records_{};
+  };
+}
+
+DECLARE_ART_SERVICE_INTERFACE_IMPL(art::test::RecordingFileDelivery,
+                                   art::CatalogInterface,
+                                   SHARED)
+
+#endif /* art_test_Framework_IO_RecordingFileDelivery_h */
+
+// Local Variables:
+// mode: c++
+// End:
@@ -0,0 +1,78 @@
+#include "art/test/Framework/IO/RecordingFileDelivery.h"
+#include "art/Framework/Services/FileServiceInterfaces/FileDeliveryStatus.h"
+#include "art/Framework/Services/Registry/ServiceDefinitionMacros.h"
+
+using namespace std;
+
+namespace art::test {
+
+  RecordingFileDelivery::RecordingFileDelivery(Parameters const&) {}
+
+  vector<string>
+  RecordingFileDelivery::records() const
+  {
+    lock_guard lock{mutex_};
+    return records_;
+  }
+
+  void
+  RecordingFileDelivery::doConfigure(vector<string> const& items)
+  {
+    lock_guard lock{mutex_};
+    uris_ = items;
+    next_ = 0;
+  }
+
+  int
+  RecordingFileDelivery::doGetNextFileURI(string& uri, double& waitTime)
+  {
+    lock_guard lock{mutex_};
+    waitTime = 0.;
+    if (next_ == uris_.size()) {
+      return FileDeliveryStatus::NO_MORE_FILES;
+    }
+    uri = uris_[next_++];
+    records_.push_back("delivered " + uri);
+    return FileDeliveryStatus::SUCCESS;
+  }
+
+  void
+  RecordingFileDelivery::doUpdateStatus(string const& uri,
+                                        FileDisposition const status)
+  {
+    lock_guard lock{mutex_};
+    records_.push_back(translateFileDisposition(status) + ' ' + uri);
+  }
+
+  void
+  RecordingFileDelivery::doOutputFileOpened(string const&)
+  {}
+
+  void
+  RecordingFileDelivery::doOutputModuleInitiated(string const&,
+                                                 fhicl::ParameterSet const&)
+  {}
+
+  void
+  RecordingFileDelivery::doOutputFileClosed(string const&, string const&)
+  {}
+
+  void
+  RecordingFileDelivery::doEventSelected(string const&,
+                                         EventID const&,
+                                         HLTGlobalStatus const&)
+  {}
+
+  bool
+  RecordingFileDelivery::doIsSearchable()
+  {
+    return false;
+  }
+
+  void
+  RecordingFileDelivery::doRewind()
+  {}
+}
+
+DEFINE_ART_SERVICE_INTERFACE_IMPL(art::test::RecordingFileDelivery,
+                                  art::CatalogInterface)
@@ -0,0 +1,140 @@
+#define BOOST_TEST_MODULE (SharedMemoryRing_t)
+#include "boost/test/unit_test.hpp"
+
+#include "art/Framework/IO/SharedMemory/MessageBuffer.h"
+#include "art/Framework/IO/SharedMemory/SharedMemoryRing.h"
+#include "canvas/Utilities/Exception.h"
+
+extern "C" {
+#include <fcntl.h>    // O_RDWR.
+#include <sys/mman.h> // shm_open(), mmap().
+#include <sys/stat.h> // fstat().
+#include <sys/wait.h> // waitpid().
+#include <unistd.h>   // fork(), getpid().
+}
+
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <vector>
+
+using art::MessageReader;
+using art::MessageWriter;
+using art::SharedMemoryRing;
+using namespace std::chrono_literals;
+using namespace std::string_literals;
+
+namespace {
+  std::string
+  segmentName(std::string const& test)
+  {
+    return "/art_"s + test + '_' + std::to_string(getpid());
+  }
+
+  constexpr int nMessages{1000};
+} // namespace
+
+BOOST_AUTO_TEST_SUITE(SharedMemoryRing_t)
+
+BOOST_AUTO_TEST_CASE(TransferBetweenProcesses)
+{
+  auto const name = segmentName("transfer");
+  pid_t const child = fork();
+  BOOST_REQUIRE(child != -1);
+  if (child == 0) {
+    // Reader.  Report the outcome through the exit status only.
+    int status{1};
+    try {
+      auto ring = SharedMemoryRing::attach(name, 10s);
+      std::vector<char> buffer;
+      int n{};
+      bool ok{true};
+      while (ring->read(buffer)) {
+        MessageReader reader{buffer};
+        auto const values = reader.get<std::vector<int>>();
+        auto const label = reader.get<std::string>();
+        ok = ok && values == std::vector<int>(10, n) &&
+             label == "message" + std::to_string(n) && reader.empty();
+        ++n;
+      }
+      status = (ok && n == nMessages) ? 0 : 1;
+    }
+    catch (...) {
+    }
+    _exit(status);
+  }
+
+  // Writer.  Few slots, so that both sides have to wait.
+  auto ring = SharedMemoryRing::create(name, 4, 1024);
+  std::vector<char> buffer;
+  for (int i = 0; i != nMessages; ++i) {
+    buffer.clear();
+    MessageWriter writer{buffer};
+    writer.put(std::vector<int>(10, i));
+    writer.put("message" + std::to_string(i));
+    ring->write(buffer);
+  }
+  ring->close();
+
+  int status{};
+  BOOST_REQUIRE_EQUAL(waitpid(child, &status, 0), child);
+  BOOST_TEST(WIFEXITED(status));
+  BOOST_TEST(WEXITSTATUS(status) == 0);
+}
+
+BOOST_AUTO_TEST_CASE(MessageTooLarge)
+{
+  auto ring = SharedMemoryRing::create(segmentName("too_large"), 2, 16);
+  std::vector<char> const message(17);
+  BOOST_CHECK_THROW(ring->write(message), art::Exception);
+}
+
+BOOST_AUTO_TEST_CASE(SegmentExists)
+{
+  auto const name = segmentName("exists");
+  auto ring = SharedMemoryRing::create(name, 2, 16);
+  BOOST_CHECK_THROW(SharedMemoryRing::create(name, 2, 16), art::Exception);
+}
+
+BOOST_AUTO_TEST_CASE(CorruptMessageSize)
+{
+  auto const name = segmentName("corrupt");
+  auto writer = SharedMemoryRing::create(name, 2, 64);
+  auto reader = SharedMemoryRing::attach(name, 1s);
+  std::string const payload{"payload-to-corrupt"};
+  writer->write(std::vector<char>(payload.begin(), payload.end()));
+
+  // Overwrite the size stored ahead of the message in its slot.
+  int const fd = shm_open(name.c_str(), O_RDWR, 0600);
+  BOOST_REQUIRE(fd != -1);
+  struct stat st;
+  BOOST_REQUIRE(fstat(fd, &st) == 0);
+  auto const length = static_cast<std::size_t>(st.st_size);
+  void* const address =
+    mmap(nullptr, length, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+  close(fd);
+  BOOST_REQUIRE(address != MAP_FAILED);
+  auto const begin = static_cast<char*>(address);
+  auto const found =
+    std::search(begin, begin + length, payload.begin(), payload.end());
+  BOOST_REQUIRE(found - begin >= static_cast<long>(sizeof(std::uint64_t)));
+  std::uint64_t const huge{1ull << 40};
+  std::memcpy(found - sizeof(huge), &huge, sizeof(huge));
+  munmap(address, length);
+
+  std::vector<char> message;
+  BOOST_CHECK_THROW(reader->read(message), art::Exception);
+}
+
+BOOST_AUTO_TEST_CASE(TruncatedMessage)
+{
+  std::vector<char> buffer;
+  MessageWriter writer{buffer};
+  writer.put("a string"s);
+  buffer.resize(buffer.size() - 1);
+  MessageReader reader{buffer};
+  BOOST_CHECK_THROW(reader.get<std::string>(), art::Exception);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,36 @@
+#define BOOST_TEST_MODULE (EmptyEvent_fork_check_t)
+#include "boost/test/unit_test.hpp"
+
+#include <fstream>
+#include <set>
+#include <string>
+#include <tuple>
+
+// Checks the events recorded by each worker of EmptyEvent_fork_t
+// (see empty_event_fork_t.fcl): together, the workers must have
+// processed each of the 100 events exactly once.
+
+namespace {
+  constexpr unsigned nWorkers{3};
+  constexpr unsigned nEvents{100};
+  std::string const prefix{"../EmptyEvent_fork_t.d/fork_events_"};
+}
+
+BOOST_AUTO_TEST_CASE(events_shared_among_workers)
+{
+  std::set<std::tuple<unsigned, unsigned, unsigned>> all;
+  unsigned total{};
+  for (unsigned i = 0; i != nWorkers; ++i) {
+    std::ifstream in{prefix + std::to_string(i) + ".txt"};
+    BOOST_TEST_REQUIRE(in.is_open(), "no events recorded by worker " << i);
+    unsigned r{}, sr{}, e{};
+    while (in >> r >> sr >> e) {
+      ++total;
+      BOOST_TEST(all.emplace(r, sr, e).second,
+                 "event " << r << ':' << sr << ':' << e
+                          << " processed by more than one worker");
+    }
+  }
+  BOOST_TEST(total == nEvents);
+  BOOST_TEST(all.size() == nEvents);
+}
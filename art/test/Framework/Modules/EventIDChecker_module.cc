@@ -0,0 +1,63 @@
+#include "boost/test/unit_test.hpp"
+
+#include "art/Framework/Core/SharedAnalyzer.h"
+#include "art/Framework/Principal/Event.h"
+#include "fhiclcpp/types/Atom.h"
+
+#include <algorithm>
+#include <mutex>
+#include <vector>
+
+// Checks that each event is seen exactly once, and that the event
+// numbers of each subrun are contiguous.
+
+namespace {
+  class EventIDChecker : public art::SharedAnalyzer {
+  public:
+    struct Config {
+      fhicl::Atom<unsigned> expected{
+        fhicl::Name{"expected"},
+        fhicl::Comment{"Number of events expected to be processed."}};
+    };
+    using Parameters = Table<Config>;
+    explicit EventIDChecker(Parameters const& p, art::ProcessingFrame const&)
+      : SharedAnalyzer{p}, expected_{p().expected()}
+    {
+      async<art::InEvent>();
+    }
+
+  private:
+    void
+    analyze(art::Event const& e, art::ProcessingFrame const&) override
+    {
+      std::lock_guard lock{m_};
+      ids_.push_back(e.id());
+    }
+
+    void
+    endJob(art::ProcessingFrame const&) override
+    {
+      BOOST_TEST(ids_.size() == expected_);
+      std::sort(begin(ids_), end(ids_));
+      if (auto const duplicate = std::adjacent_find(cbegin(ids_), cend(ids_));
+          duplicate != cend(ids_)) {
+        BOOST_ERROR("event " << *duplicate << " was processed more than once");
+      }
+      for (std::size_t i = 1; i < ids_.size(); ++i) {
+        auto const& previous = ids_[i - 1];
+        auto const& id = ids_[i];
+        if (id.subRunID() != previous.subRunID()) {
+          continue;
+        }
+        BOOST_TEST(id.event() == previous.event() + 1,
+                   "event " << id << " does not follow " << previous);
+      }
+    }
+
+    unsigned const expected_;
+    std::mutex m_{};
+    std::vector<art::EventID> ids_{};
+  };
+}
+
+DEFINE_ART_MODULE(EventIDChecker)
@@ -0,0 +1,58 @@
+#include "boost/test/unit_test.hpp"
+
+#include "art/Framework/Core/SharedAnalyzer.h"
+#include "art/Framework/Principal/Event.h"
+#include "art/Utilities/Globals.h"
+#include "fhiclcpp/types/Atom.h"
+
+#include <algorithm>
+#include <fstream>
+#include <mutex>
+#include <string>
+#include <vector>
+
+// Writes the IDs of the events processed by this process to
+// <prefix><process index>.txt, one per line, so that the events
+// processed by the workers of a job run with --fork can be compared.
+
+namespace {
+  class ForkEventRecorder : public art::SharedAnalyzer {
+  public:
+    struct Config {
+      fhicl::Atom<std::string> prefix{fhicl::Name{"prefix"}};
+    };
+    using Parameters = Table<Config>;
+    explicit ForkEventRecorder(Parameters const& p,
+                               art::ProcessingFrame const&)
+      : SharedAnalyzer{p}, prefix_{p().prefix()}
+    {
+      async<art::InEvent>();
+    }
+
+  private:
+    void
+    analyze(art::Event const& e, art::ProcessingFrame const&) override
+    {
+      std::lock_guard lock{m_};
+      ids_.push_back(e.id());
+    }
+
+    void
+    endJob(art::ProcessingFrame const&) override
+    {
+      std::sort(begin(ids_), end(ids_));
+      auto const index = art::Globals::instance()->processIndex();
+      std::ofstream out{prefix_ + std::to_string(index) + ".txt"};
+      for (auto const& id : ids_) {
+        out << id.run() << ' ' << id.subRun() << ' ' << id.event() << '\n';
+      }
+      BOOST_TEST_REQUIRE(out.good());
+    }
+
+    std::string const prefix_;
+    std::mutex m_{};
+    std::vector<art::EventID> ids_{};
+  };
+}
+
+DEFINE_ART_MODULE(ForkEventRecorder)
@@ -0,0 +1,61 @@
+#define BOOST_TEST_MODULE (ProductSizeProfiler_check_t)
+#include "boost/test/unit_test.hpp"
+
+#include "cetlib/sqlite/ConnectionFactory.h"
+#include "cetlib/sqlite/query_result.h"
+#include "cetlib/sqlite/select.h"
+
+#include <string>
+
+// Checks the report written by ProductSizeProfiler_t (see
+// product_size_profiler_t.fcl).  The sampled events are 1, 11, 21, 31
+// and 41; the 'sized' products of those events have as many elements
+// as the event number, and the 'sometimes' products are present only
+// in events 1, 21 and 41.
+
+namespace {
+  struct Report {
+    Report()
+    {
+      cet::sqlite::ConnectionFactory factory;
+      db = factory.make_connection("../ProductSizeProfiler_t.d/"
+                                   "product_size_profiler_t.db");
+    }
+
+    double
+    value(std::string const& column, std::string const& instance) const
+    {
+      using namespace cet::sqlite;
+      query_result<double> result;
+      result << select(column)
+                  .from(*db, "ProductSizes")
+                  .where("ModuleLabel='sized' AND InstanceName='" + instance +
+                         "'");
+      return unique_value(result);
+    }
+
+    std::unique_ptr<cet::sqlite::Connection> db;
+  };
+}
+
+BOOST_FIXTURE_TEST_SUITE(ProductSizeProfiler_check_t, Report)
+
+BOOST_AUTO_TEST_CASE(always_present)
+{
+  BOOST_TEST(value("SampledEvents", "") == 5.);
+  BOOST_TEST(value("PresenceRate", "") == 1.);
+  BOOST_TEST(value("MeanSize", "") == 21.);
+  BOOST_TEST(value("P99Size", "") == 41.);
+  BOOST_TEST(value("MaxSize", "") == 41.);
+}
+
+BOOST_AUTO_TEST_CASE(sometimes_present)
+{
+  BOOST_TEST(value("PresenceRate", "sometimes") == 0.6,
+             boost::test_tools::tolerance(1e-12));
+  BOOST_TEST(value("MeanSize", "sometimes") == 21.);
+  BOOST_TEST(value("P99Size", "sometimes") == 41.);
+  BOOST_TEST(value("MaxSize", "sometimes") == 41.);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,37 @@
+#include "art/Framework/Core/SharedProducer.h"
+#include "art/Framework/Principal/Event.h"
+
+#include <memory>
+#include <vector>
+
+// Produces a vector with as many elements as the event number, and,
+// in every 20th event only, a second one with instance name
+// 'sometimes'.
+
+namespace {
+  class SizedProducer : public art::SharedProducer {
+  public:
+    struct Config {};
+    using Parameters = Table<Config>;
+    explicit SizedProducer(Parameters const& p, art::ProcessingFrame const&)
+      : SharedProducer{p}
+    {
+      produces<std::vector<int>>();
+      produces<std::vector<int>>("sometimes");
+      async<art::InEvent>();
+    }
+
+  private:
+    void
+    produce(art::Event& e, art::ProcessingFrame const&) override
+    {
+      auto const n = e.event();
+      e.put(std::make_unique<std::vector<int>>(n));
+      if (n % 20 == 1) {
+        e.put(std::make_unique<std::vector<int>>(n), "sometimes");
+      }
+    }
+  };
+}
+
+DEFINE_ART_MODULE(SizedProducer)
@@ -0,0 +1,128 @@
+#define BOOST_TEST_MODULE (DelayedReader_t)
+#include "boost/test/unit_test.hpp"
+
+#include "art/Framework/Principal/DelayedReader.h"
+#include "canvas/Persistency/Provenance/Parentage.h"
+#include "canvas/Persistency/Provenance/ProductID.h"
+#include "canvas/Persistency/Provenance/ProductProvenance.h"
+#include "canvas/Persistency/Provenance/ProductStatus.h"
+#include "canvas/Utilities/Exception.h"
+
+#include <atomic>
+#include <memory>
+#include <thread>
+#include <vector>
+
+using namespace art;
+
+namespace {
+  ProductID const first{"first"};
+  ProductID const second{"second"};
+  ProductID const absent{"absent"};
+
+  // Counts the number of times the provenance is read.
+  class CountingReader : public DelayedReader {
+  public:
+    mutable std::atomic<unsigned> reads{};
+
+  private:
+    std::unique_ptr<EDProduct>
+    getProduct_(Group const*, ProductID const, RangeSet&) const override
+    {
+      throw Exception{errors::LogicError} << "Unexpected product read.\n";
+    }
+
+    std::vector<ProductProvenance>
+    readProvenance_() const override
+    {
+      ++reads;
+      return {ProductProvenance{second, productstatus::neverCreated()},
+              ProductProvenance{first, productstatus::present()}};
+    }
+  };
+
+  // Provenance as written by old file formats, whose status is unknown.
+  class OldFormatReader : public DelayedReader {
+    std::unique_ptr<EDProduct>
+    getProduct_(Group const*, ProductID const, RangeSet&) const override
+    {
+      throw Exception{errors::LogicError} << "Unexpected product read.\n";
+    }
+
+    std::vector<ProductProvenance>
+    readProvenance_() const override
+    {
+      std::vector<ProductID> const parents{first};
+      return {ProductProvenance{second, productstatus::unknown(), parents},
+              ProductProvenance{first, productstatus::present()}};
+    }
+  };
+}
+
+BOOST_AUTO_TEST_SUITE(DelayedReader_t)
+
+BOOST_AUTO_TEST_CASE(lazy_lookup)
+{
+  CountingReader const reader;
+  BOOST_TEST(!reader.provenanceDeferrable());
+  BOOST_TEST(reader.reads == 0u);
+
+  auto const pp = reader.productProvenance(first);
+  BOOST_TEST_REQUIRE(pp != nullptr);
+  BOOST_TEST(pp->productID() == first);
+  BOOST_TEST(pp->productStatus() == productstatus::present());
+  BOOST_TEST(reader.reads == 1u);
+
+  auto const other = reader.productProvenance(second);
+  BOOST_TEST_REQUIRE(other != nullptr);
+  BOOST_TEST(other->productStatus() == productstatus::neverCreated());
+  BOOST_TEST(reader.productProvenance(absent) == nullptr);
+  BOOST_TEST(reader.reads == 1u);
+}
+
+BOOST_AUTO_TEST_CASE(prefetch)
+{
+  CountingReader const reader;
+  reader.prefetchProvenance();
+  BOOST_TEST(reader.reads == 1u);
+  BOOST_TEST(reader.productProvenance(second) != nullptr);
+  BOOST_TEST(reader.reads == 1u);
+}
+
+BOOST_AUTO_TEST_CASE(concurrent_lookup)
+{
+  CountingReader const reader;
+  std::atomic<unsigned> found{};
+  std::vector<std::thread> threads;
+  for (unsigned i = 0; i != 8; ++i) {
+    threads.emplace_back([&reader, &found, i] {
+      if (reader.productProvenance(i % 2 == 0 ? first : second)) {
+        ++found;
+      }
+    });
+  }
+  for (auto& t : threads) {
+    t.join();
+  }
+  BOOST_TEST(found == 8u);
+  BOOST_TEST(reader.reads == 1u);
+}
+
+BOOST_AUTO_TEST_CASE(old_format)
+{
+  OldFormatReader const reader;
+  auto const status = reader.productStatus(second);
+  BOOST_TEST_REQUIRE(status.has_value());
+  BOOST_TEST(*status == productstatus::dummyToPreventDoubleCount());
+  BOOST_TEST((reader.productStatus(first) == productstatus::present()));
+  BOOST_TEST(!reader.productStatus(absent).has_value());
+
+  auto const pp = reader.productProvenance(second);
+  BOOST_TEST_REQUIRE(pp != nullptr);
+  BOOST_TEST(pp->productStatus() == productstatus::dummyToPreventDoubleCount());
+  std::vector<ProductID> const expected{first};
+  BOOST_TEST(pp->parentage().parents() == expected,
+             boost::test_tools::per_element{});
+}
+
+BOOST_AUTO_TEST_SUITE_END()
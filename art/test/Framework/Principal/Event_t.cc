@@ -18,6 +18,8 @@
 
 #include "boost/test/unit_test.hpp"
 
+#include "art/Framework/Core/ConsumesCollector.h"
+#include "art/Framework/Principal/ConsumesInfo.h"
 #include "art/Framework/Principal/Event.h"
 #include "art/Framework/Principal/EventPrincipal.h"
 #include "art/Framework/Principal/Handle.h"
@@ -157,6 +159,8 @@ ProductTablesFixture::ProductTablesFixture()
     "int2_tag", "modMulti", "EARLY", "int2");
   registerProduct<product_t, presentFromSource>(
     "int3_tag", "modMulti", "EARLY");
+  registerProduct<arttest::DoubleProduct, presentFromSource>(
+    "double_tag", "modDouble", "EARLY");
 
   // Register products for "LATE" process
   registerProduct<product_t, presentFromSource>(
@@ -477,10 +481,10 @@ BOOST_AUTO_TEST_CASE(transaction)
   // Put a product into an Event, and make sure that if we don't
   // commitProducts, there is no product in the EventPrincipal
   // afterwards.
-  BOOST_TEST(principal_->size() == 6u);
+  BOOST_TEST(principal_->size() == 7u);
   auto pH = currentEvent_.put(product_with_value(3), "int1");
   BOOST_TEST(!currentEvent_.getProductProvenance(pH.id()));
-  BOOST_TEST(principal_->size() == 6u);
+  BOOST_TEST(principal_->size() == 7u);
 }
 
 BOOST_AUTO_TEST_CASE(getProductTokens)
@@ -503,6 +507,106 @@ BOOST_AUTO_TEST_CASE(getProductTokens)
   }
 }
 
+BOOST_AUTO_TEST_CASE(getHandles)
+{
+  addSourceProduct(product_with_value(1), "int1_tag", "int1");
+  addSourceProduct(product_with_value(2), "int2_tag", "int2");
+  addSourceProduct(product_with_value(3), "int3_tag");
+
+  auto const tokens = currentEvent_.getProductTokens<product_t>();
+  BOOST_TEST_REQUIRE(size(tokens) == 3ull);
+
+  // Verify that the same products are retrieved in bulk as one by one.
+  auto const handles = currentEvent_.getHandles(tokens);
+  BOOST_TEST_REQUIRE(size(handles) == size(tokens));
+  for (std::size_t i{}; i < tokens.size(); ++i) {
+    auto const h = currentEvent_.getHandle(tokens[i]);
+    BOOST_TEST_REQUIRE(handles[i].isValid());
+    BOOST_TEST(handles[i]->value == h->value);
+  }
+
+  auto const [h0, h2] = currentEvent_.getValidHandles(tokens[0], tokens[2]);
+  BOOST_TEST(h0->value == handles[0]->value);
+  BOOST_TEST(h2->value == handles[2]->value);
+}
+
+BOOST_AUTO_TEST_CASE(getHandlesOfDifferentTypes)
+{
+  addSourceProduct(product_with_value(1), "int1_tag", "int1");
+  addSourceProduct(std::make_unique<arttest::DoubleProduct>(3.5),
+                   "double_tag");
+
+  auto const intTokens = currentEvent_.getProductTokens<product_t>();
+  auto const doubleTokens =
+    currentEvent_.getProductTokens<arttest::DoubleProduct>();
+  BOOST_TEST_REQUIRE(size(intTokens) == 1ull);
+  BOOST_TEST_REQUIRE(size(doubleTokens) == 1ull);
+
+  auto const [hi, hd] =
+    currentEvent_.getValidHandles(intTokens[0], doubleTokens[0]);
+  BOOST_TEST(hi->value == 1);
+  BOOST_TEST(hd->value == 3.5);
+}
+
+BOOST_AUTO_TEST_CASE(getHandlesWithMissingProduct)
+{
+  addSourceProduct(product_with_value(1), "int1_tag", "int1");
+  addSourceProduct(product_with_value(3), "int3_tag");
+
+  auto const tokens = currentEvent_.getProductTokens<product_t>();
+  BOOST_TEST_REQUIRE(size(tokens) == 2ull);
+
+  // The double product is registered but was never put into the
+  // event, and nothing at all was registered for "nonesuch".
+  ConsumesCollector collector;
+  auto const notPut =
+    collector.consumes<arttest::DoubleProduct>(InputTag{"modDouble"});
+  auto const nonesuch = collector.consumes<product_t>(InputTag{"nonesuch"});
+
+  auto const handles =
+    currentEvent_.getHandles(std::vector{tokens[0], nonesuch, tokens[1]});
+  BOOST_TEST_REQUIRE(size(handles) == 3ull);
+  BOOST_TEST(handles[0].isValid());
+  BOOST_TEST(handles[1].failedToGet());
+  BOOST_CHECK_THROW(*handles[1], cet::exception);
+  BOOST_TEST(handles[2].isValid());
+
+  auto const [h0, hd] = currentEvent_.getHandles(tokens[0], notPut);
+  BOOST_TEST(h0->value == 1);
+  BOOST_TEST(hd.failedToGet());
+
+  BOOST_CHECK_THROW(currentEvent_.getValidHandles(tokens[0], notPut),
+                    cet::exception);
+  BOOST_CHECK_THROW(currentEvent_.getValidHandles(nonesuch, tokens[1]),
+                    cet::exception);
+}
+
+BOOST_AUTO_TEST_CASE(getHandlesWithoutConsumes)
+{
+  addSourceProduct(product_with_value(1), "int1_tag", "int1");
+  addSourceProduct(product_with_value(2), "int2_tag", "int2");
+
+  auto const tokens = currentEvent_.getProductTokens<product_t>();
+  BOOST_TEST_REQUIRE(size(tokens) == 2ull);
+
+  // No consumes statements have been registered for the current
+  // module, so every bulk retrieval must be rejected when consumes
+  // statements are required.
+  struct RequireConsumes {
+    RequireConsumes() { ConsumesInfo::instance()->setRequireConsumes(true); }
+    ~RequireConsumes() { ConsumesInfo::instance()->setRequireConsumes(false); }
+  } const sentry;
+
+  auto const isRegistrationFailure = [](art::Exception const& e) {
+    return e.categoryCode() == errors::ProductRegistrationFailure;
+  };
+  BOOST_CHECK_EXCEPTION(
+    currentEvent_.getHandles(tokens), art::Exception, isRegistrationFailure);
+  BOOST_CHECK_EXCEPTION(currentEvent_.getValidHandles(tokens[0], tokens[1]),
+                        art::Exception,
+                        isRegistrationFailure);
+}
+
 BOOST_AUTO_TEST_CASE(getByInstanceName)
 {
   using handle_t = Handle<product_t>;
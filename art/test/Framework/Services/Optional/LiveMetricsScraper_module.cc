@@ -0,0 +1,100 @@
+#include "boost/test/unit_test.hpp"
+
+#include "art/Framework/Core/SharedAnalyzer.h"
+#include "art/Framework/Principal/fwd.h"
+#include "fhiclcpp/types/Atom.h"
+#include "fhiclcpp/types/Sequence.h"
+
+#include <sys/socket.h>
+#include <sys/time.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+#include <cstring>
+#include <string>
+#include <vector>
+
+// Scrapes the LiveMetrics socket once, at the end of the job, and
+// checks that the expected metrics are served.
+
+namespace {
+  std::string
+  scrape(std::string const& path)
+  {
+    sockaddr_un address{};
+    address.sun_family = AF_UNIX;
+    strncpy(address.sun_path, path.c_str(), sizeof(address.sun_path) - 1);
+    int const fd = ::socket(AF_UNIX, SOCK_STREAM, 0);
+    BOOST_TEST_REQUIRE(fd != -1);
+    timeval const timeout{5, 0};
+    setsockopt(fd, SOL_SOCKET, SO_RCVTIMEO, &timeout, sizeof timeout);
+    auto const addr = reinterpret_cast<sockaddr const*>(&address);
+    BOOST_TEST_REQUIRE(connect(fd, addr, sizeof address) == 0);
+    std::string result;
+    char buffer[4096];
+    ssize_t n{};
+    while ((n = recv(fd, buffer, sizeof buffer, 0)) > 0) {
+      result.append(buffer, n);
+    }
+    close(fd);
+    BOOST_TEST_REQUIRE(n == 0);
+    return result;
+  }
+
+  class LiveMetricsScraper : public art::SharedAnalyzer {
+  public:
+    struct Config {
+      fhicl::Atom<std::string> socket{fhicl::Name{"socket"}};
+      fhicl::Atom<unsigned> expectedEvents{fhicl::Name{"expectedEvents"}};
+      fhicl::Sequence<std::string> modules{fhicl::Name{"modules"}};
+    };
+    using Parameters = Table<Config>;
+    explicit LiveMetricsScraper(Parameters const& p,
+                                art::ProcessingFrame const&)
+      : SharedAnalyzer{p}
+      , socket_{p().socket()}
+      , expectedEvents_{p().expectedEvents()}
+      , modules_{p().modules()}
+    {
+      async<art::InEvent>();
+    }
+
+  private:
+    void
+    analyze(art::Event const&, art::ProcessingFrame const&) override
+    {}
+
+    void
+    endJob(art::ProcessingFrame const&) override
+    {
+      auto const text = scrape(socket_);
+      for (auto const name : {"art_uptime_seconds",
+                              "art_events_processed_total",
+                              "art_event_rate_hertz",
+                              "art_schedule_idle_fraction",
+                              "art_module_calls_total",
+                              "art_module_seconds_total",
+                              "art_module_mean_seconds",
+                              "art_process_resident_bytes"}) {
+        BOOST_TEST(text.find(std::string{"# TYPE "} + name + ' ') !=
+                     std::string::npos,
+                   "missing metric " << name);
+      }
+      auto const events =
+        "art_events_processed_total " + std::to_string(expectedEvents_) + '\n';
+      BOOST_TEST(text.find(events) != std::string::npos);
+      for (auto const& module : modules_) {
+        auto const calls = "art_module_calls_total{module=\"" + module +
+                           "\"} " + std::to_string(expectedEvents_) + '\n';
+        BOOST_TEST(text.find(calls) != std::string::npos,
+                   "missing or wrong call count for " << module);
+      }
+    }
+
+    std::string const socket_;
+    unsigned const expectedEvents_;
+    std::vector<std::string> const modules_;
+  };
+}
+
+DEFINE_ART_MODULE(LiveMetricsScraper)
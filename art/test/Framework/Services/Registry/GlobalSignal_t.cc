@@ -121,4 +121,13 @@ BOOST_AUTO_TEST_CASE(TestSignal0_t)
   BOOST_TEST(os.is_equal(test_text));
 }
 
+BOOST_AUTO_TEST_CASE(TestSignal_empty_t)
+{
+  TestSignal0 s;
+  BOOST_TEST(s.empty());
+  BOOST_CHECK_NO_THROW(s.invoke());
+  s.watch([] {});
+  BOOST_TEST(!s.empty());
+}
+
 BOOST_AUTO_TEST_SUITE_END()
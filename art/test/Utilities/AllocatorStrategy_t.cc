@@ -0,0 +1,53 @@
+#define BOOST_TEST_MODULE (AllocatorStrategy_t)
+#include "boost/test/unit_test.hpp"
+
+#include "art/Utilities/AllocatorStrategy.h"
+#include "canvas/Utilities/Exception.h"
+
+using art::allocator_description;
+using art::configure_allocator;
+
+namespace {
+  bool
+  configuration_error(art::Exception const& e)
+  {
+    return e.categoryCode() == art::errors::Configuration;
+  }
+}
+
+BOOST_AUTO_TEST_SUITE(AllocatorStrategy_t)
+
+BOOST_AUTO_TEST_CASE(glibc1)
+{
+  BOOST_TEST(allocator_description() == "glibc1");
+  configure_allocator("glibc1", 0);
+  BOOST_TEST(allocator_description() == "glibc1");
+}
+
+BOOST_AUTO_TEST_CASE(glibcN)
+{
+  configure_allocator("glibcN", 4);
+  BOOST_TEST(allocator_description() == "glibcN (arena_max: 4)");
+  configure_allocator("glibcN", 0);
+  BOOST_TEST(allocator_description() == "glibcN (arena_max: system default)");
+}
+
+BOOST_AUTO_TEST_CASE(unknown_strategy)
+{
+  configure_allocator("glibc1", 0);
+  BOOST_CHECK_EXCEPTION(
+    configure_allocator("glibc2", 0), art::Exception, configuration_error);
+  // A rejected strategy does not change the one in effect.
+  BOOST_TEST(allocator_description() == "glibc1");
+}
+
+// This test is not run with TBB's malloc replacement preloaded.
+BOOST_AUTO_TEST_CASE(tbbmalloc_not_preloaded)
+{
+  configure_allocator("glibc1", 0);
+  BOOST_CHECK_EXCEPTION(
+    configure_allocator("tbbmalloc", 0), art::Exception, configuration_error);
+  BOOST_TEST(allocator_description() == "glibc1");
+}
+
+BOOST_AUTO_TEST_SUITE_END()
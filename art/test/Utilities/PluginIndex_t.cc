@@ -0,0 +1,147 @@
+#define BOOST_TEST_MODULE (PluginIndex_t)
+#include "boost/test/unit_test.hpp"
+
+#include "art/Utilities/PluginIndex.h"
+
+#include <chrono>
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+#include <sstream>
+#include <string>
+
+namespace fs = std::filesystem;
+using art::PluginIndex;
+using namespace std::chrono_literals;
+
+namespace {
+  // Libraries that are never loaded: the index is made from their
+  // names alone.
+  struct LibraryFixture {
+    LibraryFixture()
+    {
+      fs::remove_all(libDir);
+      fs::create_directories(libDir);
+      for (auto const& name : {"libpkgA_Foo_module.so",
+                               "libpkgA_Bar_module.so",
+                               "libpkgB_Bar_module.so",
+                               "libpkgA_Baz_tool.so"}) {
+        std::ofstream{libDir / name};
+      }
+      setenv("CET_PLUGIN_PATH", libDir.c_str(), 1);
+      setenv("LD_LIBRARY_PATH", libDir.c_str(), 1);
+    }
+
+    std::string
+    library(std::string const& name) const
+    {
+      return (libDir / name).string();
+    }
+
+    static std::string
+    type_of(std::string const& suffix, std::string const& spec)
+    {
+      return suffix == "module" ? "producer:" + spec : std::string{};
+    }
+
+    std::string
+    written() const
+    {
+      std::ostringstream os;
+      PluginIndex::make({"module", "tool"}, type_of).write(os);
+      return os.str();
+    }
+
+    fs::path const libDir{fs::absolute("PluginIndex_t.d/lib")};
+  };
+
+  PluginIndex
+  read(std::string const& text)
+  {
+    std::istringstream is{text};
+    return PluginIndex{is};
+  }
+
+  void
+  touch(fs::path const& p)
+  {
+    fs::last_write_time(p, fs::last_write_time(p) + 1s);
+  }
+}
+
+BOOST_AUTO_TEST_SUITE(PluginIndex_t)
+
+BOOST_AUTO_TEST_CASE(specs_for)
+{
+  using specs = std::pair<std::string, std::string>;
+  BOOST_TEST((PluginIndex::specs_for("/a/b/libart_test_Foo_module.so",
+                                     "module") ==
+              specs{"Foo", "art/test/Foo"}));
+  BOOST_TEST((PluginIndex::specs_for("libFoo_source.so", "source") ==
+              specs{"Foo", "Foo"}));
+  // The suffix must match, and the name must start with "lib".
+  BOOST_TEST((PluginIndex::specs_for("libart_Foo_module.so", "source") ==
+              specs{}));
+  BOOST_TEST((PluginIndex::specs_for("/lib/art_Foo_module.so", "module") ==
+              specs{}));
+  BOOST_TEST((PluginIndex::specs_for("lib_module.so", "module") == specs{}));
+}
+
+BOOST_FIXTURE_TEST_CASE(round_trip, LibraryFixture)
+{
+  auto const text = written();
+  auto const index = read(text);
+  BOOST_TEST_REQUIRE(!index.empty());
+
+  for (auto const spec : {"Foo", "pkgA/Foo"}) {
+    auto const entry = index.find("module", spec);
+    BOOST_TEST_REQUIRE(entry != nullptr, "missing " << spec);
+    BOOST_TEST(entry->library == library("libpkgA_Foo_module.so"));
+    BOOST_TEST(entry->type == "producer:pkgA/Foo");
+  }
+  auto const tool = index.find("tool", "Baz");
+  BOOST_TEST_REQUIRE(tool != nullptr);
+  BOOST_TEST(tool->library == library("libpkgA_Baz_tool.so"));
+  BOOST_TEST(tool->type.empty());
+
+  // Only the unambiguous specifications are indexed.
+  BOOST_TEST(index.find("module", "Bar") == nullptr);
+  BOOST_TEST(index.find("module", "pkgB/Bar") != nullptr);
+  BOOST_TEST(index.find("tool", "Foo") == nullptr);
+
+  std::ostringstream os;
+  index.write(os);
+  BOOST_TEST(os.str() == text);
+}
+
+BOOST_FIXTURE_TEST_CASE(modified_library, LibraryFixture)
+{
+  auto const text = written();
+  touch(libDir / "libpkgA_Foo_module.so");
+  auto const index = read(text);
+  BOOST_TEST(index.find("module", "Foo") == nullptr);
+  BOOST_TEST(index.find("module", "pkgA/Bar") != nullptr);
+}
+
+BOOST_FIXTURE_TEST_CASE(changed_directory, LibraryFixture)
+{
+  auto const text = written();
+  std::ofstream{libDir / "libpkgC_Foo_module.so"};
+  touch(libDir);
+  BOOST_TEST(read(text).empty());
+}
+
+BOOST_FIXTURE_TEST_CASE(other_path, LibraryFixture)
+{
+  auto const text = written();
+  auto const other = libDir.string() + ":" + libDir.string();
+  setenv("CET_PLUGIN_PATH", other.c_str(), 1);
+  BOOST_TEST(read(text).empty());
+}
+
+BOOST_AUTO_TEST_CASE(other_version)
+{
+  BOOST_TEST(read("art_plugin_index\t1\n").empty());
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,120 @@
+#define BOOST_TEST_MODULE (ResourceQueue_t)
+#include "boost/test/unit_test.hpp"
+
+#include "art/Utilities/ResourceQueue.h"
+
+#include "tbb/task_group.h"
+
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+using art::detail::ResourceArbiter;
+using art::detail::ResourceQueue;
+using art::detail::TaskPriority;
+
+namespace {
+  class Recorder {
+  public:
+    auto
+    task(std::string name)
+    {
+      return [this, name] {
+        std::lock_guard sentry{mutex_};
+        order_.push_back(name);
+      };
+    }
+    std::vector<std::string>
+    order() const
+    {
+      std::lock_guard sentry{mutex_};
+      return order_;
+    }
+
+  private:
+    std::mutex mutable mutex_{};
+    std::vector<std::string> order_{};
+  };
+
+  std::vector<std::string>
+  run_with_batch(unsigned const maxBatch, bool const high)
+  {
+    tbb::task_group group;
+    auto arbiter = std::make_shared<ResourceArbiter>(group, 2, maxBatch);
+    ResourceQueue a{arbiter, {0}};
+    ResourceQueue b{arbiter, {0, 1}};
+    Recorder recorder;
+    // The tasks pushed while 'a' holds resource 0 are ordered once it
+    // releases it.
+    a.push(TaskPriority::normal, [&] {
+      recorder.task("a1")();
+      b.push(TaskPriority::normal, recorder.task("b1"));
+      a.push(TaskPriority::normal, recorder.task("a2"));
+      a.push(TaskPriority::normal, recorder.task("a3"));
+      if (high) {
+        b.push(TaskPriority::high, recorder.task("b2"));
+      }
+    });
+    group.wait();
+    return recorder.order();
+  }
+
+  using names = std::vector<std::string>;
+}
+
+BOOST_AUTO_TEST_SUITE(ResourceQueue_t)
+
+BOOST_AUTO_TEST_CASE(fifo)
+{
+  BOOST_TEST(run_with_batch(1, false) == (names{"a1", "b1", "a2", "a3"}));
+}
+
+BOOST_AUTO_TEST_CASE(priority)
+{
+  BOOST_TEST(run_with_batch(1, true) ==
+             (names{"a1", "b2", "b1", "a2", "a3"}));
+}
+
+BOOST_AUTO_TEST_CASE(batch)
+{
+  BOOST_TEST(run_with_batch(2, false) == (names{"a1", "a2", "b1", "a3"}));
+  BOOST_TEST(run_with_batch(3, false) == (names{"a1", "a2", "a3", "b1"}));
+  // A waiting task of higher priority ends the batch.
+  BOOST_TEST(run_with_batch(3, true) ==
+             (names{"a1", "b2", "b1", "a2", "a3"}));
+}
+
+BOOST_AUTO_TEST_CASE(exclusion)
+{
+  tbb::task_group group;
+  auto arbiter = std::make_shared<ResourceArbiter>(group, 2, 4);
+  std::vector<ResourceQueue> queues{{arbiter, {0}},
+                                    {arbiter, {1}},
+                                    {arbiter, {0, 1}}};
+  std::atomic<int> users[2]{};
+  std::atomic<bool> overlapped{false};
+  std::atomic<unsigned> done{};
+  for (unsigned i = 0; i != 3000; ++i) {
+    auto& queue = queues[i % 3];
+    auto const priority = i % 7 == 0 ? TaskPriority::high :
+                                       TaskPriority::normal;
+    queue.push(priority, [&queue, &users, &overlapped, &done] {
+      for (auto const r : queue.resources()) {
+        if (++users[r] != 1) {
+          overlapped = true;
+        }
+      }
+      for (auto const r : queue.resources()) {
+        --users[r];
+      }
+      ++done;
+    });
+  }
+  group.wait();
+  BOOST_TEST(!overlapped);
+  BOOST_TEST(done == 3000u);
+}
+
+BOOST_AUTO_TEST_SUITE_END()